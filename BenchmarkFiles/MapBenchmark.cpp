@@ -0,0 +1,359 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "MapFiles/Map.h"
+#include "MapFiles/MapDriver.h"
+
+/*
+ * Micro-benchmark of the map handling on the startup path: MapLoader::LoadMap, Map::Validate, the Map copy
+ * constructor and operator<<(Map&), over the bundled maps and generated grid maps of increasing size.
+ *
+ * Usage: MapBenchmark [--out <file.json>] [--sizes 1000,10000,...] [--repeat <n>]
+ * Like the drivers, it is meant to be run from the build directory, next to SomeMapsFromOnline.
+ */
+
+namespace {
+    std::atomic<unsigned long long> allocationCount(0);
+    std::atomic<unsigned long long> allocatedBytes(0);
+}
+
+/*
+ * Every replaced operator allocates through operator new(std::size_t) and releases through operator delete(void*),
+ * over malloc and free. Both are kept out of line: once inlined into a caller, GCC sees a new-expression released
+ * with free and reports it as mismatched (-Wmismatched-new-delete).
+ */
+#ifdef _MSC_VER
+#define BENCHMARK_NOINLINE __declspec(noinline)
+#else
+#define BENCHMARK_NOINLINE __attribute__((noinline))
+#endif
+
+BENCHMARK_NOINLINE void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+BENCHMARK_NOINLINE void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    operator delete(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    operator delete(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    operator delete(memory);
+}
+
+namespace {
+    /**
+     * Result of benchmarking one operation on one map.
+     */
+    struct BenchmarkResult {
+        std::string map;
+        int territories;
+        std::string operation;
+        int repeat;
+        double minMicros;
+        double meanMicros;
+        unsigned long long allocations; ///< Allocations made by a single run.
+        unsigned long long bytes; ///< Bytes requested by a single run.
+        long peakRssKb; ///< Peak resident set size of the process once the operation has run.
+    };
+
+    /**
+     * Stream buffer that discards everything written to it, used to time operator<< without disk I/O
+     * and to silence Validate while it is timed.
+     */
+    class NullBuffer : public std::streambuf {
+    protected:
+        int overflow(int c) override { return c; }
+        std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+    };
+
+    /**
+     * @return The peak resident set size of the process, in kilobytes.
+     */
+    long PeakRssKb() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return static_cast<long>(counters.PeakWorkingSetSize / 1024);
+        }
+        return -1;
+#else
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+        return usage.ru_maxrss / 1024; // Reported in bytes on macOS
+#else
+        return usage.ru_maxrss;
+#endif
+#endif
+    }
+
+    /**
+     * Writes a grid map of the given number of territories. Every territory is adjacent to its four neighbours
+     * and continents are 10 by 10 blocks of the grid, so the generated map is valid.
+     *
+     * @param fileName The file to write.
+     * @param territories The number of territories to generate.
+     */
+    void GenerateGridMap(const std::string& fileName, int territories) {
+        int width = 1;
+        while (width * width < territories) {
+            width++;
+        }
+        const int height = (territories + width - 1) / width;
+        const int blocksPerRow = (width + 9) / 10;
+
+        auto index = [width](int row, int column) { return row * width + column; };
+        auto continentOf = [blocksPerRow](int row, int column) { return (row / 10) * blocksPerRow + column / 10; };
+
+        std::ofstream out(fileName);
+        out << "[Map]\nauthor=MapBenchmark\nimage=grid" << territories << ".bmp\n\n[Continents]\n";
+
+        std::vector<bool> usedContinents(static_cast<size_t>(continentOf(height - 1, 0) + blocksPerRow), false);
+        for (int id = 0; id < territories; ++id) {
+            usedContinents[continentOf(id / width, id % width)] = true;
+        }
+        for (size_t continent = 0; continent < usedContinents.size(); ++continent) {
+            if (usedContinents[continent]) {
+                out << "C" << continent << "=" << (continent % 7 + 1) << "\n";
+            }
+        }
+
+        out << "\n[Territories]\n";
+        for (int id = 0; id < territories; ++id) {
+            int row = id / width;
+            int column = id % width;
+            out << "T" << id << "," << column * 10 << "," << row * 10 << ",C" << continentOf(row, column);
+
+            const int neighbours[4][2] = {{row - 1, column}, {row + 1, column}, {row, column - 1}, {row, column + 1}};
+            for (const auto& neighbour : neighbours) {
+                if (neighbour[0] >= 0 && neighbour[1] >= 0 && neighbour[1] < width
+                    && index(neighbour[0], neighbour[1]) < territories) {
+                    out << ",T" << index(neighbour[0], neighbour[1]);
+                }
+            }
+            out << "\n";
+        }
+    }
+
+    /**
+     * Runs an operation the given number of times and records its timings, the allocations of its first run
+     * and the peak resident set size once it has run.
+     *
+     * @param mapName The name of the map, as reported.
+     * @param territories The number of territories of the map.
+     * @param operation The name of the operation, as reported.
+     * @param repeat The number of timed runs.
+     * @param prepare Called before every run, outside of the timing (for example to release the previous result).
+     * @param run The operation to time.
+     * @return The result of the benchmark.
+     */
+    BenchmarkResult Measure(const std::string& mapName, int territories, const std::string& operation, int repeat,
+                            const std::function<void()>& prepare, const std::function<void()>& run) {
+        BenchmarkResult result{mapName, territories, operation, repeat, 0.0, 0.0, 0, 0, 0};
+        double total = 0.0;
+
+        for (int i = 0; i < repeat; ++i) {
+            prepare();
+
+            unsigned long long countBefore = allocationCount.load();
+            unsigned long long bytesBefore = allocatedBytes.load();
+            auto start = std::chrono::steady_clock::now();
+
+            run();
+
+            auto end = std::chrono::steady_clock::now();
+            if (i == 0) {
+                result.allocations = allocationCount.load() - countBefore;
+                result.bytes = allocatedBytes.load() - bytesBefore;
+            }
+
+            double micros = std::chrono::duration<double, std::micro>(end - start).count();
+            result.minMicros = i == 0 ? micros : std::min(result.minMicros, micros);
+            total += micros;
+        }
+
+        result.meanMicros = total / repeat;
+        result.peakRssKb = PeakRssKb();
+        return result;
+    }
+
+    /**
+     * Benchmarks the four map operations on one map file.
+     *
+     * @param fileName The map file.
+     * @param mapName The name of the map, as reported.
+     * @param repeat The number of timed runs of each operation.
+     * @param results The results to append to.
+     */
+    void BenchmarkMap(const std::string& fileName, const std::string& mapName, int repeat,
+                      std::vector<BenchmarkResult>& results) {
+        NullBuffer nullBuffer;
+        std::ostream nullStream(&nullBuffer);
+        std::unique_ptr<Map> loaded;
+
+        results.push_back(Measure(mapName, 0, "LoadMap", repeat,
+                                  [&loaded]() { loaded.reset(new Map()); },
+                                  [&loaded, &fileName]() { MapLoader::LoadMap(fileName, loaded.get()); }));
+
+        const int territories = static_cast<int>(loaded->territoriesById.size());
+        results.back().territories = territories;
+        if (territories == 0) {
+            std::cerr << "Skipping " << mapName << ": it could not be loaded.\n";
+            results.pop_back();
+            return;
+        }
+
+        // Validate reports on the standard streams, which would dominate the timing of small maps
+        std::streambuf* coutBuffer = std::cout.rdbuf(&nullBuffer);
+        std::streambuf* cerrBuffer = std::cerr.rdbuf(&nullBuffer);
+        results.push_back(Measure(mapName, territories, "Validate", repeat, []() {},
+                                  [&loaded]() { loaded->Validate(); }));
+        std::cout.rdbuf(coutBuffer);
+        std::cerr.rdbuf(cerrBuffer);
+
+        std::unique_ptr<Map> copy;
+        results.push_back(Measure(mapName, territories, "CopyConstructor", repeat,
+                                  [&copy]() { copy.reset(); },
+                                  [&copy, &loaded]() { copy.reset(new Map(*loaded)); }));
+        copy.reset();
+
+        results.push_back(Measure(mapName, territories, "StreamInsertion", repeat, []() {},
+                                  [&nullStream, &loaded]() { nullStream << *loaded; }));
+    }
+
+    /**
+     * @param text The text to escape.
+     * @return The text, escaped to be written as a JSON string.
+     */
+    std::string JsonEscape(const std::string& text) {
+        std::string escaped;
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                escaped += '\\';
+            }
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    /**
+     * Writes the results as JSON, one object per map and operation.
+     *
+     * @param out The stream to write to.
+     * @param results The results to write.
+     */
+    void WriteJson(std::ostream& out, const std::vector<BenchmarkResult>& results) {
+        out << "{\n  \"benchmark\": \"MapBenchmark\",\n";
+#ifdef __VERSION__
+        out << "  \"compiler\": \"" << JsonEscape(__VERSION__) << "\",\n";
+#endif
+#ifdef NDEBUG
+        out << "  \"assertions\": false,\n";
+#else
+        out << "  \"assertions\": true,\n";
+#endif
+        out << "  \"results\": [\n" << std::fixed << std::setprecision(3);
+
+        for (size_t i = 0; i < results.size(); ++i) {
+            const BenchmarkResult& result = results[i];
+            out << "    {\"map\": \"" << JsonEscape(result.map) << "\", \"territories\": " << result.territories
+                << ", \"operation\": \"" << result.operation << "\", \"repeat\": " << result.repeat
+                << ", \"minMicros\": " << result.minMicros << ", \"meanMicros\": " << result.meanMicros
+                << ", \"allocations\": " << result.allocations << ", \"allocatedBytes\": " << result.bytes
+                << ", \"peakRssKb\": " << result.peakRssKb << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+
+        out << "  ]\n}\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string outputFileName = "map_benchmark.json";
+    std::vector<int> sizes = {1000, 10000, 100000, 1000000};
+    int repeat = 3;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if (arg == "--out" && i + 1 < argc) {
+            outputFileName = argv[++i];
+        } else if (arg == "--repeat" && i + 1 < argc) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--sizes" && i + 1 < argc) {
+            sizes.clear();
+            std::istringstream list(argv[++i]);
+            std::string size;
+            while (std::getline(list, size, ',')) {
+                if (std::atoi(size.c_str()) > 0) {
+                    sizes.push_back(std::atoi(size.c_str()));
+                }
+            }
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--out <file.json>] [--sizes 1000,10000,...] [--repeat <n>]\n";
+            return 1;
+        }
+    }
+
+    std::vector<BenchmarkResult> results;
+
+    for (const auto& mapFile : MAP_FILES) {
+        std::cout << "Benchmarking " << mapFile << "\n";
+        BenchmarkMap(mapFile, mapFile.substr(mapFile.find_last_of('/') + 1), repeat, results);
+    }
+
+    for (int size : sizes) {
+        std::string fileName = "map_benchmark_" + std::to_string(size) + ".map";
+        std::cout << "Benchmarking a generated map of " << size << " territories\n";
+
+        GenerateGridMap(fileName, size);
+        BenchmarkMap(fileName, "grid" + std::to_string(size), repeat, results);
+        std::remove(fileName.c_str());
+    }
+
+    std::ofstream out(outputFileName);
+    if (!out.is_open()) {
+        std::cerr << "Error: Could not open output file: " << outputFileName << "\n";
+        return 1;
+    }
+
+    WriteJson(out, results);
+    std::cout << "Results written to " << outputFileName << "\n";
+    return 0;
+}
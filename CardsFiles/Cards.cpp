@@ -1,12 +1,136 @@
 #include <iostream>
 #include <cstdlib>
 #include <ctime>
+#include <cctype>
 #include "Cards.h"
 
+/**
+ * @param type A card type.
+ * @return The name of the card type.
+ */
+const std::string &cardTypeName(CardType type)
+{
+    return cardTypes[static_cast<int>(type)];
+}
+
+/**
+ * Finds the card type with the given name, in any case. "Negotiate" is a name of the Diplomacy type.
+ *
+ * @param name The name of a card type.
+ * @param type Receives the card type.
+ * @return true if the name is the name of a card type.
+ */
+bool parseCardType(const std::string &name, CardType &type)
+{
+    std::string lowerName = name;
+    for (char &c : lowerName)
+    {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
+    if (lowerName == "negotiate")
+    {
+        type = CardType::DIPLOMACY;
+        return true;
+    }
+
+    for (int i = 0; i < CARD_TYPE_COUNT; ++i)
+    {
+        std::string lowerType = cardTypes[i];
+        for (char &c : lowerType)
+        {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+
+        if (lowerName == lowerType)
+        {
+            type = static_cast<CardType>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+// <<<< Card Order Factories >>>>
+
+/**
+ * @param arguments The player issuing the order and the target territory.
+ * @return A new BombOrder.
+ */
+Order *CardOrderFactory<CardType::BOMB>::create(const CardOrderArguments &arguments)
+{
+    return new BombOrder(arguments.player, arguments.target);
+}
+
+/**
+ * @param arguments The player issuing the order, the target territory and the neutral player.
+ * @return A new BlockadeOrder.
+ */
+Order *CardOrderFactory<CardType::BLOCKADE>::create(const CardOrderArguments &arguments)
+{
+    BlockadeOrder *order = new BlockadeOrder(arguments.target);
+    order->setPlayer(arguments.player);
+    order->neutralPlayer = arguments.neutralPlayer;
+    return order;
+}
+
+/**
+ * @param arguments The player issuing the order, the source and target territories and the armies.
+ * @return A new AirliftOrder.
+ */
+Order *CardOrderFactory<CardType::AIRLIFT>::create(const CardOrderArguments &arguments)
+{
+    AirliftOrder *order = new AirliftOrder(arguments.source, arguments.target, arguments.armies);
+    order->setPlayer(arguments.player);
+    return order;
+}
+
+/**
+ * @param arguments The player issuing the order and the name of the player to negotiate with.
+ * @return A new NegotiateOrder.
+ */
+Order *CardOrderFactory<CardType::DIPLOMACY>::create(const CardOrderArguments &arguments)
+{
+    return new NegotiateOrder(arguments.player, arguments.target);
+}
+
+namespace
+{
+    typedef Order *(*CardOrderCreator)(const CardOrderArguments &);
+
+    /**
+     * The factory of every card type, indexed by CardType.
+     */
+    constexpr CardOrderCreator cardOrderCreators[] = {
+        &CardOrderFactory<CardType::BOMB>::create,
+        &CardOrderFactory<CardType::BLOCKADE>::create,
+        &CardOrderFactory<CardType::AIRLIFT>::create,
+        &CardOrderFactory<CardType::DIPLOMACY>::create,
+    };
+
+    static_assert(sizeof(cardOrderCreators) / sizeof(cardOrderCreators[0]) == CARD_TYPE_COUNT,
+                  "Every card type needs an order factory");
+    static_assert(static_cast<int>(CardType::BOMB) == 0 && static_cast<int>(CardType::BLOCKADE) == 1 &&
+                      static_cast<int>(CardType::AIRLIFT) == 2 && static_cast<int>(CardType::DIPLOMACY) == 3,
+                  "The order factories are indexed by CardType");
+}
+
+/**
+ * Creates the order a card of the given type is played for, through a table of the factories indexed by card type.
+ *
+ * @param type The type of the card.
+ * @param arguments The details of the order.
+ * @return The new order.
+ */
+Order *createCardOrder(CardType type, const CardOrderArguments &arguments)
+{
+    return cardOrderCreators[static_cast<int>(type)](arguments);
+}
+
 // <<<< Card Class Definitions >>>>
 
 /**
- * Method that plays the card, which creates an order and adds it
+ * Method that plays a card of this type from the hand, which creates an order and adds it
  * to the player's list of orders and then returns the card to the deck.
  *
  * @param ordersList The orders list to which the created order will be added to.
@@ -15,79 +139,49 @@
  */
 void Card::play(OrdersList &ordersList, Deck &playingDeck, Hand &playingHand)
 {
-    if (playingHand.handVector.size() == 0) ///< If hand is empty.
+    if (!playingHand.has(cardType)) ///< If hand has no card of this type.
     {
-        std::cout << "Hand is empty, no card available to play" << std::endl;
+        std::cout << "Hand has no " << getCardType() << " card available to play" << std::endl;
     }
-    else ///< If hand has at least a card.
+    else ///< If hand has a card of this type.
     {
-        // Stores the name of the source territory for the order.
-        std::string sourceTName = "";
-        // Stores the name of the target territory for the order.
-        std::string targetTName = "";
-        // Stores the number of army units involved in the order.
-        int armies = 0;
-
-        // Check if the order to be issued is an "airlift" type.
-        if (cardType == "airlift")
+        // The details of the order, read from the player's input for the type of the card.
+        CardOrderArguments arguments;
+
+        if (cardType == CardType::AIRLIFT)
         {
             // Prompt the player to choose a source territory for the airlift.
             std::cout << "\nChoose a source territory (army units should be on standby there): ";
-            // Get the name of the source territory.
-            std::cin >> sourceTName;
+            std::cin >> arguments.source;
 
             // Prompt the player to choose a target territory to move to with the airlift.
             std::cout << "\nChoose a target territory to move to: ";
-            // Get the name of the target territory.
-            std::cin >> targetTName;
+            std::cin >> arguments.target;
 
             // Prompt the player to enter the number of army units to be moved by airlift.
             std::cout << "\nEnter the number of army units to execute an airlift order: ";
-            // Get the number of army units for the airlift.
-            std::cin >> armies;
-
-            // Create a new AirliftOrder object and add it to the orders list.
-            ordersList.ordersVector.push_back(new AirliftOrder(sourceTName, targetTName, armies)); // Need to have some logic that registers the details from the player's input
+            std::cin >> arguments.armies;
         }
-        // Check if the order to be issued is a "bomb" type.
-        else if (cardType == "bomb")
+        else if (cardType == CardType::BOMB)
         {
-            // Prompt the player to choose a target territory to execute a bomb order.
             std::cout << "\nChoose a target territory to execute a bomb order: ";
-            // Get the name of the target territory for the bomb.
-            std::cin >> targetTName;
-
-            // Create a new BombOrder object and add it to the orders list.
-            ordersList.ordersVector.push_back(new BombOrder(targetTName)); // Need to have some logic that registers the details from the player's input
+            std::cin >> arguments.target;
         }
-        // Check if the order to be issued is a "blockade" type.
-        else if (cardType == "blockade")
+        else if (cardType == CardType::BLOCKADE)
         {
-            // Prompt the player to choose a target territory for the blockade.
             std::cout << "\nChoose a target territory to execute a blockade order: ";
-            // Get the name of the target territory for the blockade.
-            std::cin >> targetTName;
-
-            // Create a new BlockadeOrder object and add it to the orders list.
-            ordersList.ordersVector.push_back(new BlockadeOrder(targetTName)); // Need to have some logic that registers the details from the player's input
+            std::cin >> arguments.target;
         }
-        // Check if the order to be issued is a "negotiate" type.
-        else if (cardType == "negotiate")
+        else if (cardType == CardType::DIPLOMACY)
         {
-            // Declare a variable to store the name of the target player for negotiation.
-            std::string targetPName;
-
-            // Prompt the player to choose the target player for the negotiate order.
             std::cout << "\nChoose a target player to execute a negotiate order: ";
-            // Get the name of the target player.
-            std::cin >> targetPName;
-
-            // Create a new NegotiateOrder object and add it to the orders list.
-            ordersList.ordersVector.push_back(new NegotiateOrder(targetPName)); // Need to have some logic that registers the details from the player's input
+            std::cin >> arguments.target;
         }
 
-        playingDeck.deckVector.push_back(this); ///< Return the pointer of the played card at the end of the deck.
-        playingHand.handVector.pop_back();      ///< Remove the pointer of the card from the player's hand.
+        // Create the order of the card and add it to the orders list.
+        ordersList.ordersVector.push_back(createCardOrder(cardType, arguments));
+
+        playingHand.play(cardType, playingDeck); ///< Move the played card from the player's hand back to the deck.
     }
 }
 
@@ -97,7 +191,7 @@ void Card::play(OrdersList &ordersList, Deck &playingDeck, Hand &playingHand)
 Card::Card()
 {
     // assign cartType at random
-    cardType = cardTypes[rand() % cardTypes.size()];
+    cardType = static_cast<CardType>(rand() % CARD_TYPE_COUNT);
 }
 
 /**
@@ -105,118 +199,166 @@ Card::Card()
  *
  * @param cardType Type of the card to create.
  */
-Card::Card(std::string cardType) : cardType(std::move(cardType)) {}
-
-// Copy constructor and assignment operator
-Card::Card(const Card &card) : cardType(card.cardType) {}
-void Card::operator=(const Card &card) { cardType = card.cardType; }
+Card::Card(CardType cardType) : cardType(cardType) {}
 
 std::ostream &operator<<(std::ostream &COUT, const Card &CARD)
 {
-    COUT << "Card type: " << CARD.cardType << std::endl;
+    COUT << "Card type: " << CARD.getCardType() << std::endl;
     return COUT;
 }
 
 const std::string &Card::getCardType() const
 {
-    return cardType;
+    return cardTypeName(cardType);
 }
 
-void Card::setCardType(const std::string &cardType)
+void Card::setCardType(CardType cardType)
 {
     Card::cardType = cardType;
 }
 
+// <<<< CardCounts Class Definitions >>>>
+
+int CardCounts::count(CardType type) const
+{
+    return counts[static_cast<int>(type)];
+}
+
+bool CardCounts::has(CardType type) const
+{
+    return counts[static_cast<int>(type)] > 0;
+}
+
+int CardCounts::size() const
+{
+    int cards = 0;
+    for (int count : counts)
+    {
+        cards += count;
+    }
+    return cards;
+}
+
+bool CardCounts::empty() const
+{
+    return size() == 0;
+}
+
+void CardCounts::add(CardType type)
+{
+    counts[static_cast<int>(type)]++;
+}
+
+bool CardCounts::remove(CardType type)
+{
+    if (!has(type))
+    {
+        return false;
+    }
+
+    counts[static_cast<int>(type)]--;
+    return true;
+}
+
+/**
+ * Writes one line per card, grouped by type.
+ */
+static void writeCards(std::ostream &COUT, const CardCounts &cards)
+{
+    for (int i = 0; i < CARD_TYPE_COUNT; ++i)
+    {
+        for (int j = 0; j < cards.counts[i]; ++j)
+        {
+            COUT << Card(static_cast<CardType>(i));
+        }
+    }
+}
+
 // <<<< Deck Class Definitions >>>>
 
 /**
  * Default constructor for the Deck class, initializes deck with random cards.
  */
-Deck::Deck()
+Deck::Deck() : Deck(static_cast<std::uint64_t>(rand())) {}
+
+/**
+ * Initializes the deck with random cards drawn from the given seed.
+ *
+ * @param seed The seed of the engine of the deck.
+ */
+Deck::Deck(std::uint64_t seed)
 {
+    std::seed_seq sequence{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)};
+    engine.seed(sequence);
     for (int i = 0; i < 50; ++i) // Arbitrary deck size
     {
-        deckVector.push_back(new Card()); // Create a card with a random type
+        add(static_cast<CardType>(engine() % CARD_TYPE_COUNT)); // Add a card with a random type
     }
 }
 
 /**
- * Draws a card from the deck and places it in the specified hand.
+ * Draws a card from the deck and places it in the specified hand. A card is picked uniformly among
+ * the cards of the deck, then its type is found from the counts.
  *
  * @param hand The hand to which the drawn card will be added.
+ * @return The CardType of the drawn card, or -1 if the deck is empty.
  */
-void Deck::draw(Hand &hand)
+int Deck::draw(Hand &hand)
 {
-    if (deckVector.empty())
+    const int cards = size();
+    if (cards == 0)
     {
         std::cout << "Deck is empty, no card available to draw\n"
                   << std::endl;
+        return -1;
     }
-    else
+
+    int index = static_cast<int>(engine() % cards);
+    int type = 0;
+    while (index >= counts[type])
     {
-        int index = rand() % deckVector.size();
-        hand.handVector.push_back(deckVector[index]); // Add card to hand
-        deckVector.erase(deckVector.begin() + index); // Remove card from deck
+        index -= counts[type];
+        type++;
     }
+
+    counts[type]--;                          // Remove card from deck
+    hand.add(static_cast<CardType>(type)); // Add card to hand
+    return type;
 }
 
 /**
  * Overloaded Copy constructor of the Deck class, creates a deck given
- * another instance of a deck. This is a deep copy.
+ * another instance of a deck.
  *
  * @param copyPlayingDeck Deck instance that is being copied from.
  */
-Deck::Deck(const Deck &copyPlayingDeck)
-{
-    for (const auto *card : copyPlayingDeck.deckVector)
-    {
-        deckVector.push_back(new Card(*card));
-    }
-}
+Deck::Deck(const Deck &copyPlayingDeck) : CardCounts(copyPlayingDeck), engine(copyPlayingDeck.engine) {}
 
 void Deck::operator=(const Deck &playingDeck)
 {
-    for (auto *card : deckVector)
-    {
-        delete card;
-    }
-    deckVector.clear();
-
-    for (const auto *card : playingDeck.deckVector)
-    {
-        deckVector.push_back(new Card(*card));
-    }
+    counts = playingDeck.counts;
+    engine = playingDeck.engine;
 }
 
 // Overloaded stream insertion operator
 std::ostream &operator<<(std::ostream &COUT, Deck &DECK)
 {
-    if (DECK.deckVector.empty())
+    if (DECK.empty())
     {
         COUT << " <<< Current Deck >>>\nDeck is empty...\n"
              << std::endl;
     }
     else
     {
-        COUT << " <<< Current Deck: " << DECK.deckVector.size() << " Card(s) >>> \n";
-        for (const auto *card : DECK.deckVector)
-        {
-            COUT << *card;
-        }
+        COUT << " <<< Current Deck: " << DECK.size() << " Card(s) >>> \n";
+        writeCards(COUT, DECK);
         COUT << std::endl;
     }
     return COUT;
 }
 
 // Deck destructor
-Deck::~Deck()
-{
-    for (auto *card : deckVector)
-    {
-        delete card;
-    }
-    deckVector.clear();
-}
+Deck::~Deck() = default;
 
 // <<<< Hand Class Definitions >>>>
 
@@ -224,32 +366,35 @@ Deck::~Deck()
 Hand::Hand() = default;
 
 // Copy constructor and assignment operator
-Hand::Hand(const Hand &copyHand)
-{
-    for (const auto *card : copyHand.handVector)
-    {
-        handVector.push_back(new Card(*card));
-    }
-}
+Hand::Hand(const Hand &copyHand) : CardCounts(copyHand) {}
 
 /**
- * Overloaded Assignment operator which assigns the hand type of the assigning
+ * Overloaded Assignment operator which assigns the cards of the assigning
  * hand instance to the assigned hand instance.
  *
  * @param hand Hand instance that is being assigned from.
  */
 void Hand::operator=(const Hand &hand)
 {
-    for (auto *card : handVector)
-    {
-        delete card;
-    }
-    handVector.clear();
+    counts = hand.counts;
+}
 
-    for (const auto *card : hand.handVector)
+/**
+ * Moves a card of the given type from the hand back to the deck.
+ *
+ * @param type The type of the card played.
+ * @param deck The deck the card returns to.
+ * @return true if the hand held a card of this type.
+ */
+bool Hand::play(CardType type, Deck &deck)
+{
+    if (!remove(type))
     {
-        handVector.push_back(new Card(*card));
+        return false;
     }
+
+    deck.add(type);
+    return true;
 }
 
 /**
@@ -261,7 +406,7 @@ void Hand::operator=(const Hand &hand)
  */
 std::ostream &operator<<(std::ostream &COUT, Hand &HAND)
 {
-    if (HAND.handVector.empty())
+    if (HAND.empty())
     {
         COUT << " <<< Player's Hand >>>>\nHand is empty...\n"
              << std::endl;
@@ -269,17 +414,11 @@ std::ostream &operator<<(std::ostream &COUT, Hand &HAND)
     else
     {
         COUT << " <<< Player's Hand >>>>\n";
-        for (const auto *card : HAND.handVector)
-        {
-            COUT << *card;
-        }
+        writeCards(COUT, HAND);
         COUT << std::endl;
     }
     return COUT;
 }
 
 // Hand destructor
-Hand::~Hand()
-{
-    handVector.clear(); // Assumed that cards are deleted in deconstructor of deck
-}
+Hand::~Hand() = default;
@@ -1,6 +1,9 @@
 #ifndef CARDS_H
 #define CARDS_H
 
+#include <array>
+#include <cstdint>
+#include <random>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -16,36 +19,60 @@ class Deck;
  */
 class Hand;
 
-const std::vector<std::string> cardTypes = {"Bomb", "Blockade", "Airlift", "Diplomacy"};
+/**
+ * The types of cards. Notice: < Diplomacy > is equivalent to the < Negotiate > order.
+ */
+enum class CardType
+{
+    BOMB,
+    BLOCKADE,
+    AIRLIFT,
+    DIPLOMACY
+};
+
+const int CARD_TYPE_COUNT = 4; ///< The number of card types.
+
+const std::vector<std::string> cardTypes = {"Bomb", "Blockade", "Airlift", "Diplomacy"}; ///< Names, by CardType.
 
 /**
- * The Card class represents a card in the game. A card can have only one type.
- * Possible types of cards {Bomb, Reinforcement, Blockade, Airlift, Diplomacy}.
+ * @param type A card type.
+ * @return The name of the card type.
+ */
+const std::string &cardTypeName(CardType type);
+
+/**
+ * Finds the card type with the given name, in any case. "Negotiate" is a name of the Diplomacy type.
  *
- * Notice: < Diplomacy > is equivalent to the < Negotiate > order.
+ * @param name The name of a card type.
+ * @param type Receives the card type.
+ * @return true if the name is the name of a card type.
+ */
+bool parseCardType(const std::string &name, CardType &type);
+
+/**
+ * The Card class represents a card in the game. A card can have only one type.
+ * Possible types of cards {Bomb, Blockade, Airlift, Diplomacy}.
  *
- * This Card class contains its card type, a play method which allows the card instance
- * to be played and overloaded operators and constructors.
+ * Cards are values: decks and hands only count the cards of each type they hold, so a Card is only
+ * needed to play a card of a given type from a hand.
  */
 class Card
 {
 public:
-    std::string cardType; ///< The type that the card instance holds.
+    CardType cardType; ///< The type that the card instance holds.
 
     /**
-     * Method that plays the card, which creates an order and adds it
+     * Method that plays a card of this type from the hand, which creates an order and adds it
      * to the player's list of orders and then returns the card to the deck.
      *
      * @param ordersList The orders list to which the created order will be added to.
      * @param playingDeck The deck to which the card will be returned to.
      * @param playingHand The hand from which the card is played.
-     * @param cardOrder A string representing the type of order to be created from the card.
      */
     void play(OrdersList &ordersList, Deck &playingDeck, Hand &playingHand);
 
     /**
-     * Default constructor of the Card class, creates a default card with "undefinedCardType"
-     * for its card type.
+     * Default constructor of the Card class, creates a card of a random type.
      */
     Card();
 
@@ -55,23 +82,7 @@ public:
      *
      * @param cardType Given card type to the card instance.
      */
-    Card(std::string cardType);
-
-    /**
-     * Overloaded Copy constructor of the Card class, creates a card given
-     * another instance of a card. This is a deep copy.
-     *
-     * @param card Card instance that is being copied from.
-     */
-    Card(const Card &card);
-
-    /**
-     * Overloaded Assignment operator which assigns the card type of the assigning
-     * card instance to the assigned card instance.
-     *
-     * @param card Card instance that is being assigned from.
-     */
-    void operator=(const Card &card);
+    Card(CardType cardType);
 
     /**
      * Overloaded Stream insertion operator which outputs the card type
@@ -84,43 +95,153 @@ public:
 
     const std::string &getCardType() const;
 
-    void setCardType(const std::string &cardType);
+    void setCardType(CardType cardType);
 };
 
 /**
- * The Deck class represents a deck of cards in the game. A deck has a vector that
- * holds multiple card pointers and a card can be drawn with the draw method. It also contains
- * its respective overloaded operators and constructors.
+ * The details of the order a card creates, only those used by the type of the card are read.
+ */
+struct CardOrderArguments
+{
+    Player *player = nullptr;        ///< The player issuing the order.
+    std::string source;              ///< The territory armies are airlifted from.
+    std::string target;              ///< The territory targeted, or the player to negotiate with.
+    int armies = 0;                  ///< The armies airlifted.
+    Player *neutralPlayer = nullptr; ///< The player a blockaded territory is handed to.
+};
+
+/**
+ * Creates the order a card of the given type is played for. Each card type has its own specialization, so
+ * strategies that know which card they play create its order without any dispatch at all.
+ *
+ * @tparam Type The type of the card.
+ */
+template <CardType Type>
+struct CardOrderFactory;
+
+template <>
+struct CardOrderFactory<CardType::BOMB>
+{
+    static Order *create(const CardOrderArguments &arguments);
+};
+
+template <>
+struct CardOrderFactory<CardType::BLOCKADE>
+{
+    static Order *create(const CardOrderArguments &arguments);
+};
+
+template <>
+struct CardOrderFactory<CardType::AIRLIFT>
+{
+    static Order *create(const CardOrderArguments &arguments);
+};
+
+template <>
+struct CardOrderFactory<CardType::DIPLOMACY>
+{
+    static Order *create(const CardOrderArguments &arguments);
+};
+
+/**
+ * Creates the order a card of the given type is played for, through a table of the factories indexed by card type.
+ *
+ * @param type The type of the card.
+ * @param arguments The details of the order.
+ * @return The new order.
+ */
+Order *createCardOrder(CardType type, const CardOrderArguments &arguments);
+
+/**
+ * The CardCounts class holds cards as the number of cards of each type, so adding, removing
+ * and finding a card of a given type takes constant time and no memory.
  */
-class Deck
+class CardCounts
 {
 public:
-    std::vector<Card *> deckVector; ///< A vector that contains a pointer to each card in the deck.
+    std::array<int, CARD_TYPE_COUNT> counts{}; ///< The number of cards of each type, by CardType.
+
+    /**
+     * @param type A card type.
+     * @return The number of cards of this type.
+     */
+    int count(CardType type) const;
+
+    /**
+     * @param type A card type.
+     * @return true if there is at least one card of this type.
+     */
+    bool has(CardType type) const;
 
+    /**
+     * @return The number of cards.
+     */
+    int size() const;
+
+    /**
+     * @return true if there is no card.
+     */
+    bool empty() const;
+
+    /**
+     * Adds a card.
+     *
+     * @param type The type of the card.
+     */
+    void add(CardType type);
+
+    /**
+     * Removes a card.
+     *
+     * @param type The type of the card.
+     * @return true if there was a card of this type to remove.
+     */
+    bool remove(CardType type);
+};
+
+/**
+ * The Deck class represents a deck of cards in the game. A deck counts the cards of each type
+ * it holds and a card can be drawn with the draw method. It also contains
+ * its respective overloaded operators and constructors.
+ *
+ * Every deck shuffles with its own random engine, so that the cards of a game seeded with its deck
+ * are the same whatever the other games played at the same time.
+ */
+class Deck : public CardCounts
+{
+public:
     /**
      * Method that draws a card from the deck and places
-     * it in the hand of the given player.
+     * it in the hand of the given player. Every card of the deck is equally likely to be drawn.
      *
      * @param hand The hand in which the drawn card will be placed.
+     * @return The CardType of the drawn card, or -1 if the deck is empty.
      */
-    void draw(Hand &hand);
+    int draw(Hand &hand);
 
     /**
-     * Default constructor of the Deck class, creates a default deck with
-     * no cards in it.
+     * Default constructor of the Deck class, creates a deck of 50 cards of random types, its engine
+     * seeded from rand().
      */
     Deck();
 
+    /**
+     * Creates a deck of 50 cards of random types, its types and draws coming from the given seed.
+     *
+     * @param seed The seed of the engine of the deck, such as the seed of its game.
+     */
+    explicit Deck(std::uint64_t seed);
+
     /**
      * Overloaded Copy constructor of the Deck class, creates a deck given
-     * another instance of a deck. This is a deep copy.
+     * another instance of a deck.
      *
      * @param copyPlayingDeck Deck instance that is being copied from.
      */
     Deck(const Deck &copyPlayingDeck);
 
     /**
-     * Overloaded Assignment operator which assigns the deck type of the assigning
+     * Overloaded Assignment operator which assigns the cards of the assigning
      * deck instance to the assigned deck instance.
      *
      * @param playingDeck Deck instance that is being assigned from.
@@ -137,21 +258,22 @@ public:
     friend std::ostream &operator<<(std::ostream &COUT, Deck &DECK);
 
     /**
-     * Destructor for the Deck class. Frees all dynamically allocated memory used for Cards.
+     * Destructor for the Deck class.
      */
     virtual ~Deck();
+
+private:
+    std::mt19937 engine; ///< Picks the types of the cards of the deck and the cards drawn.
 };
 
 /**
- * The Hand class represents a hand of a player. A hand has a vector that contains
- * the cards that a player holds. It also contains its respective overloaded
+ * The Hand class represents a hand of a player. A hand counts the cards of each type
+ * that a player holds. It also contains its respective overloaded
  * operators and constructors.
  */
-class Hand
+class Hand : public CardCounts
 {
 public:
-    std::vector<Card *> handVector; ///< A vector that contains a pointer to each card in the hand.
-
     /**
      * Default constructor of the Hand class, creates a default hand with
      * no cards in it.
@@ -160,20 +282,29 @@ public:
 
     /**
      * Overloaded Copy constructor of the Hand class, creates a hand given
-     * another instance of a hand. This is a deep copy.
+     * another instance of a hand.
      *
      * @param copyHand Hand instance that is being copied from.
      */
     Hand(const Hand &copyHand);
 
     /**
-     * Overloaded Assignment operator which assigns the hand type of the assigning
+     * Overloaded Assignment operator which assigns the cards of the assigning
      * hand instance to the assigned hand instance.
      *
      * @param hand Hand instance that is being assigned from.
      */
     void operator=(const Hand &hand);
 
+    /**
+     * Moves a card of the given type from the hand back to the deck.
+     *
+     * @param type The type of the card played.
+     * @param deck The deck the card returns to.
+     * @return true if the hand held a card of this type.
+     */
+    bool play(CardType type, Deck &deck);
+
     /**
      * Overloaded Stream insertion operator which outputs the whole
      * hand.
@@ -184,9 +315,9 @@ public:
     friend std::ostream &operator<<(std::ostream &COUT, Hand &HAND);
 
     /**
-     * Destructor for the Hand class. Frees all dynamically allocated memory used for Cards.
+     * Destructor for the Hand class.
      */
     virtual ~Hand();
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -19,20 +19,15 @@ void testCards()
     Deck deck_of_cards; ///< Create a deck.
     int size_of_deck = 10; ///< Determine a size for the deck.
 
-    ///< String array with all possible types of cards.
-    std::string type_of_cards[] = {"bomb", "reinforcement", "blockade", "airlift", "diplomacy"}; 
-
     srand(time(0)); ///< Generate a random seed for the rand() function.
                     ///< Time(0) is using the system's time to generate different seeds.
 
     
     for(int i = 0; i < size_of_deck; i++)
     {
-        int choose_random_card_type = rand() % 5; ///< A random index from 0 to 4 (all 5 possible card types).
-                                                  ///< using rand() to generage the deck of cards.
-        Card tempCard(type_of_cards[choose_random_card_type]); ///< Create a random card type that
-                                                               ///< will be added to the deck.
-        deck_of_cards.deckVector.push_back(new Card(tempCard)); ///< Allocate memory and add current tempCard to the deck of cards.
+        int choose_random_card_type = rand() % CARD_TYPE_COUNT; ///< A random index over all possible card types.
+                                                                ///< using rand() to generage the deck of cards.
+        deck_of_cards.add(static_cast<CardType>(choose_random_card_type)); ///< Add a card of this type to the deck of cards.
     }
 
     std::cout << deck_of_cards; ///< Display the deck.
@@ -56,10 +51,13 @@ void testCards()
 
     ///< Call play() on all cards in the hand to "play" them, which then places them back
     ///< in the deck.
-    for(int i = 0; i < 5; i++) 
+    for(int type = 0; type < CARD_TYPE_COUNT; type++)
     {
-        OrdersList tempOrderList; ///< Create a tempOrderList.
-        hand_holding_cards.handVector[i]->play(tempOrderList, deck_of_cards, hand_holding_cards);
+        while(hand_holding_cards.has(static_cast<CardType>(type)))
+        {
+            OrdersList tempOrderList; ///< Create a tempOrderList.
+            Card(static_cast<CardType>(type)).play(tempOrderList, deck_of_cards, hand_holding_cards);
+        }
     }
 
     std::cout << hand_holding_cards; ///< Display the hand after playing all 5 cards.
@@ -1,6 +1,7 @@
 #include "CommandProcessing.h"
 #include "GameEngine.h"
 #include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <sstream>
 #include <iostream>
@@ -272,6 +273,21 @@ bool CommandProcessor::processTournamentCommand(const std::vector<std::string>&
     int numGames = 0;
     // Max turns for each game
     int maxTurns = 0;
+    // Threads executing orders, sequential unless specified
+    int executionThreads = 1;
+    // Turns without a territory changing hands before a game ends as a draw
+    int stalemateTurns = StalemateDetector::DEFAULT_PATIENCE;
+    // Threads playing the games, one game at a time unless specified
+    int tournamentThreads = 1;
+    // Whether the tournament is played at scale, which lifts the limits on the maps, games and turns
+    bool scaled = false;
+    // Shard of the tournament played by this process, the whole tournament unless specified
+    int shardIndex = 0;
+    int shardCount = 1;
+    // Seed of the tournament, from the clock unless specified
+    std::uint64_t seed = 0;
+    // Whether only the games missing from the checkpoint of the tournament are played
+    bool resume = false;
 
     // Loop through the arguments to extract values for maps, strategies, numGames, and maxTurns
     for (size_t i = 1; i < args.size(); ++i)
@@ -312,21 +328,110 @@ bool CommandProcessor::processTournamentCommand(const std::vector<std::string>&
             // Convert the max turns from string to integer
             maxTurns = std::stoi(args[++i]);
         }
+        // If we encounter the argument -E, orders are executed in parallel batches by the given number of threads
+        else if (args[i] == "-E")
+        {
+            executionThreads = std::stoi(args[++i]);
+        }
+        // If we encounter the argument -S, games end as a draw after the given number of turns without a territory changing hands
+        else if (args[i] == "-S")
+        {
+            stalemateTurns = std::stoi(args[++i]);
+        }
+        // If we encounter the argument -T, games are played in parallel by the given number of threads
+        else if (args[i] == "-T")
+        {
+            tournamentThreads = std::stoi(args[++i]);
+            scaled = true;
+        }
+        // If we encounter the argument --shard i/n, only the shard i out of n shards of the tournament is played
+        else if (args[i] == "--shard")
+        {
+            const std::string shard = args[++i];
+            const size_t slash = shard.find('/');
+            if (slash == std::string::npos)
+            {
+                std::cout << "Invalid tournament shard!\n";
+                return false;
+            }
+            shardIndex = std::stoi(shard.substr(0, slash));
+            shardCount = std::stoi(shard.substr(slash + 1));
+            scaled = true;
+        }
+        // If we encounter the argument --seed, the games are seeded from the given seed
+        else if (args[i] == "--seed")
+        {
+            seed = std::stoull(args[++i]);
+        }
+        // If we encounter the argument --resume, the tournament resumes from its checkpoint
+        else if (args[i] == "--resume")
+        {
+            resume = true;
+        }
     }
 
-    // Validate the parsed parameters to make sure they fall within acceptable ranges
-    if (maps.size() < 1 || maps.size() > 5 || strategies.size() < 2 || strategies.size() > 4 || numGames < 1 || numGames > 5 || maxTurns < 10 || maxTurns > 50) 
+    // Validate the parsed parameters to make sure they fall within acceptable ranges, a tournament played at scale
+    // having no upper limit on its maps, games and turns
+    if (maps.size() < 1 || (!scaled && maps.size() > 5) || strategies.size() < 2 || strategies.size() > 4 || numGames < 1 || (!scaled && numGames > 5) ||
+        maxTurns < 10 || (!scaled && maxTurns > 50) || shardCount < 1 || shardIndex < 0 || shardIndex >= shardCount)
     {
         // If the validation fails, print an error message and return false
         std::cout << "Invalid tournament parameters!\n";
         return false;
     }
 
+    // Every strategy takes a seat in the games, which a human player cannot play unattended
+    for (const std::string &strategy : strategies)
+    {
+        StrategyKind kind;
+        if (strategy != AggressivePlayerStrategy::FRONTIER_NAME &&
+            (!parseStrategyKind(strategy, kind) || kind == StrategyKind::HUMAN))
+        {
+            std::cout << "Invalid tournament strategy " << strategy << "!\n";
+            return false;
+        }
+    }
+
+    // The shards of a tournament are played by separate processes, which only deal the same games with the same seed,
+    // and a seed of 0 is taken from the clock of each process
+    if (shardCount > 1 && seed == 0)
+    {
+        std::cout << "A tournament played in shards needs a --seed other than 0!\n";
+        return false;
+    }
+
     // Call the GameEngine to start the tournament with the parsed and validated parameters
-    gameEngine.startTournament(maps, strategies, numGames, maxTurns);
+    gameEngine.setOrderExecutionThreads(executionThreads);
+    gameEngine.setStalemateTurns(stalemateTurns);
+    gameEngine.setTournamentThreads(tournamentThreads);
+    gameEngine.setTournamentShard(shardIndex, shardCount);
+    gameEngine.setTournamentSeed(seed);
+    gameEngine.setTournamentResume(resume);
 
     // Return true indicating the tournament was successfully started and the results are written in the log file
-    return true;
+    return gameEngine.startTournament(maps, strategies, numGames, maxTurns);
+}
+
+/**
+ * Processes the merge command, which writes the tournament log of a tournament played in shards.
+ *
+ * Every argument after the command is a shard file written by a tournament command with the --shard option.
+ *
+ * @param args A vector of strings representing the command-line arguments passed to the program.
+ * @param gameEngine A reference to the GameEngine instance that will merge the shards.
+ *
+ * @return Returns true if the shard files were merged into the tournament log, otherwise false.
+ */
+bool CommandProcessor::processMergeCommand(const std::vector<std::string>& args, GameEngine &gameEngine)
+{
+    // The program, then the merge command, then the shard files
+    const std::vector<std::string> files(args.begin() + std::min<size_t>(2, args.size()), args.end());
+    if (files.empty())
+    {
+        std::cout << "No tournament shard to merge!\n";
+        return false;
+    }
+    return gameEngine.mergeTournament(files);
 }
 
 // <<<< FileCommandProcessorAdapter Class Definitions >>>>
@@ -202,6 +202,16 @@ public:
      */
     static bool processTournamentCommand(const std::vector<std::string>& args, GameEngine &gameEngine);
 
+    /**
+     * Processes the merge command, which merges the shard files of a tournament into the tournament log.
+     *
+     * @param args A vector of strings representing the command-line arguments passed to the program.
+     * @param gameEngine A reference to the GameEngine instance that will merge the shards.
+     *
+     * @return Returns true if the shard files were merged into the tournament log, otherwise false.
+     */
+    static bool processMergeCommand(const std::vector<std::string>& args, GameEngine &gameEngine);
+
 private:
     /**
      * This function prompts the user to enter a command
@@ -1,12 +1,21 @@
 #include <sstream>
 #include <cmath>
+#include <cctype>
 #include "GameEngine.h"
 #include <ctime>
+#include <cstdio>
 #include <cstdlib>
 #include "CommandProcessing.h"
+#include "PlayerFiles/DecisionProfiler.h"
+#include "TournamentScheduler.h"
+#include "TournamentResults.h"
+#include "TournamentStatistics.h"
+#include "OrdersFiles/BattleKernel.h"
+#include <memory>
 #include <iostream>
 #include <fstream>
 #include <chrono>
+#include <mutex>
 #include <random>
 
 /**
@@ -32,6 +41,16 @@ GameEngine::GameEngine(const GameEngine &copy)
 {
     // Allocating new memory for the current game state and copying its value
     currentGameState = new GameState(*copy.currentGameState);
+
+    // The scheduler, the validation batch and the negotiations only hold per-turn data, the copy creates its own when needed
+    orderExecutionThreads = copy.orderExecutionThreads;
+    searchThreads = copy.searchThreads;
+    stalemateTurns = copy.stalemateTurns;
+    tournamentThreads = copy.tournamentThreads;
+    shardIndex = copy.shardIndex;
+    shardCount = copy.shardCount;
+    tournamentSeed = copy.tournamentSeed;
+    resumeTournament = copy.resumeTournament;
 }
 
 /**
@@ -51,6 +70,10 @@ GameEngine::~GameEngine()
 
     // delete map (map deconstructor will also remove all the allocated memory for the territories and continents)
     delete currentMap;
+
+    delete orderScheduler;
+    delete orderValidation;
+    delete negotiations;
 }
 
 /**
@@ -94,6 +117,21 @@ GameEngine &GameEngine::operator=(const GameEngine &copy)
         // Perform a deep copy of the GameEngine
         // Copy the current game state
         currentGameState = new GameState(*copy.currentGameState);
+
+        orderExecutionThreads = copy.orderExecutionThreads;
+        searchThreads = copy.searchThreads;
+        stalemateTurns = copy.stalemateTurns;
+        tournamentThreads = copy.tournamentThreads;
+        shardIndex = copy.shardIndex;
+        shardCount = copy.shardCount;
+        tournamentSeed = copy.tournamentSeed;
+        resumeTournament = copy.resumeTournament;
+        delete orderScheduler;
+        orderScheduler = nullptr;
+        delete orderValidation;
+        orderValidation = nullptr;
+        delete negotiations;
+        negotiations = nullptr;
     }
 
     // Return a reference to the current object
@@ -315,6 +353,7 @@ void GameEngine::startupPhase(CommandProcessor &commandProcessor, Map &gameMap,
             }
             else
             {
+                gameMap.PrecomputeDistances();
                 std::cout << "Map loaded and validated successfully.\n";
             }
         }
@@ -346,6 +385,7 @@ void GameEngine::startupPhase(CommandProcessor &commandProcessor, Map &gameMap,
                 manageCommand(command);
                 std::string playerName = command.arg;
                 Player::players.push_back(new Player(playerName, {}));
+                Player::players.back()->map = &gameMap;
                 playerCount++;
                 std::cout << "Player " << playerName << " added. Total players: " << playerCount << "\n";
             }
@@ -748,74 +788,98 @@ void GameEngine::issueOrdersPhase(Player *player)
 /**
  * Executes all orders in each player's orders list during the Orders Execution Phase of the game.
  *
- * In this phase, each player sequentially executes the orders in their orders list. If a player has no orders left to execute, the system skips them.
- * After executing an order, it is removed from the player's list. This process repeats until all orders for all players have been executed.
+ * All deploy orders are executed first, player by player. The remaining orders are then executed in a round-robin
+ * fashion, one order per player at a time. If a player has no orders left to execute, the system skips them.
+ * Each order is popped from the front of the player's orders list and deleted once executed.
+ * This process repeats until all orders for all players have been executed. Negotiations made during the phase
+ * expire when it ends.
  *
  * @see Player::getOrdersList()                  Method to retrieve a player's orders list.
- * @see OrdersList::ordersVector                The vector holding the player's orders.
+ * @see OrdersList::extractOrders()              Method to take every order of a given type out of a list.
+ * @see OrdersList::popFront()                   Method to take the next order out of a list.
  * @see Order::execute()                        Method to execute a specific order.
+ * @see OrderValidation::prevalidate()           Method to validate every order before the first one is executed.
  */
 void GameEngine::executeOrdersPhase()
 {
-    // Flag to check if there are any orders left to execute in any player's orders list
-    bool ordersLeft = true;
-    // Flag to check if there are any deploy orders left to execute in any player's orders list
-    bool deployOver = false;
+    const Map *map = Player::players.empty() ? nullptr : Player::players.front()->map;
 
-    // Loop until all orders in the players' orders lists are executed
-    while (ordersLeft)
+    // Validate every order up front, orders only validate themselves again when an earlier order changed their input
+    if (orderValidation == nullptr)
     {
-        // Assume that there are no more orders left to execute across all players initially
-        ordersLeft = false;
+        orderValidation = new OrderValidation();
+    }
+    orderValidation->prevalidate(Player::players, map);
 
-        if (!deployOver)
+    // Negotiations made by the orders of this turn expire once they are all executed
+    if (negotiations == nullptr)
+    {
+        negotiations = new NegotiationMatrix();
+    }
+    negotiations->beginTurn(Player::players);
+
+    // Orders touching disjoint state may be executed in parallel, with the same result
+    if (orderExecutionThreads != 1)
+    {
+        if (orderScheduler == nullptr)
         {
-            // Iterate through each player in the players list
-            for (int i = 0; i < Player::players.size(); i++)
-            {
-                // If the current player has no orders left in their orders list
-                if (Player::players[i]->getOrdersList()->ordersVector.empty())
-                {
-                    // Inform the player that they have no deploy orders to execute
-                    std::cout << "No deploy orders to execute for " << Player::players[i]->getPlayerName() << ".\n";
+            orderScheduler = new OrderScheduler(orderExecutionThreads);
+        }
 
-                    // Skip the current player and move on to the next player
-                    continue;
-                }
+        orderScheduler->executePhase(Player::players, map, orderValidation);
+        negotiations->endTurn();
+        return;
+    }
 
-                // Display whose turn it is for the deploy orders execution phase
-                std::cout << "Deploy Orders Execution Phase for " << Player::players[i]->getPlayerName() << std::endl;
+    // Battles roll from the seed of the phase and the position of their order in it, like in the scheduler
+    const std::uint64_t phaseSeed = BattleKernel::currentSeed();
+    int sequence = 0;
 
-                // Iterate through the orders list of the current player
-                for (int j = 0; j < Player::players[i]->getOrdersList()->ordersVector.size(); j++)
-                {
-                    // If the order is of type "deploy", the order will be executed.
-                    if (Player::players[i]->getOrdersList()->ordersVector[j]->orderType == "deploy")
-                    {
-                        // If the player still has orders to execute, set ordersLeft to true to continue executing orders
-                        ordersLeft = true;
-                        // Executes the first deploy order in the player's orders list.
-                        Player::players[i]->getOrdersList()->ordersVector.front()->execute();
-                        // After executing the order, remove it from the player's orders list
-                        Player::players[i]->getOrdersList()->ordersVector.erase(Player::players[i]->getOrdersList()->ordersVector.begin());
-                    }
-                    // Stop checking further orders if the current order is not "deploy"
-                    else
-                    {
-                        continue;
-                    }
-                }
-            }
+    // Execute the deploy orders of every player first
+    for (int i = 0; i < Player::players.size(); i++)
+    {
+        std::vector<Order *> deployOrders = Player::players[i]->getOrdersList()->extractOrders("deploy");
+
+        // If the current player has no deploy orders in their orders list
+        if (deployOrders.empty())
+        {
+            // Inform the player that they have no deploy orders to execute
+            std::cout << "No deploy orders to execute for " << Player::players[i]->getPlayerName() << ".\n";
+
+            // Skip the current player and move on to the next player
+            continue;
+        }
 
-            // Every player has finished executing their deploy orders in their orders list
-            deployOver = true;
+        // Display whose turn it is for the deploy orders execution phase
+        std::cout << "Deploy Orders Execution Phase for " << Player::players[i]->getPlayerName() << std::endl;
+
+        for (Order *order : deployOrders)
+        {
+            order->sequence = sequence++;
+            order->phaseSeed = phaseSeed;
+            order->execute();
+            orderValidation->executed(order);
+            delete order;
         }
+    }
+
+    // Flag to check if there are any orders left to execute in any player's orders list
+    bool ordersLeft = true;
+
+    // Loop until all orders in the players' orders lists are executed
+    while (ordersLeft)
+    {
+        // Assume that there are no more orders left to execute across all players initially
+        ordersLeft = false;
 
         // Iterate through each player in the game
         for (int i = 0; i < Player::players.size(); i++)
         {
+            // Take the first order out of the player's orders list
+            Order *order = Player::players[i]->getOrdersList()->popFront();
+
             // If the current player has no orders left in their orders list
-            if (Player::players[i]->getOrdersList()->ordersVector.empty())
+            if (order == nullptr)
             {
                 // Inform the player that they have no more orders to execute
                 std::cout << "No more orders to execute for " << Player::players[i]->getPlayerName() << ".\n";
@@ -830,12 +894,93 @@ void GameEngine::executeOrdersPhase()
             // If the player still has orders to execute, set ordersLeft to true to continue executing orders
             ordersLeft = true;
 
-            // Execute the first order in the player's orders list
-            Player::players[i]->getOrdersList()->ordersVector.front()->execute();
-            // After executing the order, remove it from the player's orders list
-            Player::players[i]->getOrdersList()->ordersVector.erase(Player::players[i]->getOrdersList()->ordersVector.begin());
+            // Execute the order, it is no longer referenced by the orders list
+            order->sequence = sequence++;
+            order->phaseSeed = phaseSeed;
+            order->execute();
+            orderValidation->executed(order);
+            delete order;
         }
     }
+
+    negotiations->endTurn();
+}
+
+/**
+ * Sets the number of threads executing orders during the Orders Execution Phase.
+ *
+ * @param threads The number of threads, 1 to execute orders sequentially, 0 for one per hardware thread.
+ */
+void GameEngine::setOrderExecutionThreads(int threads)
+{
+    orderExecutionThreads = std::max(0, threads);
+
+    delete orderScheduler;
+    orderScheduler = nullptr;
+}
+
+/**
+ * Sets the number of threads every MCTS player of a simulated game searches its turns with.
+ *
+ * @param threads The number of threads, 0 for one per hardware thread.
+ */
+void GameEngine::setSearchThreads(int threads)
+{
+    searchThreads = std::max(0, threads);
+}
+
+const char* const GameEngine::TOURNAMENT_COSTS_FILE = "tournament_costs.txt";
+
+/**
+ * Sets the number of threads playing the games of a tournament.
+ *
+ * @param threads The number of threads, 1 to play the games one after the other, 0 for one per hardware thread.
+ */
+void GameEngine::setTournamentThreads(int threads)
+{
+    tournamentThreads = std::max(0, threads);
+}
+
+/**
+ * Sets the shard of the tournament played by this process.
+ *
+ * @param index The index of the shard, from 0.
+ * @param count The number of shards, 1 to play the whole tournament.
+ */
+void GameEngine::setTournamentShard(int index, int count)
+{
+    shardCount = std::max(1, count);
+    shardIndex = std::min(std::max(0, index), shardCount - 1);
+}
+
+/**
+ * Sets the seed of the tournament.
+ *
+ * @param seed The seed, 0 to seed the tournament from the clock.
+ */
+void GameEngine::setTournamentSeed(std::uint64_t seed)
+{
+    tournamentSeed = seed;
+}
+
+/**
+ * Sets whether the tournament resumes from its checkpoint.
+ *
+ * @param resume true to resume the tournament.
+ */
+void GameEngine::setTournamentResume(bool resume)
+{
+    resumeTournament = resume;
+}
+
+/**
+ * Sets how long a simulated game may go on without a territory changing hands before it ends as a draw.
+ *
+ * @param turns The number of turns, 0 to only end the games no player can win early.
+ */
+void GameEngine::setStalemateTurns(int turns)
+{
+    stalemateTurns = std::max(0, turns);
 }
 
 GameState GameEngine::getCurrentGameState() const
@@ -848,152 +993,261 @@ GameState GameEngine::getCurrentGameState() const
  * 
  * This method logs the tournament details and the results of the simulated games, which include the maps
  * and strategies used for the games, the number of games per map, and the maximum number of turns allowed.
+ * A shard of the tournament plays its own games only and writes them to its shard file instead. Every game is
+ * checkpointed as soon as it is over, a resumed tournament only plays the games missing from its checkpoint.
  * 
  * @param maps A vector of strings representing the names of maps to be used in the tournament.
  * @param strategies A vector of strings representing the strategies to be used by players in the tournament.
  * @param numGames The number of games to be played per map.
  * @param maxTurns The maximum number of turns allowed for each game.
+ * @return false if the tournament could not be resumed from its checkpoint.
  */
-void GameEngine::startTournament(const std::vector<std::string>& maps, const std::vector<std::string>& strategies, int numGames, int maxTurns)
+bool GameEngine::startTournament(const std::vector<std::string>& maps, const std::vector<std::string>& strategies, int numGames, int maxTurns)
 {
-    // Open a log file to record the tournament details.
-    std::ofstream logFile("tournament_log.txt");
-    // Write the initial "Tournament mode" header to the log file.
-    logFile << "--- Tournament mode ---\n";
+    TournamentResults tournament(maps, strategies, numGames, maxTurns);
+    tournament.seed = tournamentSeed != 0 ? tournamentSeed : static_cast<std::uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
 
-    // Log the maps that will be used in the tournament.
-    logFile << "M: ";
-    for (size_t i = 0; i < maps.size(); ++i)
+    // Profile the decisions of this tournament only
+    DecisionProfiler::reset();
+
+    // A resumed tournament keeps the seed, the games and the decisions of its checkpoint
+    const bool sharded = shardCount > 1;
+    const std::string checkpoint = TournamentResults::checkpointFileName(shardIndex, shardCount);
+    if (resumeTournament && std::ifstream(checkpoint))
     {
-        logFile << maps[i];
-        if (i != maps.size() - 1)
+        std::string error;
+        if (!tournament.resume(checkpoint, shardIndex, shardCount, error))
         {
-            logFile << ", ";
+            std::cout << "Cannot resume the tournament: " << error << std::endl;
+            return false;
         }
+        std::cout << "Resuming the tournament after " << tournament.getGames().size() << " games.\n";
     }
 
-    // Log the strategies that will be used in the tournament.
-    logFile << "\nP: ";
-    for (size_t i = 0; i < strategies.size(); ++i)
+    std::cout << "Tournament seed: " << tournament.seed << "\n";
+
+    // Every game is appended to the checkpoint as soon as it is over, so a crash only loses the games being played
+    if (!tournament.writeCheckpoint(checkpoint, shardIndex, shardCount))
     {
-        logFile << strategies[i];
-        if (i != strategies.size() - 1)
+        std::cout << "Cannot write the tournament checkpoint " << checkpoint << std::endl;
+        return false;
+    }
+    std::ofstream checkpointFile(checkpoint, std::ios::app);
+    std::mutex checkpointMutex;
+
+    // The statistics of the games are aggregated as they are over
+    TournamentStatistics report;
+    for (const GameRecord& record : tournament.getGames())
+    {
+        report.addGame(strategies, record);
+    }
+
+    // Every game of the shard missing from the checkpoint is a job, the games that took longest in previous
+    // tournaments start first
+    std::vector<int> jobs;
+    for (int job : tournament.shardJobs(shardIndex, shardCount))
+    {
+        if (tournament.find(job / numGames, job % numGames) == nullptr)
         {
-            logFile << ", ";
+            jobs.push_back(job);
         }
     }
+    TournamentCostModel costModel;
+    costModel.load(TOURNAMENT_COSTS_FILE);
+    std::vector<double> costs;
+    for (int job : jobs)
+    {
+        costs.push_back(costModel.expectedCost(maps[job / numGames], strategies));
+    }
 
-    // Log the number of games and the maximum number of turns allowed.
-    logFile << "\nG: " << numGames << "\nD: " << maxTurns << "\n";
-
-    // Initialize a result matrix to track the outcome of each game for each map.
-    // Initially, set all results to "Draw".
-    std::vector<std::vector<std::string>> results(maps.size(), std::vector<std::string>(numGames, "Draw"));
+    // Every worker plays its games on its own engine, the players of a game being local to its thread.
+    // Orders run sequentially and MCTS players search on one thread when games run in parallel: they already keep
+    // every core busy.
+    WorkStealingScheduler scheduler(tournamentThreads);
+    const bool parallel = scheduler.getThreads() > 1 && costs.size() > 1;
+    std::vector<std::unique_ptr<GameEngine>> engines;
+    for (int worker = 0; worker < scheduler.getThreads(); ++worker)
+    {
+        engines.emplace_back(new GameEngine());
+        engines.back()->setOrderExecutionThreads(parallel ? 1 : orderExecutionThreads);
+        engines.back()->setSearchThreads(parallel ? 1 : searchThreads);
+        engines.back()->setStalemateTurns(stalemateTurns);
+    }
 
-    // Simulate the games for each map.
-    for (size_t i = 0; i < maps.size(); ++i)
+    std::vector<GameRecord> records(jobs.size());
+    std::vector<double> elapsed(jobs.size(), 0);
+    WorkStealingScheduler::Statistics statistics = scheduler.run(costs, [&](int job, int worker)
     {
-        std::cout<<"MAP : "<<maps[i]<<std::endl;
-        for (int j = 0; j < numGames; ++j)
-        {
-            std::cout<<"GAME : " << j+1 <<std::endl;
+        GameRecord& record = records[job];
+        record.map = jobs[job] / numGames;
+        record.game = jobs[job] % numGames;
+        auto start = std::chrono::steady_clock::now();
+        record.winner = engines[worker]->playTournamentGame(maps[record.map], strategies, maxTurns, tournament.gameSeed(jobs[job]));
+        elapsed[job] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        record.turns = engines[worker]->turnsPlayed;
+        record.stalemate = engines[worker]->stalemateReason;
+        record.territoryShares = engines[worker]->territoryShares;
+
+        std::lock_guard<std::mutex> lock(checkpointMutex);
+        TournamentResults::writeGame(checkpointFile, record);
+        checkpointFile.flush();
+        report.addGame(strategies, record);
+    });
+    for (const GameRecord& record : records)
+    {
+        tournament.add(record);
+    }
 
-            // Load and validate map
-            setCurrentMap(new Map());
-            MapLoader::LoadMap(maps[i], currentMap);
-            if (!currentMap->Validate()) {
-                results[i][j] = "Invalid Map";
-                continue;
-            }
+    for (size_t job = 0; job < jobs.size(); ++job)
+    {
+        costModel.record(maps[jobs[job] / numGames], strategies, elapsed[job]);
+    }
+    costModel.save(TOURNAMENT_COSTS_FILE);
+    if (parallel)
+    {
+        std::cout << "Tournament played on " << statistics.threads << " threads, " << statistics.steals << " games stolen.\n";
+    }
 
-            // Clear any existing players
-            for (auto player : Player::players) {
-                delete player;
-            }
-            Player::players.clear();
+    // The latencies complete the checkpoint
+    TournamentResults::writeLatencies(checkpointFile);
+    checkpointFile.close();
+    if (sharded)
+    {
+        // The checkpoint of a shard is its shard file, the tournament log is written by merging the shards
+        std::cout << "Shard " << shardIndex << " of " << shardCount << " written to " << checkpoint << ".\n";
+        return true;
+    }
 
-            // Setup game deck
-            setGameDeck(new Deck());
+    // Log the settings and the results of the simulated games and their statistics, the checkpoint is no longer needed.
+    std::ofstream logFile("tournament_log.txt");
+    tournament.writeLog(logFile);
+    logFile.close();
+    report.writeFiles();
+    std::remove(checkpoint.c_str());
+    return true;
+}
 
-            // Simulate the game
-            simulateGame(strategies, maxTurns);
+/**
+ * Merges the shard files of a tournament into the tournament log.
+ *
+ * @param files The shard files.
+ * @return false, with the reason on the standard output, if the files could not be merged.
+ */
+bool GameEngine::mergeTournament(const std::vector<std::string>& files)
+{
+    // The log reports the decisions of the merged shards only
+    DecisionProfiler::reset();
 
-            // Record the winner
-            if (Player::players.size() == 1) {
-                results[i][j] = Player::players[0]->getPlayerName();
-            } else {
-                results[i][j] = "Draw";
-            }
-        }
+    TournamentResults tournament;
+    std::string error;
+    if (!TournamentResults::mergeShards(files, tournament, error))
+    {
+        std::cout << "Cannot merge the tournament: " << error << std::endl;
+        return false;
     }
 
-    // Log the results of the simulated games.
-    logFile << "Results:\n";
-    for (int map = 0; map < maps.size(); ++map)
+    std::ofstream logFile("tournament_log.txt");
+    tournament.writeLog(logFile);
+    logFile.close();
+
+    TournamentStatistics report;
+    for (const GameRecord& record : tournament.getGames())
     {
-        // Log the result for each game.
-        logFile << "Map " << (map + 1) << ": ";
+        report.addGame(tournament.strategies, record);
+    }
+    report.writeFiles();
+    std::cout << "Merged " << files.size() << " shards into tournament_log.txt.\n";
+    return true;
+}
 
-        // For each map, log the result of the game.
-        for (size_t i = 0; i < numGames; ++i)
-        {
-            // Result for this map and game
-            logFile << results[map][i];
-            
-            if (i != numGames - 1)
-            {
-                logFile << ", ";
-            }
-        }
-        logFile << "\n";
+/**
+ * Plays one game of a tournament on a fresh copy of a map and a fresh deck, then deletes the game.
+ *
+ * @param mapFile The map file of the game.
+ * @param strategies The strategies of the players.
+ * @param maxTurns The maximum number of turns of the game.
+ * @param seed The seed of the distribution of the continents and of the battles of the game.
+ * @return The name of the winner, "Draw", or "Invalid Map".
+ */
+std::string GameEngine::playTournamentGame(const std::string& mapFile, const std::vector<std::string>& strategies, int maxTurns, std::uint64_t seed) {
+    std::cout << "MAP : " << mapFile << std::endl;
+    turnsPlayed = 0;
+    stalemateReason.clear();
+    territoryShares.clear();
+
+    // Load and validate map
+    Map* map = new Map();
+    MapLoader::LoadMap(mapFile, map);
+    if (!map->Validate()) {
+        delete map;
+        return "Invalid Map";
     }
+    map->PrecomputeDistances();
+    setCurrentMap(map);
 
-    // Add a closing line to signify the end of the tournament log.
-    logFile << "--- End of Tournament ---\n\n";
+    // Clear any existing players
+    for (auto player : Player::players) {
+        delete player;
+    }
+    Player::players.clear();
 
-    // Close the log file after writing all details.
-    logFile.close();
+    // Setup game deck, its cards dealt from the seed of the game
+    Deck* deck = new Deck(seed);
+    setGameDeck(deck);
+
+    // Simulate the game, its battles rolling from its seed
+    BattleKernel::seedThread(seed);
+    simulateGame(strategies, maxTurns, seed);
+    BattleKernel::unseedThread();
+
+    // Record the winner and the share of the territories of the players left
+    std::string result = Player::players.size() == 1 ? Player::players[0]->getPlayerName() : "Draw";
+    for (Player* player : Player::players) {
+        territoryShares[player->getPlayerName()] = static_cast<double>(player->getOwnedTerritories().size()) / map->territories.size();
+    }
+
+    // The game is over, its players, map and deck go with it
+    for (auto player : Player::players) {
+        delete player;
+    }
+    Player::players.clear();
+    setCurrentMap(nullptr);
+    setGameDeck(nullptr);
+    delete map;
+    delete deck;
+
+    return result;
 }
 
-void GameEngine::simulateGame(const std::vector<std::string>& strategies, int maxTurns) {
+void GameEngine::simulateGame(const std::vector<std::string>& strategies, int maxTurns, std::uint64_t seed) {
     // Initialize players with their strategies
     for (const auto& strategy : strategies) {
         // Count number of players of strategies already in game for incrementing naming counts
         int numOfExistingOfStrategy = 0;
         for (auto p : Player::players) {
-            if (strategy == "Aggressive") {
-                if (dynamic_cast<AggressivePlayerStrategy*>(p->getStrategy()) != nullptr) {
-                    numOfExistingOfStrategy++;
-                }
-            } else if (strategy == "Benevolent") {
-                if (dynamic_cast<BenevolentPlayerStrategy*>(p->getStrategy()) != nullptr) {
-                    numOfExistingOfStrategy++;
-                }
-            } else if (strategy == "Neutral") {
-                if (dynamic_cast<NeutralPlayerStrategy*>(p->getStrategy()) != nullptr) {
-                    numOfExistingOfStrategy++;
-                }
-            } else if (strategy == "Cheater") {
-                if (dynamic_cast<CheaterPlayerStrategy*>(p->getStrategy()) != nullptr) {
-                    numOfExistingOfStrategy++;
-                }
+            const std::string name = p->getPlayerName();
+            if (name.size() > strategy.size() && name.compare(0, strategy.size(), strategy) == 0 && std::isdigit(static_cast<unsigned char>(name[strategy.size()]))) {
+                numOfExistingOfStrategy++;
             }
         }
 
         Player* player = new Player(strategy + std::to_string(numOfExistingOfStrategy), {});
+        player->map = currentMap;
         // Set player's strategy based on input
-        if (strategy == "Aggressive") {
-            player->setStrategy(new AggressivePlayerStrategy(player));
-            Player::players.push_back(player);
-        } else if (strategy == "Benevolent") {
-            player->setStrategy(new BenevolentPlayerStrategy(player));
-            Player::players.push_back(player);
-        } else if (strategy == "Neutral") {
-            player->setStrategy(new NeutralPlayerStrategy(player));
-            Player::players.push_back(player);
-        } else if (strategy == "Cheater") {
-            player->setStrategy(new CheaterPlayerStrategy(player));
+        PlayerStrategy* playerStrategy = createStrategy(strategy, player);
+        if (playerStrategy == nullptr || PlayerStrategy::isKind(playerStrategy, StrategyKind::HUMAN)) {
+            delete playerStrategy;
+            delete player;
+            continue;
+        }
+        if (PlayerStrategy::isKind(playerStrategy, StrategyKind::MCTS)) {
+            static_cast<MCTSPlayerStrategy*>(playerStrategy)->setThreads(searchThreads);
+        }
+        player->setStrategy(playerStrategy);
+        if (PlayerStrategy::isKind(playerStrategy, StrategyKind::CHEATER)) {
             Player::players.insert(Player::players.begin(), player); // insert at start, so that it takes territories before the other players
+        } else {
+            Player::players.push_back(player);
         }
     }
 
@@ -1003,9 +1257,8 @@ void GameEngine::simulateGame(const std::vector<std::string>& strategies, int ma
         allContinents.push_back(territory.second);
     }
 
-    // obtain a time-based seed:
-    unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-    std::shuffle(allContinents.begin(), allContinents.end(), std::default_random_engine(seed));
+    // The continents are dealt from the seed of the game
+    std::shuffle(allContinents.begin(), allContinents.end(), std::default_random_engine(static_cast<unsigned>(seed)));
 
     // Assign territories to players
     int continentIdx = 0;
@@ -1036,9 +1289,12 @@ void GameEngine::simulateGame(const std::vector<std::string>& strategies, int ma
         std::cout<<*p;
     }
 
-    // Main game loop
+    // Main game loop, until a player wins, the turns run out or the game is stalemated
+    StalemateDetector stalemateDetector(stalemateTurns);
+    StalemateDetector::Verdict verdict = StalemateDetector::Verdict::PLAYING;
+    stalemateReason.clear();
     int currentTurn = 0;
-    while (currentTurn < maxTurns && Player::players.size() > 1) {
+    while (currentTurn < maxTurns && Player::players.size() > 1 && verdict == StalemateDetector::Verdict::PLAYING) {
         std::cout<<"TURN : "<< currentTurn + 1 <<std::endl;
 
         // Reinforcement Phase
@@ -1058,10 +1314,8 @@ void GameEngine::simulateGame(const std::vector<std::string>& strategies, int ma
         // Issue Orders Phase
         setCurrentState(GameState::Issue_Orders);
         for (Player* player : Player::players) {
-            // Let the strategy determine and issue orders
-            do {
-                player->issueOrder(mainDeck);
-            } while ((player->getStrategy()->isIssuingOrders()));
+            // Let the strategy plan and issue the whole turn
+            player->issueOrder(mainDeck);
         }
 
         // Execute Orders Phase
@@ -1069,12 +1323,20 @@ void GameEngine::simulateGame(const std::vector<std::string>& strategies, int ma
         executeOrdersPhase();
 
         currentTurn++;
+        verdict = stalemateDetector.observe(Player::players, *currentMap);
     }
+    turnsPlayed = currentTurn;
 
     // Determine winner
     if (Player::players.size() == 1) {
         std::cout << "Player " << Player::players[0]->getPlayerName() << " wins!\n";
         setCurrentState(GameState::Win);
+    } else if (verdict != StalemateDetector::Verdict::PLAYING) {
+        stalemateReason = StalemateDetector::describe(verdict);
+        if (verdict == StalemateDetector::Verdict::NO_PROGRESS) {
+            stalemateReason += " for " + std::to_string(stalemateDetector.getQuietTurns()) + " turns";
+        }
+        std::cout << "Game ended in a draw after " << currentTurn << " turns: " << stalemateReason << ".\n";
     } else {
         std::cout << "Game ended in a draw after " << maxTurns << " turns.\n";
     }
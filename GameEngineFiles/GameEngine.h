@@ -1,6 +1,7 @@
 #ifndef GAME_ENGINE_H
 #define GAME_ENGINE_H
 
+#include <cstdint>
 #include <iostream>
 #include <string>
 #include <map>
@@ -11,6 +12,8 @@
 #include "CardsFiles/Cards.h"
 #include "LogFiles/LoggingObserver.h"
 #include "CommandProcessing.h"
+#include "OrdersFiles/OrderScheduler.h"
+#include "StalemateDetector.h"
 
 /**
  * GameEngine class responsible for managing the game states and commands.
@@ -27,7 +30,61 @@ private:
     // The deck used for the game
     Deck *mainDeck;
 
+    // Number of threads executing orders, orders are executed sequentially unless it is greater than 1
+    int orderExecutionThreads = 1;
+
+    // Number of threads searching the turns of every MCTS player, 0 for one per hardware thread
+    int searchThreads = 0;
+
+    // Scheduler running the orders execution phase in parallel batches, created on first use
+    OrderScheduler *orderScheduler = nullptr;
+
+    // Batch validating every order at the start of the orders execution phase, created on first use
+    OrderValidation *orderValidation = nullptr;
+
+    // Negotiations between the players, active until the end of the turn, created on first use
+    NegotiationMatrix *negotiations = nullptr;
+
+    // Turns without a territory changing hands after which a simulated game ends as a draw, 0 to play them out
+    int stalemateTurns = StalemateDetector::DEFAULT_PATIENCE;
+
+    // Why the last simulated game ended early as a draw, empty if it did not
+    std::string stalemateReason;
+
+    // Number of turns played by the last simulated game
+    int turnsPlayed = 0;
+
+    // Share of the territories of every player left at the end of the last simulated game, by player name
+    std::map<std::string, double> territoryShares;
+
+    // Number of threads playing the games of a tournament, 0 for one per hardware thread
+    int tournamentThreads = 1;
+
+    // The shard of the tournament played by this process and the number of shards, 1 to play the whole tournament
+    int shardIndex = 0;
+    int shardCount = 1;
+
+    // The seed of the tournament, 0 to seed it from the clock
+    std::uint64_t tournamentSeed = 0;
+
+    // Whether the tournament resumes from its checkpoint, only playing the games missing from it
+    bool resumeTournament = false;
+
+    /**
+     * Plays one game of a tournament on a fresh copy of a map and a fresh deck, then deletes the game.
+     *
+     * @param mapFile The map file of the game.
+     * @param strategies The strategies of the players.
+     * @param maxTurns The maximum number of turns of the game.
+     * @param seed The seed of the distribution of the continents and of the battles of the game.
+     * @return The name of the winner, "Draw", or "Invalid Map".
+     */
+    std::string playTournamentGame(const std::string& mapFile, const std::vector<std::string>& strategies, int maxTurns, std::uint64_t seed);
+
 public:
+    // File recording how long tournament games took, to start the longest ones first
+    static const char* const TOURNAMENT_COSTS_FILE;
+
     // Default Constructor
     GameEngine();
 
@@ -113,6 +170,21 @@ public:
      */
     void executeOrdersPhase();
 
+    /**
+     * Sets the number of threads executing orders. With more than one thread, orders touching disjoint
+     * territories and players are executed in parallel batches, with the same result as sequential execution.
+     *
+     * @param threads The number of threads, 1 to execute orders sequentially, 0 for one per hardware thread.
+     */
+    void setOrderExecutionThreads(int threads);
+
+    /**
+     * Sets the number of threads every MCTS player of a simulated game searches its turns with.
+     *
+     * @param threads The number of threads, 0 for one per hardware thread.
+     */
+    void setSearchThreads(int threads);
+
     /**
      * Initializes the game setup phase, including map loading, validation, player addition,
      * territory distribution, and initial resource allocation. This function guides the game
@@ -141,10 +213,57 @@ public:
      * @param strategies A vector of strings representing the strategies to be used by players in the tournament.
      * @param numGames The number of games to be played per map.
      * @param maxTurns The maximum number of turns allowed for each game.
+     * @return false if the tournament could not be resumed from its checkpoint.
+     */
+    bool startTournament(const std::vector<std::string>& maps, const std::vector<std::string>& strategies, int numGames, int maxTurns);
+
+    /**
+     * Sets the number of threads playing the games of a tournament.
+     *
+     * @param threads The number of threads, 1 to play the games one after the other, 0 for one per hardware thread.
+     */
+    void setTournamentThreads(int threads);
+
+    /**
+     * Sets the shard of the tournament played by this process. A shard plays its games only and writes them to its
+     * shard file instead of the tournament log, the shard files are merged back into the tournament log afterwards.
+     *
+     * @param index The index of the shard, from 0.
+     * @param count The number of shards, 1 to play the whole tournament.
+     */
+    void setTournamentShard(int index, int count);
+
+    /**
+     * Sets the seed of the tournament, the seed of every game is derived from it.
+     *
+     * @param seed The seed, 0 to seed the tournament from the clock.
+     */
+    void setTournamentSeed(std::uint64_t seed);
+
+    /**
+     * Sets whether the tournament resumes from its checkpoint. A resumed tournament keeps the seed and the games of
+     * its checkpoint and only plays the missing games, a tournament without a checkpoint starts from the first game.
+     *
+     * @param resume true to resume the tournament.
+     */
+    void setTournamentResume(bool resume);
+
+    /**
+     * Merges the shard files of a tournament into the tournament log.
+     *
+     * @param files The shard files.
+     * @return false, with the reason on the standard output, if the files could not be merged.
+     */
+    bool mergeTournament(const std::vector<std::string>& files);
+
+    /**
+     * Sets how long a simulated game may go on without a territory changing hands before it ends as a draw.
+     *
+     * @param turns The number of turns, 0 to only end the games no player can win early.
      */
-    void startTournament(const std::vector<std::string>& maps, const std::vector<std::string>& strategies, int numGames, int maxTurns);
+    void setStalemateTurns(int turns);
 
-    void simulateGame(const std::vector<std::string>& strategies, int maxTurns);
+    void simulateGame(const std::vector<std::string>& strategies, int maxTurns, std::uint64_t seed);
 };
 
 #endif
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "MapFiles/Map.h"
 #include "PlayerFiles/Player.h"
 #include "CommandProcessing.h"
+#include "StalemateDetector.h"
 #include <vector>
 #include <set>
 
@@ -87,9 +88,12 @@ void testStartupPhase()
             std::cout << " - " << territory->name << "\n";
         }
         std::cout << "Hand:\n";
-        for (Card *card : player->getPlayerHand()->handVector)
+        for (int type = 0; type < CARD_TYPE_COUNT; ++type)
         {
-            std::cout << " - Card: " << card->getCardType() << "\n";
+            for (int i = 0; i < player->getPlayerHand()->counts[type]; ++i)
+            {
+                std::cout << " - Card: " << cardTypes[type] << "\n";
+            }
         }
         std::cout << "\n";
     }
@@ -170,3 +174,48 @@ void testMainGameLoop()
     delete gameMap;
     delete gameEngine;
 }
+
+/**
+ * Demonstrates the stalemate detector on the Montreal map: a benevolent and a neutral player can never take a
+ * territory, and once one of them turns aggressive the game only ends after the owners stop changing.
+ */
+void testStalemateDetector()
+{
+    Map *gameMap = new Map();
+    MapLoader::LoadMap("../SomeMapsFromOnline/Montreal/Grand Montreal.map", gameMap);
+
+    Player *benevolentPlayer = new Player("Benevolent Player");
+    benevolentPlayer->setStrategy(new BenevolentPlayerStrategy(benevolentPlayer));
+    Player *otherPlayer = new Player("Neutral Player");
+    otherPlayer->setStrategy(new NeutralPlayerStrategy(otherPlayer));
+    std::vector<Player *> players = {benevolentPlayer, otherPlayer};
+    for (Territory *territory : gameMap->territoriesById)
+    {
+        players[territory->id % 2]->getOwnedTerritories().push_back(territory);
+    }
+
+    StalemateDetector detector(3);
+    std::cout << "Benevolent against neutral: " << StalemateDetector::describe(detector.observe(players, *gameMap)) << "\n";
+
+    delete otherPlayer->getStrategy();
+    otherPlayer->setStrategy(new AggressivePlayerStrategy(otherPlayer));
+    detector = StalemateDetector(3);
+    for (int turn = 1; turn <= 5; ++turn)
+    {
+        // A territory changes hands on the second turn only
+        if (turn == 2)
+        {
+            Territory *taken = benevolentPlayer->getOwnedTerritories().back();
+            benevolentPlayer->getOwnedTerritories().pop_back();
+            otherPlayer->getOwnedTerritories().push_back(taken);
+        }
+
+        StalemateDetector::Verdict verdict = detector.observe(players, *gameMap);
+        std::cout << "Benevolent against aggressive, turn " << turn << ": " << StalemateDetector::describe(verdict)
+                  << " (" << detector.getQuietTurns() << " quiet turns)\n";
+    }
+
+    delete benevolentPlayer;
+    delete otherPlayer;
+    delete gameMap;
+}
@@ -8,5 +8,6 @@
 void testGameStates();
 void testStartupPhase();
 void testMainGameLoop();
+void testStalemateDetector();
 
 #endif //COMP345_WARZONE_GAMEENGINEDRIVER_H
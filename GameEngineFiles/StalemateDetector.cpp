@@ -0,0 +1,91 @@
+#include <algorithm>
+#include "StalemateDetector.h"
+#include "MapFiles/Map.h"
+#include "PlayerFiles/Player.h"
+#include "PlayerFiles/PlayerStrategies.h"
+
+const int StalemateDetector::DEFAULT_PATIENCE;
+
+/**
+ * @param patience The number of turns without a territory changing hands after which the game is a draw,
+ * 0 to only end games no player can win.
+ */
+StalemateDetector::StalemateDetector(int patience) : patience(std::max(0, patience)), quietTurns(0)
+{
+}
+
+/**
+ * @brief Observes the game at the end of a turn.
+ *
+ * @param players The players still in the game.
+ * @param map The map of the game, its territory ids must be assigned.
+ * @return Whether the game is stalemated.
+ */
+StalemateDetector::Verdict StalemateDetector::observe(const std::vector<Player *> &players, const Map &map)
+{
+    std::vector<const Player *> current(map.territoriesById.size(), nullptr);
+    bool attacker = false;
+    for (Player *player : players)
+    {
+        for (Territory *territory : player->getOwnedTerritories())
+        {
+            current[territory->id] = player;
+        }
+        attacker = attacker || canChangeOwnership(player);
+    }
+
+    quietTurns = current == owners ? quietTurns + 1 : 0;
+    owners.swap(current);
+
+    if (!attacker)
+    {
+        return Verdict::NO_ATTACKER;
+    }
+    if (patience > 0 && quietTurns >= patience)
+    {
+        return Verdict::NO_PROGRESS;
+    }
+    return Verdict::PLAYING;
+}
+
+/**
+ * @return The number of turns in a row without a territory changing hands.
+ */
+int StalemateDetector::getQuietTurns() const
+{
+    return quietTurns;
+}
+
+int StalemateDetector::getPatience() const
+{
+    return patience;
+}
+
+/**
+ * @param player A player.
+ * @return true if the player can take a territory: its strategy attacks, or it holds a blockade card.
+ */
+bool StalemateDetector::canChangeOwnership(Player *player)
+{
+    PlayerStrategy *strategy = player->getStrategy();
+    const bool passive = PlayerStrategy::isKind(strategy, StrategyKind::BENEVOLENT) ||
+                         PlayerStrategy::isKind(strategy, StrategyKind::NEUTRAL);
+    return !passive || player->getPlayerHand()->count(CardType::BLOCKADE) > 0;
+}
+
+/**
+ * @param verdict A verdict.
+ * @return Why the game ended, as logged.
+ */
+const char *StalemateDetector::describe(Verdict verdict)
+{
+    switch (verdict)
+    {
+    case Verdict::NO_ATTACKER:
+        return "no player can take a territory";
+    case Verdict::NO_PROGRESS:
+        return "no territory changed hands";
+    default:
+        return "playing";
+    }
+}
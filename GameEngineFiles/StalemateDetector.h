@@ -0,0 +1,76 @@
+#ifndef STALEMATE_DETECTOR_H
+#define STALEMATE_DETECTOR_H
+
+#include <vector>
+
+class Map;
+class Player;
+
+/**
+ * @brief Tells when a simulated game can no longer end with a winner, so that it can end as a draw early.
+ *
+ * After every turn the detector looks at the owner of every territory. A game is stalemated as soon as no player
+ * can change the owner of a territory: only advance orders from attacking strategies and blockade cards do, so a
+ * game left to benevolent and neutral players without blockade cards never ends. A game also ends once the owners
+ * have not changed for a number of turns in a row, the patience of the detector.
+ */
+class StalemateDetector
+{
+public:
+    /**
+     * @brief Why a game is stalemated.
+     */
+    enum class Verdict
+    {
+        PLAYING,     ///< The game may still end with a winner.
+        NO_ATTACKER, ///< No player is able to change the owner of a territory.
+        NO_PROGRESS  ///< No territory changed hands for the patience of the detector.
+    };
+
+    /**
+     * @brief The patience of the tournament: none, so that only the games no player can win end early and a game
+     * still being fought runs to its turn limit unless -S asks otherwise.
+     */
+    static const int DEFAULT_PATIENCE = 0;
+
+    /**
+     * @param patience The number of turns without a territory changing hands after which the game is a draw,
+     * 0 to only end games no player can win.
+     */
+    explicit StalemateDetector(int patience = DEFAULT_PATIENCE);
+
+    /**
+     * @brief Observes the game at the end of a turn.
+     *
+     * @param players The players still in the game.
+     * @param map The map of the game, its territory ids must be assigned.
+     * @return Whether the game is stalemated.
+     */
+    Verdict observe(const std::vector<Player *> &players, const Map &map);
+
+    /**
+     * @return The number of turns in a row without a territory changing hands.
+     */
+    int getQuietTurns() const;
+
+    int getPatience() const;
+
+    /**
+     * @param player A player.
+     * @return true if the player can take a territory: its strategy attacks, or it holds a blockade card.
+     */
+    static bool canChangeOwnership(Player *player);
+
+    /**
+     * @param verdict A verdict.
+     * @return Why the game ended, as logged.
+     */
+    static const char *describe(Verdict verdict);
+
+private:
+    int patience;
+    int quietTurns;
+    std::vector<const Player *> owners; ///< The owner of every territory by id, at the end of the last turn.
+};
+
+#endif
@@ -1,9 +1,18 @@
 #include "TournamentDriver.h"
 #include "GameEngine.h"
 #include "CommandProcessing.h"
+#include "TournamentScheduler.h"
+#include "TournamentResults.h"
+#include "TournamentStatistics.h"
+#include "PlayerFiles/DecisionProfiler.h"
 #include <iostream>
 #include <vector>
 #include <string>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <thread>
 
 /**
  * Processes and handles the tournament command passed through the command line.
@@ -21,15 +30,8 @@ void testTournament(int argc, char *argv[])
     if (argc < 2)
     {
         // If not, print an error message showing the expected command format
-        std::cerr << "Usage: tournament -M <maps> -P <strategies> -G <numGames> -D <maxTurns>\n";
-        return;
-    }
-
-    // Ensure the first argument is "tournament" to match the command signature
-    if (std::string(argv[1]) != "tournament")
-    {
-        // If the first argument is not "tournament", print an error message
-        std::cerr << "Invalid command. The first argument must be 'tournament'.\n";
+        std::cerr << "Usage: tournament -M <maps> -P <strategies> -G <numGames> -D <maxTurns> [-E <executionThreads>] [-S <stalemateTurns>] [-T <tournamentThreads>] [--shard <index>/<count>] [--seed <seed>] [--resume]\n"
+                  << "       merge <shardFiles>\n";
         return;
     }
 
@@ -39,6 +41,24 @@ void testTournament(int argc, char *argv[])
     // Create an instance of the GameEngine to manage the tournament's logic
     GameEngine gameEngine;
 
+    // The shards of a tournament played by several processes are merged into its tournament log
+    if (args[1] == "merge")
+    {
+        if (!CommandProcessor::processMergeCommand(args, gameEngine))
+        {
+            std::cerr << "Failed to merge the tournament.\n";
+        }
+        return;
+    }
+
+    // Ensure the first argument is "tournament" to match the command signature
+    if (args[1] != "tournament")
+    {
+        // If the first argument is not "tournament", print an error message
+        std::cerr << "Invalid command. The first argument must be 'tournament' or 'merge'.\n";
+        return;
+    }
+
     // Process the tournament command using the CommandProcessor
     // This function will parse the arguments and set up the tournament
     if (CommandProcessor::processTournamentCommand(args, gameEngine))
@@ -52,3 +72,243 @@ void testTournament(int argc, char *argv[])
         std::cerr << "Failed to start the tournament.\n";
     }
 }
+
+/**
+ * Demonstrates the work-stealing scheduler and the cost model of parallel tournaments.
+ *
+ * Twelve jobs sleep for their expected cost, two of them much longer than the others, and run on three workers:
+ * the two long jobs start first and the third worker, then the two others, steal the short jobs queued behind them.
+ * The cost model then records games and is saved, a second model standing for another shard saves the same file
+ * without losing them, and the file loaded back ranks a game never played first.
+ */
+void testTournamentScheduler()
+{
+    std::vector<double> costs = {5, 5, 40, 5, 5, 5, 60, 5, 5, 5, 5, 5};
+    std::vector<int> started;
+    std::mutex startedMutex;
+
+    WorkStealingScheduler scheduler(3);
+    auto start = std::chrono::steady_clock::now();
+    WorkStealingScheduler::Statistics statistics = scheduler.run(costs, [&](int job, int /* worker */)
+    {
+        {
+            std::lock_guard<std::mutex> lock(startedMutex);
+            started.push_back(job);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<int>(costs[job])));
+    });
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Jobs in start order:";
+    for (int job : started)
+    {
+        std::cout << " " << job << "(" << costs[job] << ")";
+    }
+    std::cout << "\nJobs per worker:";
+    for (int jobs : statistics.jobsRun)
+    {
+        std::cout << " " << jobs;
+    }
+    std::cout << "\n" << statistics.steals << " jobs stolen, " << elapsed << " ms for 110 ms of work on "
+              << statistics.threads << " workers\n";
+
+    const char *path = "tournament_costs_test.txt";
+    TournamentCostModel model;
+    model.record("Aden.map", {"Aggressive", "Benevolent"}, 120);
+    model.record("Aden.map", {"Benevolent", "Aggressive"}, 80);
+    model.record("3D.map", {"Aggressive", "Benevolent"}, 15);
+    model.save(path);
+
+    // Another shard saving the same file keeps the costs of the first one
+    TournamentCostModel shard;
+    shard.record("Montreal.map", {"Aggressive", "Benevolent"}, 40);
+    shard.save(path);
+
+    TournamentCostModel loaded;
+    loaded.load(path);
+    std::remove(path);
+    std::cout << "Aden.map costs " << loaded.expectedCost("Aden.map", {"Aggressive", "Benevolent"}) << " ms, 3D.map "
+              << loaded.expectedCost("3D.map", {"Benevolent", "Aggressive"}) << " ms, Montreal.map "
+              << loaded.expectedCost("Montreal.map", {"Aggressive", "Benevolent"}) << " ms from another shard, an unknown map "
+              << loaded.expectedCost("Caribbean.map", {"Aggressive", "Benevolent"}) << " ms\n";
+}
+
+/**
+ * Demonstrates a tournament split in shards and merged back into its tournament log.
+ *
+ * Two maps of three games are dealt to three shards written by hand, the last one interrupted before its last game
+ * and its latencies. The shards merge into the log of the whole tournament, the interrupted game being "Not Played",
+ * and merging a shard twice, or with a shard played with another seed, is refused.
+ */
+void testTournamentShards()
+{
+    TournamentResults tournament({"Aden.map", "Roman Empire.map"}, {"Aggressive", "Benevolent"}, 3, 20);
+    tournament.seed = 345;
+    const int shards = 3;
+    std::vector<std::string> files;
+    for (int shard = 0; shard < shards; ++shard)
+    {
+        files.push_back("test_" + TournamentResults::shardFileName(shard, shards));
+        std::ofstream file(files.back());
+        tournament.writeShardHeader(file, shard, shards);
+
+        std::vector<int> jobs = tournament.shardJobs(shard, shards);
+        std::cout << "Shard " << shard << " plays jobs";
+        for (int job : jobs)
+        {
+            std::cout << " " << job;
+        }
+        std::cout << "\n";
+
+        // The last shard crashes before its last game
+        if (shard == shards - 1)
+        {
+            jobs.pop_back();
+        }
+
+        DecisionProfiler::reset();
+        for (int job : jobs)
+        {
+            GameRecord record;
+            record.map = job / tournament.numGames;
+            record.game = job % tournament.numGames;
+            record.turns = 10 + job;
+            record.winner = job % 2 == 0 ? "Aggressive0" : "Draw";
+            record.stalemate = job % 2 == 0 ? "" : "no territory changed hands for 10 turns";
+            TournamentResults::writeGame(file, record);
+            DecisionProfiler::profile("Aggressive")->histogram(Decision::ISSUE_ORDER).record(1000 * (job + 1));
+        }
+        if (shard != shards - 1)
+        {
+            TournamentResults::writeLatencies(file);
+        }
+    }
+
+    DecisionProfiler::reset();
+    TournamentResults merged;
+    std::string error;
+    if (TournamentResults::mergeShards(files, merged, error))
+    {
+        merged.writeLog(std::cout);
+    }
+
+    const bool repeated = TournamentResults::mergeShards({files[0], files[0]}, merged, error);
+    std::cout << "Merging shard 0 twice " << (repeated ? "succeeded" : "failed: " + error) << "\n";
+
+    // Shard 0 played again with another seed
+    TournamentResults reseeded = tournament;
+    reseeded.seed++;
+    {
+        std::ofstream file(files[0]);
+        reseeded.writeShardHeader(file, 0, shards);
+    }
+    const bool mixed = TournamentResults::mergeShards({files[1], files[0]}, merged, error);
+    std::cout << "Merging shard 0 played with another seed " << (mixed ? "succeeded" : "failed: " + error) << "\n";
+
+    for (const std::string &file : files)
+    {
+        std::remove(file.c_str());
+    }
+}
+
+/**
+ * Demonstrates a tournament checkpoint cut short by a crash and resumed.
+ *
+ * A tournament of two maps of two games checkpoints two games, then crashes while writing the third. Resumed from
+ * its checkpoint, it keeps its seed and the two games, ignores the torn line, and has two games left to play with the
+ * seeds they had before the crash. The checkpoint of a tournament with other settings cannot be resumed.
+ */
+void testTournamentCheckpoint()
+{
+    // A file of its own, so that the checkpoint of a real tournament is left alone
+    const std::string path = "test_tournament_checkpoint.txt";
+    TournamentResults crashed({"Aden.map", "Roman Empire.map"}, {"Aggressive", "Benevolent"}, 2, 20);
+    crashed.seed = 2024;
+    for (int job = 0; job < 2; ++job)
+    {
+        GameRecord record;
+        record.map = job / crashed.numGames;
+        record.game = job % crashed.numGames;
+        record.turns = 20;
+        record.winner = "Draw";
+        crashed.add(record);
+    }
+    crashed.writeCheckpoint(path, 0, 1);
+    {
+        std::ofstream torn(path, std::ios::app);
+        torn << "game\t1\t0\t1";
+    }
+
+    TournamentResults resumed({"Aden.map", "Roman Empire.map"}, {"Aggressive", "Benevolent"}, 2, 20);
+    std::string error;
+    if (!resumed.resume(path, 0, 1, error))
+    {
+        std::cout << "Cannot resume: " << error << "\n";
+    }
+    std::cout << "Resumed with seed " << resumed.seed << " and " << resumed.getGames().size() << " games, jobs left:";
+    for (int job = 0; job < resumed.jobCount(); ++job)
+    {
+        if (resumed.find(job / resumed.numGames, job % resumed.numGames) == nullptr)
+        {
+            std::cout << " " << job << " (seed " << resumed.gameSeed(job)
+                      << (resumed.gameSeed(job) == crashed.gameSeed(job) ? ", as before the crash)" : ", changed)");
+        }
+    }
+    std::cout << "\n";
+
+    TournamentResults other({"Aden.map"}, {"Aggressive", "Benevolent"}, 2, 20);
+    const bool resumedOther = other.resume(path, 0, 1, error);
+    std::cout << "Resuming another tournament " << (resumedOther ? "succeeded" : "failed: " + error) << "\n";
+    std::remove(path.c_str());
+}
+
+/**
+ * Demonstrates the statistics of a tournament by strategy and by pair of strategies.
+ *
+ * Twenty games between an aggressive, a benevolent and a cheater player: the cheater wins twelve of them, the
+ * aggressive player three, and five are cut off with the territories split between the players left. The statistics
+ * are written as CSV and JSON, and the Wilson interval of a few win rates is shown against the plain win rate.
+ */
+void testTournamentStatistics()
+{
+    const std::vector<std::string> strategies = {"Aggressive", "Benevolent", "Cheater"};
+    TournamentStatistics statistics;
+    for (int game = 0; game < 20; ++game)
+    {
+        GameRecord record;
+        record.game = game;
+        if (game < 12)
+        {
+            record.winner = "Cheater0";
+            record.turns = 8 + game % 3;
+            record.territoryShares["Cheater0"] = 1;
+        }
+        else if (game < 15)
+        {
+            record.winner = "Aggressive0";
+            record.turns = 30;
+            record.territoryShares["Aggressive0"] = 1;
+        }
+        else
+        {
+            record.winner = "Draw";
+            record.turns = 50;
+            record.territoryShares["Aggressive0"] = 0.25;
+            record.territoryShares["Cheater0"] = 0.75;
+        }
+        statistics.addGame(strategies, record);
+    }
+
+    statistics.writeStrategiesCsv(std::cout);
+    statistics.writeHeadToHeadCsv(std::cout);
+    statistics.writeJson(std::cout);
+
+    const int outcomes[][2] = {{0, 5}, {5, 10}, {50, 100}, {5000, 10000}};
+    for (const auto &outcome : outcomes)
+    {
+        double low, high;
+        TournamentStatistics::wilsonInterval(outcome[0], outcome[1], low, high);
+        std::cout << outcome[0] << " wins in " << outcome[1] << " games: " << static_cast<double>(outcome[0]) / outcome[1]
+                  << " in [" << low << ", " << high << "]\n";
+    }
+}
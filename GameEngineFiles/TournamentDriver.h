@@ -10,4 +10,24 @@
  */
 void testTournament(int argc, char *argv[]);
 
+/**
+ * Demonstrates the work-stealing scheduler and the cost model of parallel tournaments.
+ */
+void testTournamentScheduler();
+
+/**
+ * Demonstrates a tournament split in shards and merged back into its tournament log.
+ */
+void testTournamentShards();
+
+/**
+ * Demonstrates a tournament checkpoint cut short by a crash and resumed.
+ */
+void testTournamentCheckpoint();
+
+/**
+ * Demonstrates the statistics of a tournament by strategy and by pair of strategies.
+ */
+void testTournamentStatistics();
+
 #endif
\ No newline at end of file
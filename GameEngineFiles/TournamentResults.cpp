@@ -0,0 +1,553 @@
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <ostream>
+#include <set>
+#include <sstream>
+#include <utility>
+#include "TournamentResults.h"
+#include "PlayerFiles/DecisionProfiler.h"
+
+namespace
+{
+    /**
+     * @brief Splits a line of a shard file into its tab separated fields.
+     */
+    std::vector<std::string> splitFields(const std::string &line)
+    {
+        std::vector<std::string> fields;
+        std::stringstream stream(line);
+        std::string field;
+        while (std::getline(stream, field, '\t'))
+        {
+            fields.push_back(field);
+        }
+        if (!line.empty() && line.back() == '\t')
+        {
+            fields.push_back("");
+        }
+        return fields;
+    }
+
+    /**
+     * @brief The splitmix64 finalizer, a bijective hash of 64 bits.
+     */
+    std::uint64_t mix(std::uint64_t z)
+    {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @brief Writes a list on one line, separated by the given separator.
+     */
+    void writeList(std::ostream &out, const std::vector<std::string> &items, const char *separator)
+    {
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            out << (i == 0 ? "" : separator) << items[i];
+        }
+    }
+}
+
+TournamentResults::TournamentResults(const std::vector<std::string> &maps, const std::vector<std::string> &strategies,
+                                     int numGames, int maxTurns)
+    : maps(maps), strategies(strategies), numGames(numGames), maxTurns(maxTurns)
+{
+}
+
+/**
+ * @return The number of games of the whole tournament.
+ */
+int TournamentResults::jobCount() const
+{
+    return static_cast<int>(maps.size()) * numGames;
+}
+
+/**
+ * @param shard The index of a shard, from 0.
+ * @param shards The number of shards.
+ * @return The jobs of the shard, in increasing order.
+ */
+std::vector<int> TournamentResults::shardJobs(int shard, int shards) const
+{
+    std::vector<int> jobs;
+    for (int job = 0; job < jobCount(); ++job)
+    {
+        if (job % shards == shard)
+        {
+            jobs.push_back(job);
+        }
+    }
+    return jobs;
+}
+
+/**
+ * @param job The number of a game of the tournament.
+ * @return The seed of the game, a hash of the seed of the tournament and of the job.
+ */
+std::uint64_t TournamentResults::gameSeed(int job) const
+{
+    return mix(seed ^ mix(static_cast<std::uint64_t>(job) + 1));
+}
+
+/**
+ * @return The games played so far, in the order they were added.
+ */
+const std::vector<GameRecord> &TournamentResults::getGames() const
+{
+    return games;
+}
+
+/**
+ * @brief Adds a game played, indexed by its job.
+ *
+ * @param record The outcome of the game.
+ * @return false if the game is not a game of the tournament or was already added.
+ */
+bool TournamentResults::add(const GameRecord &record)
+{
+    if (record.map < 0 || record.map >= static_cast<int>(maps.size()) || record.game < 0 || record.game >= numGames)
+    {
+        return false;
+    }
+
+    gameIndex.resize(jobCount(), -1);
+    int &position = gameIndex[record.map * numGames + record.game];
+    if (position >= 0)
+    {
+        return false;
+    }
+    position = static_cast<int>(games.size());
+    games.push_back(record);
+    return true;
+}
+
+/**
+ * @param map The index of a map.
+ * @param game The index of a game on the map.
+ * @return The record of the game, nullptr if it was not played.
+ */
+const GameRecord *TournamentResults::find(int map, int game) const
+{
+    if (map < 0 || map >= static_cast<int>(maps.size()) || game < 0 || game >= numGames)
+    {
+        return nullptr;
+    }
+
+    const std::size_t job = static_cast<std::size_t>(map * numGames + game);
+    return job < gameIndex.size() && gameIndex[job] >= 0 ? &games[gameIndex[job]] : nullptr;
+}
+
+/**
+ * @brief Writes the tournament log. Games that were not played, such as the games of a missing shard, are logged
+ * as "Not Played".
+ *
+ * @param out The stream to write to.
+ */
+void TournamentResults::writeLog(std::ostream &out) const
+{
+    // Write the initial "Tournament mode" header, then the maps, the strategies, the number of games and the
+    // maximum number of turns allowed
+    out << "--- Tournament mode ---\n";
+    out << "M: ";
+    writeList(out, maps, ", ");
+    out << "\nP: ";
+    writeList(out, strategies, ", ");
+    out << "\nG: " << numGames << "\nD: " << maxTurns << "\n";
+
+    // The result of every game of every map
+    std::vector<std::string> earlyDraws;
+    int totalTurns = 0;
+    int notPlayed = 0;
+    out << "Results:\n";
+    for (int map = 0; map < static_cast<int>(maps.size()); ++map)
+    {
+        out << "Map " << (map + 1) << ": ";
+        for (int game = 0; game < numGames; ++game)
+        {
+            const GameRecord *record = find(map, game);
+            out << (record == nullptr ? "Not Played" : record->winner);
+            if (game != numGames - 1)
+            {
+                out << ", ";
+            }
+
+            if (record == nullptr)
+            {
+                notPlayed++;
+                continue;
+            }
+            totalTurns += record->turns;
+            if (!record->stalemate.empty())
+            {
+                earlyDraws.push_back("Map " + std::to_string(map + 1) + " game " + std::to_string(game + 1) +
+                                     ": draw after " + std::to_string(record->turns) + " turns, " + record->stalemate);
+            }
+        }
+        out << "\n";
+    }
+
+    // The games that ended early and how many turns were simulated
+    for (const std::string &earlyDraw : earlyDraws)
+    {
+        out << earlyDraw << "\n";
+    }
+    if (notPlayed > 0)
+    {
+        out << "Games not played: " << notPlayed << "\n";
+    }
+    out << "Turns simulated: " << totalTurns << "\n";
+
+    // How long every strategy took to decide
+    DecisionProfiler::report(out);
+
+    out << "--- End of Tournament ---\n\n";
+}
+
+/**
+ * @brief Writes the first lines of a shard file: the shard and the settings of the tournament.
+ *
+ * @param out The stream to write to.
+ * @param shard The index of the shard, from 0.
+ * @param shards The number of shards.
+ */
+void TournamentResults::writeShardHeader(std::ostream &out, int shard, int shards) const
+{
+    out << "shard\t" << shard << '\t' << shards << "\nmaps\t";
+    writeList(out, maps, "\t");
+    out << "\nstrategies\t";
+    writeList(out, strategies, "\t");
+    out << "\ngames\t" << numGames << "\nturns\t" << maxTurns << "\nseed\t" << seed << "\n";
+}
+
+/**
+ * @brief Writes the settings of the tournament and the games played so far to a temporary file, then moves it over
+ * the checkpoint file.
+ *
+ * @param path The checkpoint file.
+ * @param shard The index of the shard of the checkpoint, from 0.
+ * @param shards The number of shards.
+ * @return true if the file was written.
+ */
+bool TournamentResults::writeCheckpoint(const std::string &path, int shard, int shards) const
+{
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary);
+        writeShardHeader(out, shard, shards);
+        for (const GameRecord &record : games)
+        {
+            writeGame(out, record);
+        }
+        if (!out.flush())
+        {
+            return false;
+        }
+    }
+
+    // Renaming over an existing file fails on some systems, which then need it removed first
+    if (std::rename(temporary.c_str(), path.c_str()) == 0)
+    {
+        return true;
+    }
+    std::remove(path.c_str());
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+/**
+ * @brief Writes the line of a game to a shard file.
+ */
+void TournamentResults::writeGame(std::ostream &out, const GameRecord &record)
+{
+    out << "game\t" << record.map << '\t' << record.game << '\t' << record.turns << '\t' << record.winner << '\t'
+        << record.stalemate << '\t';
+    for (auto share = record.territoryShares.begin(); share != record.territoryShares.end(); ++share)
+    {
+        out << (share == record.territoryShares.begin() ? "" : ",") << share->first << ':' << share->second;
+    }
+    out << "\n";
+}
+
+/**
+ * @brief Writes the histograms of the DecisionProfiler to a shard file, followed by the line that marks the shard
+ * as complete.
+ */
+void TournamentResults::writeLatencies(std::ostream &out)
+{
+    for (const std::string &strategy : DecisionProfiler::strategies())
+    {
+        DecisionProfile *profile = DecisionProfiler::profile(strategy);
+        for (int decision = 0; decision < DECISION_COUNT; ++decision)
+        {
+            const LatencyHistogram &histogram = profile->histogram(static_cast<Decision>(decision));
+            if (histogram.count() > 0)
+            {
+                out << "latency\t" << strategy << '\t' << decisionName(static_cast<Decision>(decision)) << '\t';
+                histogram.write(out);
+                out << "\n";
+            }
+        }
+    }
+    out << "end\n";
+}
+
+/**
+ * @param shard The index of a shard, from 0.
+ * @param shards The number of shards.
+ * @return The name of the file of the shard.
+ */
+std::string TournamentResults::shardFileName(int shard, int shards)
+{
+    return "tournament_shard_" + std::to_string(shard) + "_of_" + std::to_string(shards) + ".txt";
+}
+
+/**
+ * @param shard The index of a shard, from 0.
+ * @param shards The number of shards, 1 for a tournament played by a single process.
+ * @return The name of the checkpoint file of the shard.
+ */
+std::string TournamentResults::checkpointFileName(int shard, int shards)
+{
+    return shards > 1 ? shardFileName(shard, shards) : "tournament_checkpoint.txt";
+}
+
+/**
+ * @brief Resumes the tournament from its checkpoint: takes the seed and the games of the checkpoint, and adds its
+ * histograms to the DecisionProfiler.
+ *
+ * @param path The checkpoint file.
+ * @param shard The index of the shard of the checkpoint, from 0.
+ * @param shards The number of shards.
+ * @param error Receives why the tournament could not be resumed.
+ * @return false if the file could not be read, or is the checkpoint of another tournament or shard.
+ */
+bool TournamentResults::resume(const std::string &path, int shard, int shards, std::string &error)
+{
+    std::ifstream in(path);
+    TournamentResults checkpoint;
+    std::vector<GameRecord> records;
+    int checkpointShard = 0;
+    int checkpointShards = 0;
+    std::vector<std::string> latencies;
+    if (!in || !readShard(in, checkpoint, records, checkpointShard, checkpointShards, latencies))
+    {
+        error = path + " is not a tournament checkpoint";
+        return false;
+    }
+    if (checkpoint.maps != maps || checkpoint.strategies != strategies || checkpoint.numGames != numGames ||
+        checkpoint.maxTurns != maxTurns || checkpointShard != shard || checkpointShards != shards)
+    {
+        error = path + " is the checkpoint of another tournament";
+        return false;
+    }
+
+    // A game repeated or out of the tournament is ignored
+    seed = checkpoint.seed;
+    games.clear();
+    gameIndex.clear();
+    for (const GameRecord &record : records)
+    {
+        add(record);
+    }
+    addLatencies(latencies);
+    return true;
+}
+
+/**
+ * @brief Reads a shard file. A shard that was not played to the end has no "end" line, its games are still read, and
+ * a last line cut short by a crash is ignored.
+ *
+ * @param in The stream to read from.
+ * @param results Receives the settings of the shard.
+ * @param records Receives the games of the shard, as read.
+ * @param shard Receives the index of the shard.
+ * @param shards Receives the number of shards.
+ * @param latencies Receives the latency lines of the shard, without their tag.
+ * @return false if the stream is not a shard file.
+ */
+bool TournamentResults::readShard(std::istream &in, TournamentResults &results, std::vector<GameRecord> &records,
+                                  int &shard, int &shards, std::vector<std::string> &latencies)
+{
+    shard = -1;
+    shards = 0;
+    std::string line;
+    try
+    {
+        while (std::getline(in, line))
+        {
+            // Every line is written with its end of line, a last line without it was cut short by a crash
+            if (in.eof())
+            {
+                break;
+            }
+
+            std::vector<std::string> fields = splitFields(line);
+            if (fields.empty())
+            {
+                continue;
+            }
+
+            const std::string &tag = fields[0];
+            if (tag == "shard" && fields.size() == 3)
+            {
+                shard = std::stoi(fields[1]);
+                shards = std::stoi(fields[2]);
+            }
+            else if (tag == "maps")
+            {
+                results.maps.assign(fields.begin() + 1, fields.end());
+            }
+            else if (tag == "strategies")
+            {
+                results.strategies.assign(fields.begin() + 1, fields.end());
+            }
+            else if (tag == "games" && fields.size() == 2)
+            {
+                results.numGames = std::stoi(fields[1]);
+            }
+            else if (tag == "turns" && fields.size() == 2)
+            {
+                results.maxTurns = std::stoi(fields[1]);
+            }
+            else if (tag == "seed" && fields.size() == 2)
+            {
+                results.seed = std::stoull(fields[1]);
+            }
+            else if (tag == "game" && (fields.size() == 6 || fields.size() == 7))
+            {
+                GameRecord record;
+                record.map = std::stoi(fields[1]);
+                record.game = std::stoi(fields[2]);
+                record.turns = std::stoi(fields[3]);
+                record.winner = fields[4];
+                record.stalemate = fields[5];
+                if (fields.size() == 7)
+                {
+                    std::stringstream shares(fields[6]);
+                    std::string share;
+                    while (std::getline(shares, share, ','))
+                    {
+                        const std::size_t colon = share.rfind(':');
+                        if (colon == std::string::npos)
+                        {
+                            return false;
+                        }
+                        record.territoryShares[share.substr(0, colon)] = std::stod(share.substr(colon + 1));
+                    }
+                }
+                records.push_back(record);
+            }
+            else if (tag == "latency")
+            {
+                latencies.push_back(line.substr(tag.size() + 1));
+            }
+            else if (tag == "end")
+            {
+                break;
+            }
+            else
+            {
+                return false;
+            }
+        }
+    }
+    catch (const std::exception &)
+    {
+        return false;
+    }
+
+    return shard >= 0 && shard < shards && !results.maps.empty() && results.numGames > 0;
+}
+
+/**
+ * @brief Merges shard files into one tournament. Their histograms are added to the DecisionProfiler.
+ *
+ * @param files The shard files, all of the same tournament.
+ * @param merged Receives the merged tournament.
+ * @param error Receives why the files could not be merged.
+ * @return false if a file could not be read, is not a shard file, or belongs to another tournament or seed.
+ */
+bool TournamentResults::mergeShards(const std::vector<std::string> &files, TournamentResults &merged, std::string &error)
+{
+    std::vector<std::string> latencies;
+    std::set<int> shardsSeen;
+    int shardCount = 0;
+    if (files.empty())
+    {
+        error = "no shard to merge";
+        return false;
+    }
+
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+        std::ifstream in(files[i]);
+        TournamentResults shard;
+        std::vector<GameRecord> records;
+        int index = 0;
+        int shards = 0;
+        if (!in || !readShard(in, shard, records, index, shards, latencies))
+        {
+            error = files[i] + " is not a tournament shard";
+            return false;
+        }
+
+        if (i == 0)
+        {
+            merged = TournamentResults(shard.maps, shard.strategies, shard.numGames, shard.maxTurns);
+            merged.seed = shard.seed;
+            shardCount = shards;
+        }
+        else if (shard.maps != merged.maps || shard.strategies != merged.strategies ||
+                 shard.numGames != merged.numGames || shard.maxTurns != merged.maxTurns || shards != shardCount)
+        {
+            error = files[i] + " is a shard of another tournament";
+            return false;
+        }
+        else if (shard.seed != merged.seed)
+        {
+            error = files[i] + " was played with seed " + std::to_string(shard.seed) + " instead of " +
+                    std::to_string(merged.seed);
+            return false;
+        }
+        if (!shardsSeen.insert(index).second)
+        {
+            error = files[i] + " repeats shard " + std::to_string(index);
+            return false;
+        }
+
+        for (const GameRecord &record : records)
+        {
+            if (!merged.add(record))
+            {
+                error = files[i] + " has an unexpected game";
+                return false;
+            }
+        }
+    }
+
+    // Only add the histograms once every file is known to be valid
+    addLatencies(latencies);
+    return true;
+}
+
+/**
+ * @brief Adds the latency lines of shard files to the histograms of the DecisionProfiler.
+ *
+ * @param latencies The latency lines, without their tag.
+ */
+void TournamentResults::addLatencies(const std::vector<std::string> &latencies)
+{
+    for (const std::string &latency : latencies)
+    {
+        std::stringstream stream(latency);
+        std::string strategy, decisionText;
+        Decision decision;
+        if (std::getline(stream, strategy, '\t') && std::getline(stream, decisionText, '\t') &&
+            parseDecision(decisionText, decision))
+        {
+            DecisionProfiler::profile(strategy)->histogram(decision).read(stream);
+        }
+    }
+}
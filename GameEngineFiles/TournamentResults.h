@@ -0,0 +1,188 @@
+#ifndef TOURNAMENT_RESULTS_H
+#define TOURNAMENT_RESULTS_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The outcome of one game of a tournament.
+ */
+struct GameRecord
+{
+    int map = 0;           ///< The index of the map of the game.
+    int game = 0;          ///< The index of the game on its map.
+    std::string winner;    ///< The name of the winner, "Draw" or "Invalid Map".
+    int turns = 0;         ///< The number of turns played.
+    std::string stalemate; ///< Why the game ended early as a draw, empty if it did not.
+    std::map<std::string, double> territoryShares; ///< The share of the territories of every player left at the end.
+};
+
+/**
+ * @brief The settings of a tournament and the outcome of the games played so far.
+ *
+ * A whole tournament is written as the tournament log. While it is played, a tournament is checkpointed to a file:
+ * its settings and seed, then one line per game, appended as soon as the game is over so a crash only loses the
+ * games being played, then the latency histograms once it is complete. A tournament resumed from its checkpoint only
+ * plays the games missing from it. A shard of a tournament, played by its own process, keeps its checkpoint as its
+ * shard file, and the shard files of the same tournament merge back into its tournament log.
+ *
+ * The games of a tournament are numbered map by map, the game g of the map m being the job m * games + g. A shard
+ * i out of n plays the jobs whose number is i modulo n. Every job is played with its own seed derived from the seed
+ * of the tournament, so a resumed tournament plays its remaining games as they would have been played.
+ */
+class TournamentResults
+{
+public:
+    std::vector<std::string> maps;
+    std::vector<std::string> strategies;
+    int numGames = 0;
+    int maxTurns = 0;
+    std::uint64_t seed = 0; ///< The seed of the tournament, the seeds of its games derive from it.
+
+    TournamentResults() = default;
+    TournamentResults(const std::vector<std::string> &maps, const std::vector<std::string> &strategies, int numGames,
+                      int maxTurns);
+
+    /**
+     * @return The number of games of the whole tournament.
+     */
+    int jobCount() const;
+
+    /**
+     * @param shard The index of a shard, from 0.
+     * @param shards The number of shards.
+     * @return The jobs of the shard, in increasing order.
+     */
+    std::vector<int> shardJobs(int shard, int shards) const;
+
+    /**
+     * @param job The number of a game of the tournament.
+     * @return The seed of the game.
+     */
+    std::uint64_t gameSeed(int job) const;
+
+    /**
+     * @return The games played so far, in the order they were added.
+     */
+    const std::vector<GameRecord> &getGames() const;
+
+    /**
+     * @brief Adds a game played, the maps and the number of games of the tournament being set.
+     *
+     * @param record The outcome of the game.
+     * @return false if the game is not a game of the tournament or was already added.
+     */
+    bool add(const GameRecord &record);
+
+    /**
+     * @param map The index of a map.
+     * @param game The index of a game on the map.
+     * @return The record of the game, nullptr if it was not played.
+     */
+    const GameRecord *find(int map, int game) const;
+
+    /**
+     * @brief Writes the tournament log: the settings, the winner of every game, the games that ended early, the
+     * number of turns simulated and the latency of the decisions recorded by the DecisionProfiler.
+     *
+     * @param out The stream to write to.
+     */
+    void writeLog(std::ostream &out) const;
+
+    /**
+     * @brief Resumes the tournament from its checkpoint: takes the seed and the games of the checkpoint, and adds
+     * its histograms to the DecisionProfiler. A game cut short by a crash is ignored.
+     *
+     * @param path The checkpoint file.
+     * @param shard The index of the shard of the checkpoint, from 0.
+     * @param shards The number of shards.
+     * @param error Receives why the tournament could not be resumed.
+     * @return false if the file could not be read, or is the checkpoint of another tournament or shard.
+     */
+    bool resume(const std::string &path, int shard, int shards, std::string &error);
+
+    /**
+     * @brief Writes the settings of the tournament and the games played so far to a checkpoint file. The file is
+     * replaced at once, a crash leaves either the previous checkpoint or the new one.
+     *
+     * @param path The checkpoint file.
+     * @param shard The index of the shard of the checkpoint, from 0.
+     * @param shards The number of shards.
+     * @return true if the file was written.
+     */
+    bool writeCheckpoint(const std::string &path, int shard, int shards) const;
+
+    /**
+     * @brief Writes the first lines of a shard file: the shard and the settings of the tournament.
+     *
+     * @param out The stream to write to.
+     * @param shard The index of the shard, from 0.
+     * @param shards The number of shards.
+     */
+    void writeShardHeader(std::ostream &out, int shard, int shards) const;
+
+    /**
+     * @brief Writes the line of a game to a shard file.
+     */
+    static void writeGame(std::ostream &out, const GameRecord &record);
+
+    /**
+     * @brief Writes the histograms of the DecisionProfiler to a shard file, which completes it.
+     */
+    static void writeLatencies(std::ostream &out);
+
+    /**
+     * @param shard The index of a shard, from 0.
+     * @param shards The number of shards.
+     * @return The name of the file of the shard.
+     */
+    static std::string shardFileName(int shard, int shards);
+
+    /**
+     * @param shard The index of a shard, from 0.
+     * @param shards The number of shards, 1 for a tournament played by a single process.
+     * @return The name of the checkpoint file of the shard, its shard file if the tournament is sharded.
+     */
+    static std::string checkpointFileName(int shard, int shards);
+
+    /**
+     * @brief Merges shard files into one tournament. Their histograms are added to the DecisionProfiler.
+     *
+     * @param files The shard files, all of the same tournament played with the same seed, so that no game is
+     * played twice with different seeds.
+     * @param merged Receives the merged tournament.
+     * @param error Receives why the files could not be merged.
+     * @return false if a file could not be read, is not a shard file, or belongs to another tournament or seed.
+     */
+    static bool mergeShards(const std::vector<std::string> &files, TournamentResults &merged, std::string &error);
+
+private:
+    std::vector<GameRecord> games; ///< The games played so far, in the order they were added.
+    std::vector<int> gameIndex;    ///< The position in games of the game of every job, -1 if it was not played.
+
+    /**
+     * @brief Reads a shard file. A last line cut short by a crash is ignored.
+     *
+     * @param in The stream to read from.
+     * @param results Receives the settings of the shard.
+     * @param records Receives the games of the shard, as read.
+     * @param shard Receives the index of the shard.
+     * @param shards Receives the number of shards.
+     * @param latencies Receives the latency lines of the shard, without their tag.
+     * @return false if the stream is not a shard file.
+     */
+    static bool readShard(std::istream &in, TournamentResults &results, std::vector<GameRecord> &records, int &shard,
+                          int &shards, std::vector<std::string> &latencies);
+
+    /**
+     * @brief Adds the latency lines of shard files to the histograms of the DecisionProfiler.
+     *
+     * @param latencies The latency lines, without their tag.
+     */
+    static void addLatencies(const std::vector<std::string> &latencies);
+};
+
+#endif
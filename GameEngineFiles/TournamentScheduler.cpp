@@ -0,0 +1,303 @@
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+#include "TournamentScheduler.h"
+
+const int TournamentCostModel::MAX_SAMPLES;
+
+// ---------------------- TournamentCostModel Class Implementation ----------------------
+
+/**
+ * @brief Reads the costs recorded in a file, a missing file holds no costs. Malformed lines are skipped.
+ *
+ * @param path The path of the file.
+ */
+void TournamentCostModel::load(const std::string &path)
+{
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::stringstream fields(line);
+        std::string cost, samples, mix, map;
+        if (!std::getline(fields, cost, '\t') || !std::getline(fields, samples, '\t') ||
+            !std::getline(fields, mix, '\t') || !std::getline(fields, map))
+        {
+            continue;
+        }
+
+        try
+        {
+            costs[std::make_pair(mix, map)] = std::make_pair(std::stod(cost), std::max(1, std::min(MAX_SAMPLES, std::stoi(samples))));
+        }
+        catch (const std::exception &)
+        {
+            continue;
+        }
+    }
+}
+
+/**
+ * @brief Writes every cost to a temporary file of this process, merged with the costs the file holds for the games
+ * this model has none of, then moves it over the file.
+ *
+ * @param path The path of the file.
+ * @return true if the file was written.
+ */
+bool TournamentCostModel::save(const std::string &path) const
+{
+    TournamentCostModel merged;
+    merged.load(path);
+    for (const auto &entry : costs)
+    {
+        merged.costs[entry.first] = entry.second;
+    }
+
+    // Shards of a tournament save the same file, each through a temporary file of its own
+    const std::string temporary = path + "." + std::to_string(std::random_device()()) + ".tmp";
+    {
+        std::ofstream file(temporary);
+        for (const auto &entry : merged.costs)
+        {
+            file << entry.second.first << '\t' << entry.second.second << '\t' << entry.first.first << '\t'
+                 << entry.first.second << '\n';
+        }
+        if (!file.flush())
+        {
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+
+    // Renaming over an existing file fails on some systems, which then need it removed first
+    if (std::rename(temporary.c_str(), path.c_str()) == 0)
+    {
+        return true;
+    }
+    std::remove(path.c_str());
+    if (std::rename(temporary.c_str(), path.c_str()) == 0)
+    {
+        return true;
+    }
+    std::remove(temporary.c_str());
+    return false;
+}
+
+/**
+ * @param map The map file of a game.
+ * @param strategies The strategies of the game, in any order.
+ * @return The recorded cost of the game, or the largest recorded cost if the game was never played, 1 if nothing
+ * was ever recorded.
+ */
+double TournamentCostModel::expectedCost(const std::string &map, const std::vector<std::string> &strategies) const
+{
+    auto found = costs.find(std::make_pair(strategyMix(strategies), map));
+    if (found != costs.end())
+    {
+        return found->second.first;
+    }
+
+    double largest = 0;
+    for (const auto &entry : costs)
+    {
+        largest = std::max(largest, entry.second.first);
+    }
+    return largest > 0 ? largest : 1;
+}
+
+/**
+ * @brief Records how long a game took, averaged with the last MAX_SAMPLES - 1 recorded games of the same kind.
+ *
+ * @param map The map file of the game.
+ * @param strategies The strategies of the game, in any order.
+ * @param milliseconds The wall clock time of the game.
+ */
+void TournamentCostModel::record(const std::string &map, const std::vector<std::string> &strategies, double milliseconds)
+{
+    std::pair<double, int> &cost = costs[std::make_pair(strategyMix(strategies), map)];
+    const int samples = std::min(cost.second, MAX_SAMPLES - 1);
+    cost.first = (cost.first * samples + milliseconds) / (samples + 1);
+    cost.second = samples + 1;
+}
+
+/**
+ * @return The strategies sorted and joined by commas.
+ */
+std::string TournamentCostModel::strategyMix(const std::vector<std::string> &strategies)
+{
+    std::vector<std::string> sorted(strategies);
+    std::sort(sorted.begin(), sorted.end());
+
+    std::string mix;
+    for (const std::string &strategy : sorted)
+    {
+        mix += (mix.empty() ? "" : ",") + strategy;
+    }
+    return mix;
+}
+
+// ---------------------- WorkStealingScheduler Class Implementation ----------------------
+
+namespace
+{
+    /**
+     * @brief The jobs dealt to a worker, most expensive first, and their total cost.
+     */
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<int> jobs;
+        double queuedCost = 0;
+    };
+}
+
+/**
+ * @param threads The number of worker threads, 0 for one per hardware thread.
+ */
+WorkStealingScheduler::WorkStealingScheduler(int threads)
+    : threads(threads > 0 ? threads : std::max(1, static_cast<int>(std::thread::hardware_concurrency())))
+{
+}
+
+int WorkStealingScheduler::getThreads() const
+{
+    return threads;
+}
+
+/**
+ * @param costs The expected cost of every job.
+ * @return The indexes of the jobs from the most to the least expensive, in index order on ties.
+ */
+std::vector<int> WorkStealingScheduler::costOrder(const std::vector<double> &costs)
+{
+    std::vector<int> order(costs.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        order[i] = static_cast<int>(i);
+    }
+    std::stable_sort(order.begin(), order.end(), [&costs](int a, int b)
+                     { return costs[a] > costs[b]; });
+    return order;
+}
+
+/**
+ * @brief Runs every job once and returns when they are all done.
+ *
+ * @param costs The expected cost of every job.
+ * @param task Runs a job, given the index of the job and of the worker running it.
+ * @return What the workers did.
+ */
+WorkStealingScheduler::Statistics WorkStealingScheduler::run(const std::vector<double> &costs,
+                                                             const std::function<void(int job, int worker)> &task) const
+{
+    const int workers = std::max(1, std::min(threads, static_cast<int>(costs.size())));
+    Statistics statistics;
+    statistics.threads = workers;
+    statistics.jobsRun.assign(workers, 0);
+
+    // Deal the jobs from the most expensive, each deque stays sorted by cost
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    for (int worker = 0; worker < workers; ++worker)
+    {
+        queues.emplace_back(new WorkerQueue());
+    }
+    std::vector<int> owners(costs.size());
+    const std::vector<int> order = costOrder(costs);
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        WorkerQueue &queue = *queues[i % workers];
+        queue.jobs.push_back(order[i]);
+        queue.queuedCost += costs[order[i]];
+        owners[order[i]] = static_cast<int>(i % workers);
+    }
+
+    std::mutex statisticsMutex;
+    std::exception_ptr failure;
+
+    // Takes the most expensive job of a queue, -1 if it is empty
+    auto take = [&](WorkerQueue &queue)
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty())
+        {
+            return -1;
+        }
+        const int job = queue.jobs.front();
+        queue.jobs.pop_front();
+        queue.queuedCost -= costs[job];
+        return job;
+    };
+
+    auto work = [&](int worker)
+    {
+        while (true)
+        {
+            int job = take(*queues[worker]);
+
+            // Steal from the worker with the most queued cost, no job is ever queued again once they are all gone
+            while (job < 0)
+            {
+                int victim = -1;
+                double victimCost = 0;
+                for (int other = 0; other < workers; ++other)
+                {
+                    std::lock_guard<std::mutex> lock(queues[other]->mutex);
+                    if (!queues[other]->jobs.empty() && (victim < 0 || queues[other]->queuedCost > victimCost))
+                    {
+                        victim = other;
+                        victimCost = queues[other]->queuedCost;
+                    }
+                }
+                if (victim < 0)
+                {
+                    return;
+                }
+                job = take(*queues[victim]);
+            }
+
+            try
+            {
+                task(job, worker);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(statisticsMutex);
+                if (!failure)
+                {
+                    failure = std::current_exception();
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(statisticsMutex);
+            statistics.jobsRun[worker]++;
+            if (owners[job] != worker)
+            {
+                statistics.steals++;
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int worker = 1; worker < workers; ++worker)
+    {
+        pool.emplace_back(work, worker);
+    }
+    work(0);
+    for (std::thread &thread : pool)
+    {
+        thread.join();
+    }
+
+    if (failure)
+    {
+        std::rethrow_exception(failure);
+    }
+    return statistics;
+}
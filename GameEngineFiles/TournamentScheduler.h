@@ -0,0 +1,121 @@
+#ifndef TOURNAMENT_SCHEDULER_H
+#define TOURNAMENT_SCHEDULER_H
+
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief How long tournament games took in previous runs, by map and strategy mix.
+ *
+ * Costs are wall clock milliseconds averaged over the last runs, so that a map that got faster or slower is
+ * noticed after a few tournaments. They are kept in a text file next to the tournament log, one line per map and
+ * strategy mix: the cost, the number of samples it averages, the strategy mix and the map, separated by tabs.
+ */
+class TournamentCostModel
+{
+public:
+    /**
+     * @brief Averages no more than that many samples, so old runs fade out.
+     */
+    static const int MAX_SAMPLES = 8;
+
+    /**
+     * @brief Reads the costs recorded in a file, a missing file holds no costs.
+     *
+     * @param path The path of the file.
+     */
+    void load(const std::string &path);
+
+    /**
+     * @brief Writes every cost to a file, keeping the costs the file holds for the games this model has none of,
+     * such as the games recorded in the meantime by the other shards of a tournament. The file is replaced at once,
+     * so a shard reading it never sees it half written.
+     *
+     * @param path The path of the file.
+     * @return true if the file was written.
+     */
+    bool save(const std::string &path) const;
+
+    /**
+     * @param map The map file of a game.
+     * @param strategies The strategies of the game, in any order.
+     * @return The expected cost of the game: its recorded cost, or the largest recorded cost if the game was never
+     * played, so unknown games start early. 1 if nothing was ever recorded.
+     */
+    double expectedCost(const std::string &map, const std::vector<std::string> &strategies) const;
+
+    /**
+     * @brief Records how long a game took.
+     *
+     * @param map The map file of the game.
+     * @param strategies The strategies of the game, in any order.
+     * @param milliseconds The wall clock time of the game.
+     */
+    void record(const std::string &map, const std::vector<std::string> &strategies, double milliseconds);
+
+    /**
+     * @return The strategies sorted and joined by commas, the same for every order of the same strategies.
+     */
+    static std::string strategyMix(const std::vector<std::string> &strategies);
+
+private:
+    /**
+     * @brief The mean cost and the number of samples it averages, by strategy mix then map.
+     */
+    std::map<std::pair<std::string, std::string>, std::pair<double, int>> costs;
+};
+
+/**
+ * @brief Runs independent jobs of known expected costs on worker threads that steal work from each other.
+ *
+ * The jobs are sorted from the most to the least expensive and dealt to the workers in turn, so every worker starts
+ * with one of the most expensive jobs and owns a deque of jobs sorted by cost. A worker always runs the most
+ * expensive job of its own deque; once it is empty, it steals the most expensive job of the worker with the most
+ * queued cost. Large jobs therefore start first and idle workers take over the queue of a worker stuck on a large
+ * job, which keeps the end of the run from waiting on a single worker.
+ */
+class WorkStealingScheduler
+{
+public:
+    /**
+     * @brief What the workers did during a run.
+     */
+    struct Statistics
+    {
+        int threads = 0;          ///< The number of workers.
+        std::vector<int> jobsRun; ///< The jobs run by every worker.
+        int steals = 0;           ///< The jobs run by another worker than the one they were dealt to.
+    };
+
+    /**
+     * @param threads The number of worker threads, 0 for one per hardware thread. A single worker runs the jobs on
+     * the calling thread.
+     */
+    explicit WorkStealingScheduler(int threads = 0);
+
+    /**
+     * @brief Runs every job once and returns when they are all done. If a job throws, the remaining jobs still run
+     * and the first exception is rethrown at the end.
+     *
+     * @param costs The expected cost of every job.
+     * @param task Runs a job, given the index of the job and of the worker running it.
+     * @return What the workers did.
+     */
+    Statistics run(const std::vector<double> &costs, const std::function<void(int job, int worker)> &task) const;
+
+    /**
+     * @param costs The expected cost of every job.
+     * @return The indexes of the jobs from the most to the least expensive, in index order on ties.
+     */
+    static std::vector<int> costOrder(const std::vector<double> &costs);
+
+    int getThreads() const;
+
+private:
+    int threads;
+};
+
+#endif
@@ -0,0 +1,313 @@
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include "TournamentStatistics.h"
+
+const double TournamentStatistics::WILSON_Z = 1.959963984540054;
+
+namespace
+{
+    /**
+     * @return A number with four decimals, or an empty string if it is not defined.
+     */
+    std::string number(double value, bool defined = true)
+    {
+        if (!defined)
+        {
+            return "";
+        }
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(4) << value;
+        return out.str();
+    }
+
+    /**
+     * @return A CSV field, quoted if it holds a separator, a quote or an end of line.
+     */
+    std::string csvField(const std::string &text)
+    {
+        if (text.find_first_of(",\"\n") == std::string::npos)
+        {
+            return text;
+        }
+        std::string quoted = "\"";
+        for (char c : text)
+        {
+            quoted += c == '"' ? "\"\"" : std::string(1, c);
+        }
+        return quoted + "\"";
+    }
+
+    /**
+     * @return A JSON string.
+     */
+    std::string jsonString(const std::string &text)
+    {
+        std::string quoted = "\"";
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                quoted += '\\';
+            }
+            quoted += static_cast<unsigned char>(c) < 0x20 ? ' ' : c;
+        }
+        return quoted + "\"";
+    }
+
+    /**
+     * @return A JSON number, or null if it is not defined.
+     */
+    std::string jsonNumber(double value, bool defined = true)
+    {
+        return defined ? number(value) : "null";
+    }
+}
+
+/**
+ * @brief Adds a game. A game on an invalid map was not played and is not added.
+ *
+ * @param strategies The strategies of the players of the game, in the order the players were created.
+ * @param record The outcome of the game.
+ */
+void TournamentStatistics::addGame(const std::vector<std::string> &strategies, const GameRecord &record)
+{
+    if (record.winner == "Invalid Map")
+    {
+        return;
+    }
+    games++;
+
+    const bool won = record.winner != "Draw";
+    const std::string winner = won ? strategyOf(record.winner) : "";
+
+    // Players are named after their strategy and the number of players of the strategy created before them
+    std::map<std::string, int> created;
+    std::vector<std::string> present;
+    for (const std::string &strategy : strategies)
+    {
+        see(strategy);
+        const std::string player = strategy + std::to_string(created[strategy]++);
+        if (created[strategy] == 1)
+        {
+            present.push_back(strategy);
+        }
+
+        StrategyTotals &seat = strategyTotals[strategy];
+        seat.seats++;
+        if (!won)
+        {
+            auto share = record.territoryShares.find(player);
+            seat.cutoffs++;
+            seat.cutoffShare += share == record.territoryShares.end() ? 0 : share->second;
+        }
+        else if (player == record.winner)
+        {
+            seat.wins++;
+            seat.turnsToWin += record.turns;
+        }
+        else
+        {
+            seat.losses++;
+        }
+    }
+
+    for (const std::string &strategy : present)
+    {
+        for (const std::string &opponent : present)
+        {
+            if (strategy == opponent)
+            {
+                continue;
+            }
+            HeadToHead &outcome = pairs[std::make_pair(strategy, opponent)];
+            outcome.games++;
+            outcome.wins += won && winner == strategy;
+            outcome.losses += won && winner == opponent;
+        }
+    }
+}
+
+int TournamentStatistics::getGames() const
+{
+    return games;
+}
+
+/**
+ * @param strategy A strategy.
+ * @return The outcomes of the seats of the strategy.
+ */
+TournamentStatistics::StrategyTotals TournamentStatistics::totals(const std::string &strategy) const
+{
+    auto found = strategyTotals.find(strategy);
+    return found == strategyTotals.end() ? StrategyTotals() : found->second;
+}
+
+/**
+ * @param strategy A strategy.
+ * @param opponent Another strategy.
+ * @return The outcomes of the games the strategy played against the opponent.
+ */
+TournamentStatistics::HeadToHead TournamentStatistics::headToHead(const std::string &strategy, const std::string &opponent) const
+{
+    auto found = pairs.find(std::make_pair(strategy, opponent));
+    return found == pairs.end() ? HeadToHead() : found->second;
+}
+
+/**
+ * @brief The Wilson score interval of a proportion.
+ *
+ * @param successes The successes.
+ * @param trials The trials, the interval is [0, 1] without any.
+ * @param low Receives the lower bound of the interval.
+ * @param high Receives the upper bound of the interval.
+ */
+void TournamentStatistics::wilsonInterval(int successes, int trials, double &low, double &high)
+{
+    if (trials <= 0)
+    {
+        low = 0;
+        high = 1;
+        return;
+    }
+
+    const double n = trials;
+    const double p = successes / n;
+    const double z2 = WILSON_Z * WILSON_Z;
+    const double denominator = 1 + z2 / n;
+    const double centre = (p + z2 / (2 * n)) / denominator;
+    const double halfWidth = WILSON_Z * std::sqrt(p * (1 - p) / n + z2 / (4 * n * n)) / denominator;
+    low = std::max(0.0, centre - halfWidth);
+    high = std::min(1.0, centre + halfWidth);
+}
+
+/**
+ * @param player The name of a player of a tournament game.
+ * @return The strategy of the player, its name without the trailing number.
+ */
+std::string TournamentStatistics::strategyOf(const std::string &player)
+{
+    std::size_t end = player.size();
+    while (end > 0 && std::isdigit(static_cast<unsigned char>(player[end - 1])))
+    {
+        end--;
+    }
+    return player.substr(0, end);
+}
+
+/**
+ * @brief Writes the statistics of every strategy as CSV: its seats and their outcomes, its win rate and the 95%
+ * Wilson interval of the win rate, the mean turns of the games it won and its mean share of the territories when cut
+ * off. A mean without any game is left empty.
+ */
+void TournamentStatistics::writeStrategiesCsv(std::ostream &out) const
+{
+    out << "strategy,seats,wins,losses,cutoffs,win_rate,win_rate_low,win_rate_high,mean_turns_to_win,"
+           "mean_territory_share_at_cutoff\n";
+    for (const std::string &strategy : strategies)
+    {
+        const StrategyTotals seat = totals(strategy);
+        double low, high;
+        wilsonInterval(seat.wins, seat.seats, low, high);
+        out << csvField(strategy) << ',' << seat.seats << ',' << seat.wins << ',' << seat.losses << ',' << seat.cutoffs
+            << ',' << number(seat.seats > 0 ? static_cast<double>(seat.wins) / seat.seats : 0, seat.seats > 0) << ','
+            << number(low) << ',' << number(high) << ','
+            << number(seat.wins > 0 ? static_cast<double>(seat.turnsToWin) / seat.wins : 0, seat.wins > 0) << ','
+            << number(seat.cutoffs > 0 ? seat.cutoffShare / seat.cutoffs : 0, seat.cutoffs > 0) << '\n';
+    }
+}
+
+/**
+ * @brief Writes the head to head outcomes of every pair of strategies as CSV, one row per strategy and opponent:
+ * the games both played, the games each won and the games neither won.
+ */
+void TournamentStatistics::writeHeadToHeadCsv(std::ostream &out) const
+{
+    out << "strategy,opponent,games,wins,losses,neither\n";
+    for (const std::string &strategy : strategies)
+    {
+        for (const std::string &opponent : strategies)
+        {
+            const HeadToHead outcome = headToHead(strategy, opponent);
+            if (outcome.games > 0)
+            {
+                out << csvField(strategy) << ',' << csvField(opponent) << ',' << outcome.games << ',' << outcome.wins
+                    << ',' << outcome.losses << ',' << outcome.games - outcome.wins - outcome.losses << '\n';
+            }
+        }
+    }
+}
+
+/**
+ * @brief Writes the statistics of every strategy and every pair of strategies as JSON, a mean without any game
+ * being null.
+ */
+void TournamentStatistics::writeJson(std::ostream &out) const
+{
+    out << "{\n  \"games\": " << games << ",\n  \"confidence\": 0.95,\n  \"strategies\": [";
+    for (std::size_t i = 0; i < strategies.size(); ++i)
+    {
+        const StrategyTotals seat = totals(strategies[i]);
+        double low, high;
+        wilsonInterval(seat.wins, seat.seats, low, high);
+        out << (i == 0 ? "\n" : ",\n") << "    {\"strategy\": " << jsonString(strategies[i]) << ", \"seats\": "
+            << seat.seats << ", \"wins\": " << seat.wins << ", \"losses\": " << seat.losses << ", \"cutoffs\": "
+            << seat.cutoffs << ", \"winRate\": "
+            << jsonNumber(seat.seats > 0 ? static_cast<double>(seat.wins) / seat.seats : 0, seat.seats > 0)
+            << ", \"winRateLow\": " << jsonNumber(low) << ", \"winRateHigh\": " << jsonNumber(high)
+            << ", \"meanTurnsToWin\": "
+            << jsonNumber(seat.wins > 0 ? static_cast<double>(seat.turnsToWin) / seat.wins : 0, seat.wins > 0)
+            << ", \"meanTerritoryShareAtCutoff\": "
+            << jsonNumber(seat.cutoffs > 0 ? seat.cutoffShare / seat.cutoffs : 0, seat.cutoffs > 0) << "}";
+    }
+    out << (strategies.empty() ? "" : "\n  ") << "],\n  \"headToHead\": [";
+
+    bool first = true;
+    for (const std::string &strategy : strategies)
+    {
+        for (const std::string &opponent : strategies)
+        {
+            const HeadToHead outcome = headToHead(strategy, opponent);
+            if (outcome.games > 0)
+            {
+                out << (first ? "\n" : ",\n") << "    {\"strategy\": " << jsonString(strategy) << ", \"opponent\": "
+                    << jsonString(opponent) << ", \"games\": " << outcome.games << ", \"wins\": " << outcome.wins
+                    << ", \"losses\": " << outcome.losses << "}";
+                first = false;
+            }
+        }
+    }
+    out << (first ? "" : "\n  ") << "]\n}\n";
+}
+
+/**
+ * @brief Writes the statistics to tournament_stats.csv, tournament_head_to_head.csv and tournament_stats.json.
+ *
+ * @return true if every file was written.
+ */
+bool TournamentStatistics::writeFiles() const
+{
+    std::ofstream strategiesCsv("tournament_stats.csv");
+    writeStrategiesCsv(strategiesCsv);
+    std::ofstream headToHeadCsv("tournament_head_to_head.csv");
+    writeHeadToHeadCsv(headToHeadCsv);
+    std::ofstream json("tournament_stats.json");
+    writeJson(json);
+    return strategiesCsv.good() && headToHeadCsv.good() && json.good();
+}
+
+/**
+ * @brief Records a strategy, so that it is written in the order it was first seen.
+ */
+void TournamentStatistics::see(const std::string &strategy)
+{
+    if (strategyTotals.find(strategy) == strategyTotals.end())
+    {
+        strategies.push_back(strategy);
+        strategyTotals[strategy];
+    }
+}
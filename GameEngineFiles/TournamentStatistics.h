@@ -0,0 +1,131 @@
+#ifndef TOURNAMENT_STATISTICS_H
+#define TOURNAMENT_STATISTICS_H
+
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "TournamentResults.h"
+
+/**
+ * @brief Aggregates the games of tournaments into statistics by strategy, one game at a time.
+ *
+ * Every player of a game is a seat of its strategy, so a strategy playing twice in a game has two seats. A seat is
+ * won, lost to another player, or cut off when the game ends without a winner, on the turn limit or as a stalemate.
+ * For every strategy, the statistics keep the seats, their outcomes, the turns of the games won and the share of the
+ * territories held when cut off; for every pair of strategies, the outcomes of the games both played. Only these
+ * sums are kept, so the memory used does not grow with the number of games.
+ *
+ * The statistics are written next to the tournament log: tournament_stats.csv has a row per strategy,
+ * tournament_head_to_head.csv a row per pair of strategies, and tournament_stats.json has both.
+ */
+class TournamentStatistics
+{
+public:
+    /**
+     * @brief The outcomes of the seats of a strategy.
+     */
+    struct StrategyTotals
+    {
+        int seats = 0;             ///< The players of the strategy.
+        int wins = 0;              ///< The seats that won their game.
+        int losses = 0;            ///< The seats whose game was won by another player.
+        int cutoffs = 0;           ///< The seats whose game ended without a winner.
+        long long turnsToWin = 0;  ///< The turns of the games won, summed.
+        double cutoffShare = 0;    ///< The share of the territories held by the cut off seats, summed.
+    };
+
+    /**
+     * @brief The outcomes of the games a strategy played against another.
+     */
+    struct HeadToHead
+    {
+        int games = 0;  ///< The games both strategies played.
+        int wins = 0;   ///< The games won by the strategy.
+        int losses = 0; ///< The games won by the other strategy.
+    };
+
+    /**
+     * @brief The normal quantile of the 95% confidence intervals of the win rates.
+     */
+    static const double WILSON_Z;
+
+    /**
+     * @brief Adds a game. A game on an invalid map was not played and is not added.
+     *
+     * @param strategies The strategies of the players of the game, in the order the players were created.
+     * @param record The outcome of the game.
+     */
+    void addGame(const std::vector<std::string> &strategies, const GameRecord &record);
+
+    /**
+     * @return The games added.
+     */
+    int getGames() const;
+
+    /**
+     * @param strategy A strategy.
+     * @return The outcomes of the seats of the strategy.
+     */
+    StrategyTotals totals(const std::string &strategy) const;
+
+    /**
+     * @param strategy A strategy.
+     * @param opponent Another strategy.
+     * @return The outcomes of the games the strategy played against the opponent.
+     */
+    HeadToHead headToHead(const std::string &strategy, const std::string &opponent) const;
+
+    /**
+     * @brief The Wilson score interval of a proportion, which stays within [0, 1] and is meaningful for few trials
+     * and for proportions close to 0 or 1.
+     *
+     * @param successes The successes.
+     * @param trials The trials, the interval is [0, 1] without any.
+     * @param low Receives the lower bound of the interval.
+     * @param high Receives the upper bound of the interval.
+     */
+    static void wilsonInterval(int successes, int trials, double &low, double &high);
+
+    /**
+     * @param player The name of a player of a tournament game, such as "Aggressive0".
+     * @return The strategy of the player, its name without the trailing number.
+     */
+    static std::string strategyOf(const std::string &player);
+
+    /**
+     * @brief Writes the statistics of every strategy as CSV.
+     */
+    void writeStrategiesCsv(std::ostream &out) const;
+
+    /**
+     * @brief Writes the head to head outcomes of every pair of strategies as CSV.
+     */
+    void writeHeadToHeadCsv(std::ostream &out) const;
+
+    /**
+     * @brief Writes the statistics of every strategy and every pair of strategies as JSON.
+     */
+    void writeJson(std::ostream &out) const;
+
+    /**
+     * @brief Writes the statistics to their files next to the tournament log.
+     *
+     * @return true if every file was written.
+     */
+    bool writeFiles() const;
+
+private:
+    int games = 0;
+    std::vector<std::string> strategies; ///< The strategies in the order they were first seen.
+    std::map<std::string, StrategyTotals> strategyTotals;
+    std::map<std::pair<std::string, std::string>, HeadToHead> pairs;
+
+    /**
+     * @brief Records a strategy, so that it is written in the order it was first seen.
+     */
+    void see(const std::string &strategy);
+};
+
+#endif
@@ -5,6 +5,7 @@
 #include "LoggingObserver.h"
 #include <algorithm>
 #include <fstream>
+#include <mutex>
 
 /**
  * Attaches an Observer to this Subject.
@@ -54,6 +55,10 @@ LogObserver::LogObserver() {
  *                 information to log.
  */
 void LogObserver::update(ILoggable* loggable) {
+    // Orders may be executed concurrently by the OrderScheduler
+    static std::mutex logMutex;
+    std::lock_guard<std::mutex> lock(logMutex);
+
     std::ofstream logFile("gamelog.txt", std::ios::app);
     logFile << loggable->stringToLog() << std::endl;
     logFile.close();
@@ -7,6 +7,7 @@
 #include "OrdersFiles/Orders.h"
 #include "GameEngineFiles/CommandProcessing.h"
 #include "GameEngineFiles/GameEngine.h"
+#include "PlayerFiles/PlayerStrategies.h"
 
 void testLoggingObserver() {
     LogObserver logObserver;
@@ -30,14 +31,15 @@ void testLoggingObserver() {
 
     // Logging in order handling
     Player player;
+    player.setStrategy(new NeutralPlayerStrategy(&player));
     player.setNumArmies(20);
     player.getOwnedTerritories().push_back(gameMap.territories.at("Ahuntsic"));
     OrdersList orderList;
     orderList.attach(&logObserver);
 
+    // The order reports its execution to the observers of its list
     auto* deployOrder = new DeployOrder(&player, "Ahuntsic", 10);
     deployOrder->player = &player;
-    deployOrder->attach(&logObserver);
 
     orderList.add(deployOrder);
     deployOrder->execute();
@@ -93,6 +93,103 @@ int main(int argc, char *argv[])
                 std::cout << "Running test: testPlayerStrategies...\n";
                 testPlayerStrategies();
             }
+
+            // Performance features
+            else if (arg == "testMapSnapshots")
+            {
+                std::cout << "Running test: testMapSnapshots...\n";
+                testMapSnapshots();
+            }
+            else if (arg == "testOrderJournal")
+            {
+                std::cout << "Running test: testOrderJournal...\n";
+                testOrderJournal();
+            }
+            else if (arg == "testBattleKernel")
+            {
+                std::cout << "Running test: testBattleKernel...\n";
+                testBattleKernel();
+            }
+            else if (arg == "testCombatOdds")
+            {
+                std::cout << "Running test: testCombatOdds...\n";
+                testCombatOdds();
+            }
+            else if (arg == "testTurnPlanning")
+            {
+                std::cout << "Running test: testTurnPlanning...\n";
+                testTurnPlanning();
+            }
+            else if (arg == "testTurnSearch")
+            {
+                std::cout << "Running test: testTurnSearch...\n";
+                testTurnSearch();
+            }
+            else if (arg == "testFrontierRouting")
+            {
+                std::cout << "Running test: testFrontierRouting...\n";
+                testFrontierRouting();
+            }
+            else if (arg == "testDecisionProfiler")
+            {
+                std::cout << "Running test: testDecisionProfiler...\n";
+                testDecisionProfiler();
+            }
+            else if (arg == "testStalemateDetector")
+            {
+                std::cout << "Running test: testStalemateDetector...\n";
+                testStalemateDetector();
+            }
+            else if (arg == "testTournamentScheduler")
+            {
+                std::cout << "Running test: testTournamentScheduler...\n";
+                testTournamentScheduler();
+            }
+            else if (arg == "testTournamentShards")
+            {
+                std::cout << "Running test: testTournamentShards...\n";
+                testTournamentShards();
+            }
+            else if (arg == "testTournamentCheckpoint")
+            {
+                std::cout << "Running test: testTournamentCheckpoint...\n";
+                testTournamentCheckpoint();
+            }
+            else if (arg == "testTournamentStatistics")
+            {
+                std::cout << "Running test: testTournamentStatistics...\n";
+                testTournamentStatistics();
+            }
+            else if (arg == "testDistanceTables")
+            {
+                std::cout << "Running test: testDistanceTables...\n";
+                testDistanceTables();
+            }
+            else if (arg == "testSpatialIndex")
+            {
+                std::cout << "Running test: testSpatialIndex...\n";
+                testSpatialIndex();
+            }
+            else if (arg == "testOrderScheduler")
+            {
+                std::cout << "Running test: testOrderScheduler...\n";
+                testOrderScheduler();
+            }
+            else if (arg == "testOrderSchedulerGame")
+            {
+                std::cout << "Running test: testOrderSchedulerGame...\n";
+                testOrderSchedulerGame();
+            }
+            else if (arg == "testOrderValidation")
+            {
+                std::cout << "Running test: testOrderValidation...\n";
+                testOrderValidation();
+            }
+            else if (arg == "testOrderPool")
+            {
+                std::cout << "Running test: testOrderPool...\n";
+                testOrderPool();
+            }
             else if (arg == "testTournament")
             {
                 std::cout << "Running test: testTournament...\n";
@@ -2,11 +2,20 @@
 #include <stdexcept>
 #include <sstream>
 #include <algorithm>
+#include <cctype>
+#include <unordered_map>
 #include <unordered_set>
 #include <queue>
+#include <thread>
 
 #include "MapFiles/Map.h"
 
+const int Map::DISTANCE_TABLE_LIMIT;
+const std::uint16_t Map::UNREACHABLE;
+const int Map::DISTANCE_ROW_CACHE;
+std::atomic<std::uint64_t> Map::generations(0);
+const int MapSnapshot::PAGE_SIZE;
+
 /**
  * Removes leading and trailing whitespace from a given string.
  *
@@ -29,7 +38,7 @@ std::string trim_white(const std::string& str) {
 
 /**
  * Copy constructor for the Territory class.
- * Creates a deep copy of the adjacentTerritories map, ensuring each pointer is properly duplicated.
+ * Creates a copy of the adjacentTerritories, whose pointers are updated by the Map copy constructor.
  *
  * @param other The Territory object to copy from.
  */
@@ -37,11 +46,9 @@ Territory::Territory(const Territory& other) {
     numberOfArmies = other.numberOfArmies;
     x = other.x;
     y = other.y;
-
-    for (const auto& pair : other.adjacentTerritories)
-    {
-        adjacentTerritories.insert({pair.first, pair.second}); // These pointers are updated by the Map copy constructor
-    }
+    id = other.id;
+    name = other.name;
+    adjacentTerritories = other.adjacentTerritories; // These pointers are updated by the Map copy constructor
 }
 
 /**
@@ -57,11 +64,13 @@ Territory& Territory::operator=(const Territory& other) {
     numberOfArmies = other.numberOfArmies;
     x = other.x;
     y = other.y;
+    id = other.id;
+    name = other.name;
 
     adjacentTerritories.clear();
-    for (const auto& pair : other.adjacentTerritories)
+    for (Territory* adjacent : other.adjacentTerritories)
     {
-        adjacentTerritories.insert({pair.first, new Territory(*pair.second)});
+        adjacentTerritories.push_back(new Territory(*adjacent));
     }
 
     return *this;
@@ -77,13 +86,23 @@ Territory& Territory::operator=(const Territory& other) {
 std::ostream & operator << (std::ostream &out,  Territory &t) {
     out << " (Position: " << t.x << ", " << t.y << ")\n\t\t\t\tAdjacent Territories:\n";
 
-    for (auto& territory : t.adjacentTerritories) {
-        out << "\t\t\t\t\t" << territory.first << "\n";
+    for (Territory* territory : t.adjacentTerritories) {
+        out << "\t\t\t\t\t" << territory->name << "\n";
     }
 
     return out;
 }
 
+/**
+ * Scans the adjacent territories, which are few, rather than keeping an index of them.
+ *
+ * @param other Another territory.
+ * @return true if the other territory is one of the adjacentTerritories.
+ */
+bool Territory::IsAdjacentTo(const Territory* other) const {
+    return std::find(adjacentTerritories.begin(), adjacentTerritories.end(), other) != adjacentTerritories.end();
+}
+
 /**
  * Copy constructor for the Continent class.
  * Creates a deep copy of the childTerritories map.
@@ -214,6 +233,17 @@ Map& Map::operator=(const Map& other) {
         delete pair.second;  // Delete old territories
     }
     territories.clear();
+    territoriesById.clear();
+    adjacencyOffsets.clear();
+    adjacencyTargets.clear();
+    hopDistances.clear();
+    nextHops.clear();
+    distancesOnDemand = false;
+    {
+        std::lock_guard<std::mutex> lock(distanceRowsMutex);
+        distanceRows.clear();
+        nextDistanceRow = 0;
+    }
 
     DeepCopyMapData(other);
 
@@ -250,6 +280,291 @@ Map::~Map() {
         delete territory.second; // Delete all territory instances that were dynamically allocated.
     }
     territories.clear();
+    territoriesById.clear();
+}
+
+/**
+ * Assigns a dense id to every territory, following the (alphabetical) order of the territories map,
+ * and rebuilds the territoriesById index. The spatial index is rebuilt on its next query.
+ */
+void Map::AssignTerritoryIds() {
+    generation = ++generations;
+
+    {
+        std::lock_guard<std::mutex> lock(spatialIndexMutex);
+        spatialIndex.Clear();
+        spatialIndexBuilt = false;
+    }
+
+    territoriesById.clear();
+    territoriesById.reserve(territories.size());
+
+    for (auto& pair : territories) {
+        pair.second->id = static_cast<int>(territoriesById.size());
+        territoriesById.push_back(pair.second);
+    }
+}
+
+/**
+ * @return The generation of the territories and adjacency of the map.
+ */
+std::uint64_t Map::GetGeneration() const {
+    return generation;
+}
+
+/**
+ * Builds the spatial index on the first query rather than on every load, since only some strategies and tools
+ * query it. Several threads may query the map of a game, so the build is done under a lock.
+ *
+ * @return The spatial index of the territories.
+ */
+const SpatialIndex& Map::GetSpatialIndex() const {
+    std::lock_guard<std::mutex> lock(spatialIndexMutex);
+    if (!spatialIndexBuilt) {
+        spatialIndex.Build(territoriesById);
+        spatialIndexBuilt = true;
+    }
+    return spatialIndex;
+}
+
+/**
+ * Rebuilds the compressed adjacency arrays from the adjacentTerritories of every territory, by id.
+ */
+void Map::BuildAdjacencyArrays() {
+    generation = ++generations;
+
+    const int n = static_cast<int>(territoriesById.size());
+    adjacencyOffsets.assign(n + 1, 0);
+    adjacencyTargets.clear();
+
+    for (int id = 0; id < n; ++id) {
+        for (const Territory* adj : territoriesById[id]->adjacentTerritories) {
+            adjacencyTargets.push_back(adj->id);
+        }
+        adjacencyOffsets[id + 1] = static_cast<int>(adjacencyTargets.size());
+    }
+}
+
+/**
+ * Precomputes the hop distance and next hop tables. Each worker thread runs a breadth-first search from every
+ * T-th source territory and fills the corresponding rows, so no synchronisation is needed between workers.
+ * The first hop of every discovered territory is inherited from the territory it was discovered from.
+ * Above maxTerritories, no table is built and the distances are searched on demand instead.
+ *
+ * @param maxTerritories The largest number of territories for which the tables are built.
+ * @return true if the tables were built, false if the map is too large or empty.
+ */
+bool Map::PrecomputeDistances(int maxTerritories) {
+    hopDistances.clear();
+    nextHops.clear();
+    distancesOnDemand = false;
+    {
+        std::lock_guard<std::mutex> lock(distanceRowsMutex);
+        distanceRows.clear();
+        nextDistanceRow = 0;
+    }
+
+    const int n = static_cast<int>(territoriesById.size());
+    if (n == 0) {
+        return false;
+    }
+
+    // The searches run on the adjacency arrays, so they do not touch the name-keyed maps
+    if (adjacencyOffsets.size() != static_cast<size_t>(n) + 1) {
+        BuildAdjacencyArrays();
+    }
+    if (n > maxTerritories || n >= UNREACHABLE) {
+        distancesOnDemand = true;
+        return false;
+    }
+    const std::vector<int>& offsets = adjacencyOffsets;
+    const std::vector<int>& targets = adjacencyTargets;
+
+    hopDistances.assign(static_cast<size_t>(n) * n, UNREACHABLE);
+    nextHops.assign(static_cast<size_t>(n) * n, UNREACHABLE);
+
+    auto searchFrom = [&](int source) {
+        std::uint16_t* distanceRow = &hopDistances[static_cast<size_t>(source) * n];
+        std::uint16_t* nextHopRow = &nextHops[static_cast<size_t>(source) * n];
+        std::vector<int> frontier;
+        frontier.reserve(n);
+
+        distanceRow[source] = 0;
+        frontier.push_back(source);
+
+        for (size_t head = 0; head < frontier.size(); ++head) {
+            int current = frontier[head];
+            for (int e = offsets[current]; e < offsets[current + 1]; ++e) {
+                int adjacent = targets[e];
+                if (distanceRow[adjacent] == UNREACHABLE) {
+                    distanceRow[adjacent] = static_cast<std::uint16_t>(distanceRow[current] + 1);
+                    nextHopRow[adjacent] = static_cast<std::uint16_t>(current == source ? adjacent : nextHopRow[current]);
+                    frontier.push_back(adjacent);
+                }
+            }
+        }
+    };
+
+    int threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    threadCount = std::max(1, std::min(threadCount, n / 64 + 1));
+
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threadCount; ++t) {
+        workers.emplace_back([&, t]() {
+            for (int source = t; source < n; source += threadCount) {
+                searchFrom(source);
+            }
+        });
+    }
+    for (int source = 0; source < n; source += threadCount) {
+        searchFrom(source);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    return true;
+}
+
+bool Map::HasDistanceTable() const {
+    return !hopDistances.empty();
+}
+
+bool Map::HasDistances() const {
+    return HasDistanceTable() || distancesOnDemand;
+}
+
+/**
+ * Finds the row of a source territory among the rows searched last, or runs a breadth-first search from it.
+ * The search runs outside the lock, so two threads may search the same source; both rows are then identical.
+ *
+ * @param source The id of a source territory.
+ * @return The row of the source.
+ */
+std::shared_ptr<const Map::DistanceRow> Map::DistanceRowFrom(int source) const {
+    {
+        std::lock_guard<std::mutex> lock(distanceRowsMutex);
+        for (const auto& row : distanceRows) {
+            if (row->source == source) {
+                return row;
+            }
+        }
+    }
+
+    const int n = static_cast<int>(territoriesById.size());
+    std::shared_ptr<DistanceRow> row = std::make_shared<DistanceRow>();
+    row->source = source;
+    row->distances.assign(n, -1);
+    row->nextHops.assign(n, -1);
+
+    std::vector<int> frontier;
+    frontier.reserve(n);
+    row->distances[source] = 0;
+    frontier.push_back(source);
+    for (size_t head = 0; head < frontier.size(); ++head) {
+        int current = frontier[head];
+        for (int e = adjacencyOffsets[current]; e < adjacencyOffsets[current + 1]; ++e) {
+            int adjacent = adjacencyTargets[e];
+            if (row->distances[adjacent] < 0) {
+                row->distances[adjacent] = row->distances[current] + 1;
+                row->nextHops[adjacent] = current == source ? adjacent : row->nextHops[current];
+                frontier.push_back(adjacent);
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(distanceRowsMutex);
+    if (distanceRows.size() < static_cast<size_t>(DISTANCE_ROW_CACHE)) {
+        distanceRows.push_back(row);
+    } else {
+        distanceRows[nextDistanceRow] = row;
+        nextDistanceRow = (nextDistanceRow + 1) % distanceRows.size();
+    }
+    return row;
+}
+
+/**
+ * Looks up the hop distance between two territories in the precomputed table, or in the row of the source
+ * territory searched on demand above the table limit.
+ *
+ * @param from The source territory.
+ * @param to The destination territory.
+ * @return The hop distance, or -1 if unreachable or the distances were not precomputed.
+ */
+int Map::HopDistance(const Territory* from, const Territory* to) const {
+    if (!HasDistances() || from == nullptr || to == nullptr || from->id < 0 || to->id < 0) {
+        return -1;
+    }
+    if (distancesOnDemand) {
+        return DistanceRowFrom(from->id)->distances[to->id];
+    }
+
+    std::uint16_t distance = hopDistances[static_cast<size_t>(from->id) * territoriesById.size() + to->id];
+    return distance == UNREACHABLE ? -1 : distance;
+}
+
+/**
+ * Looks up the first hop on a shortest path between two territories in the precomputed table, or in the row of the
+ * source territory searched on demand above the table limit.
+ *
+ * @param from The source territory.
+ * @param to The destination territory.
+ * @return The adjacent territory to move to, or nullptr if there is none.
+ */
+Territory* Map::NextHop(const Territory* from, const Territory* to) const {
+    if (!HasDistances() || from == nullptr || to == nullptr || from->id < 0 || to->id < 0) {
+        return nullptr;
+    }
+    if (distancesOnDemand) {
+        int next = DistanceRowFrom(from->id)->nextHops[to->id];
+        return next < 0 ? nullptr : territoriesById[next];
+    }
+
+    std::uint16_t next = nextHops[static_cast<size_t>(from->id) * territoriesById.size() + to->id];
+    return next == UNREACHABLE ? nullptr : territoriesById[next];
+}
+
+/**
+ * Runs a single breadth-first search seeded with every source territory, so each territory is reached from its
+ * closest source and the whole search is O(V + E) however many sources there are.
+ *
+ * @param sources The ids of the source territories, at distance 0.
+ * @param passable Marks by territory id the territories the search may enter.
+ * @param distances Receives the hop distance of every territory to the closest source, -1 if it is not reached.
+ */
+void Map::MultiSourceDistances(const std::vector<int>& sources, const std::vector<char>& passable, std::vector<int>& distances) const {
+    const int n = static_cast<int>(territoriesById.size());
+    distances.assign(n, -1);
+
+    std::vector<int> frontier;
+    frontier.reserve(n);
+    for (int source : sources) {
+        if (distances[source] < 0) {
+            distances[source] = 0;
+            frontier.push_back(source);
+        }
+    }
+
+    const bool hasArrays = adjacencyOffsets.size() == static_cast<size_t>(n) + 1;
+    auto visit = [&](int current, int adjacent) {
+        if (distances[adjacent] < 0 && passable[adjacent]) {
+            distances[adjacent] = distances[current] + 1;
+            frontier.push_back(adjacent);
+        }
+    };
+
+    for (size_t head = 0; head < frontier.size(); ++head) {
+        int current = frontier[head];
+        if (hasArrays) {
+            for (int e = adjacencyOffsets[current]; e < adjacencyOffsets[current + 1]; ++e) {
+                visit(current, adjacencyTargets[e]);
+            }
+        } else {
+            for (const Territory* adj : territoriesById[current]->adjacentTerritories) {
+                visit(current, adj->id);
+            }
+        }
+    }
 }
 
 /**
@@ -277,11 +592,11 @@ bool Map::IsConnectedGraph(std::map<std::string, Territory *>& territories, cons
         Territory* currentTerritory = territories[current];
 
         // Visit all adjacent territories that are part of the valid set (e.g., within the same continent)
-        for (const auto& adj : currentTerritory->adjacentTerritories) {
-            if (validTerritories.find(adj.first) != validTerritories.end() &&
-                visited.find(adj.first) == visited.end()) {
-                visited.insert(adj.first);
-                q.push(adj.first);
+        for (const Territory* adj : currentTerritory->adjacentTerritories) {
+            if (validTerritories.find(adj->name) != validTerritories.end() &&
+                visited.find(adj->name) == visited.end()) {
+                visited.insert(adj->name);
+                q.push(adj->name);
             }
         }
     }
@@ -328,14 +643,53 @@ void Map::DeepCopyMapData(const Map& other) {
     // Step 3: Update the adjacentTerritories in each new Territory to point to the new Territory instances using old to new map
     for (const auto& pair : territories) {
         Territory* territory = pair.second;
-        for (auto& adjPair : territory->adjacentTerritories) {
-            adjPair.second = territoryMapping[adjPair.second];
+        for (auto& adjacent : territory->adjacentTerritories) {
+            adjacent = territoryMapping[adjacent];
         }
     }
+
+    AssignTerritoryIds();
+
+    // Adjacency arrays and distance tables are indexed by id, which the copy preserves
+    adjacencyOffsets = other.adjacencyOffsets;
+    adjacencyTargets = other.adjacencyTargets;
+    hopDistances = other.hopDistances;
+    nextHops = other.nextHops;
+    distancesOnDemand = other.distancesOnDemand;
 }
 
+/**
+ * Bookkeeping of a streaming load. Territory ids are handed out the first time a name is seen, either on its own
+ * line or as the adjacent territory of another one, and edges are appended to a flat buffer of id pairs.
+ * Everything here is released once the graph is finalised.
+ */
+struct MapLoader::StreamingState
+{
+    std::unordered_map<std::string, int> idsByName; ///< Loader id of every territory name seen so far.
+    std::vector<Territory *> territories; ///< Territories by loader id, nullptr until their own line is parsed.
+    std::vector<std::string> referencedNames; ///< Names of referenced territories whose line was not parsed yet.
+    std::vector<int> edgeSources; ///< Loader id of the source of each edge.
+    std::vector<int> edgeTargets; ///< Loader id of the target of each edge.
+    std::unordered_set<std::string> undefinedContinents; ///< Continents used by a territory before their own line.
+
+    /**
+     * @param name A territory name.
+     * @return The loader id of the territory, assigning the next id if the name was never seen.
+     */
+    int IdOf(const std::string& name)
+    {
+        auto inserted = idsByName.insert({name, static_cast<int>(territories.size())});
+        if (inserted.second) {
+            territories.push_back(nullptr);
+            referencedNames.push_back(name);
+        }
+        return inserted.first->second;
+    }
+};
+
 /**
  * Loads a map from a file and populates the Map object.
+ * The file is read once, line by line; the adjacency graph is only materialised when the whole file has been read.
  *
  * @param sFileName The name of the file to load.
  * @param map The Map object to populate.
@@ -352,9 +706,32 @@ void MapLoader::LoadMap(const std::string& sFileName, Map* map) {
         }
         else
         {
-            ParseMapMetaData(mapFile, map);
-            ParseContinents(mapFile, map);
-            ParseTerritories(mapFile, map);
+            StreamingState state;
+            std::string line;
+            std::string section;
+
+            // The last line may not end with a newline, reaching the end of the file is not an error here
+            mapFile.exceptions(std::ifstream::badbit);
+            while (std::getline(mapFile, line)) {
+                if (line.empty()) {
+                    continue;
+                }
+
+                if (line[0] == '[') {
+                    section = line;
+                    continue;
+                }
+
+                if (section == "[Map]") {
+                    ParseMapMetaData(line, map);
+                } else if (section == "[Continents]") {
+                    ParseContinent(line, map, state);
+                } else if (section == "[Territories]") {
+                    ParseTerritory(line, map, state);
+                }
+            }
+
+            FinalizeGraph(map, state);
         }
     }
 
@@ -366,182 +743,275 @@ void MapLoader::LoadMap(const std::string& sFileName, Map* map) {
 }
 
 /**
- * Parses metadata from the map file.
+ * Parses a line of the map metadata section.
  *
- * @param mapFile The input file stream.
+ * @param line A "key=value" line of the [Map] section.
  * @param map The Map object to populate with metadata.
  */
-void MapLoader::ParseMapMetaData(std::ifstream& mapFile, Map* map) {
-    mapFile.seekg(0, std::ios::beg); // Ensure file read pos is at start of file
-
-    std::string line;
-    bool inMapSection = false;
-
-    while (!mapFile.eof() && mapFile.peek() != EOF) {
-        std::getline(mapFile, line);
-
-        if (line == "[Map]") {
-            inMapSection = true;
-            continue;
-        }
-
-        if (line.empty()) {
-            continue;
-        }
-
-        if (line[0] == '[') {
-            inMapSection = false;
-            continue;
-        }
-
-        if (inMapSection) {
-            // Parse the key-value pairs
-            std::istringstream iss(line);
-            std::string key, value;
+void MapLoader::ParseMapMetaData(const std::string& line, Map* map) {
+    size_t separator = line.find('=');
+    if (separator == std::string::npos) {
+        return;
+    }
 
-            if (std::getline(iss, key, '=') && std::getline(iss, value)) {
-                key = trim_white(key);
-                value = trim_white(value);
+    std::string key = trim_white(line.substr(0, separator));
+    std::string value = trim_white(line.substr(separator + 1));
 
-                if (key == "image") {
-                    map->imageFilename = value;
-                }
-            }
-        }
+    if (key == "image" && !value.empty()) {
+        map->imageFilename = value;
     }
 }
 
 /**
- * Parses the continents section of a map file and adds the continents to the Map object.
+ * Parses a line of the continents section and adds the continent to the Map object.
+ * A continent already created by a territory line that came first only gets its bonus points set.
  *
- * @param mapFile The input file stream containing the map data.
+ * @param line A "name=bonus" line of the [Continents] section.
  * @param map The Map object to populate.
+ * @param state The bookkeeping of the current load.
  */
-void MapLoader::ParseContinents(std::ifstream &mapFile, Map *map) {
-    mapFile.seekg(0, std::ios::beg);
+void MapLoader::ParseContinent(const std::string& line, Map* map, StreamingState& state) {
+    size_t separator = line.find('=');
+    std::string continentName = line.substr(0, separator);
+    std::string points = separator == std::string::npos ? "" : line.substr(separator + 1, line.find(',', separator) - separator - 1);
+
+    auto inserted = map->continents.insert({continentName, nullptr});
+    if (inserted.second) {
+        inserted.first->second = new Continent();
+    }
+    state.undefinedContinents.erase(continentName);
 
-    std::string line;
-    bool inContinentsSection = false;
+    // Read the points for owning the continent
+    inserted.first->second->bonusPoints = std::stoi(points);
+}
 
-    while (!mapFile.eof() && mapFile.peek() != EOF) {
-        std::getline(mapFile, line);
+/**
+ * Parses a line of the territories section: creates the Territory, adds it to its continent and appends
+ * one edge per adjacent territory to the edge buffer.
+ *
+ * @param line A "name,x,y,continent,adjacent..." line of the [Territories] section.
+ * @param map The Map object to populate.
+ * @param state The bookkeeping of the current load.
+ */
+void MapLoader::ParseTerritory(const std::string& line, Map* map, StreamingState& state) {
+    size_t start = 0;
+    auto nextToken = [&line, &start]() {
+        size_t end = line.find(',', start);
+        std::string token = line.substr(start, end == std::string::npos ? std::string::npos : end - start);
+        start = end == std::string::npos ? line.size() + 1 : end + 1;
+        return token;
+    };
+
+    // Read the territory name
+    std::string territoryName = nextToken();
+    int id = state.IdOf(territoryName);
+
+    Territory *territory = state.territories[id];
+    if (territory == nullptr) {
+        territory = new Territory();
+        territory->name = territoryName;
+        state.territories[id] = territory;
+        std::string().swap(state.referencedNames[id]);
+    }
 
-        if (line == "[Continents]") {
-            inContinentsSection = true;
-            continue;
-        }
+    // Read the coordinates
+    territory->x = std::stoi(nextToken());
+    territory->y = std::stoi(nextToken());
 
-        if (line.empty()) {
+    // Read the parent Continent, creating it if its own line has not been read yet
+    std::string parentContinent = trim_white(nextToken());
+    auto continent = map->continents.insert({parentContinent, nullptr});
+    if (continent.second) {
+        continent.first->second = new Continent();
+        state.undefinedContinents.insert(parentContinent);
+    }
+    continent.first->second->childTerritories.insert({territoryName, territory});
+
+    // Read the adjacent territories, skipping empty ones such as after a trailing comma
+    while (start <= line.size()) {
+        std::string token = nextToken();
+        token.erase(token.begin(), std::find_if(token.begin(), token.end(), [](unsigned char ch) {
+            return !std::isspace(ch);
+        }));
+        if (token.empty()) {
             continue;
         }
 
-        if (line[0] == '[') {
-            inContinentsSection = false;
-            continue;
+        state.edgeSources.push_back(id);
+        state.edgeTargets.push_back(state.IdOf(token));
+    }
+}
+
+/**
+ * Finalises the graph once the file has been read: registers the territories under their final (name ordered) ids,
+ * builds the compressed adjacency arrays from the edge buffer with a counting sort and links the adjacentTerritories
+ * of every territory from them. Edges to territories that were never defined are dropped and reported, duplicate
+ * edges are dropped, and the adjacent territories of every territory are sorted by id, that is by name.
+ *
+ * @param map The Map object being loaded.
+ * @param state The bookkeeping of the current load.
+ */
+void MapLoader::FinalizeGraph(Map* map, StreamingState& state) {
+    std::string undefinedTerritory;
+    for (size_t id = 0; id < state.territories.size(); ++id) {
+        if (state.territories[id] == nullptr) {
+            undefinedTerritory = state.referencedNames[id];
+        } else {
+            map->territories.insert({state.territories[id]->name, state.territories[id]});
         }
+    }
 
-        if (inContinentsSection) {
-            std::istringstream iss(line);
+    // Hash tables are no longer needed, release them before the adjacency arrays are allocated
+    std::unordered_map<std::string, int>().swap(state.idsByName);
+    std::vector<std::string>().swap(state.referencedNames);
 
-            auto *newContinent = new Continent();
-            std::string continentName;
+    map->AssignTerritoryIds();
 
-            std::string token;
+    const int n = static_cast<int>(map->territoriesById.size());
+    std::vector<int>& offsets = map->adjacencyOffsets;
+    std::vector<int>& targets = map->adjacencyTargets;
 
-            // Read the continent name
-            std::getline(iss, token, '=');
-            continentName = token;
+    offsets.assign(n + 1, 0);
+    for (size_t e = 0; e < state.edgeSources.size(); ++e) {
+        if (state.territories[state.edgeTargets[e]] != nullptr) {
+            offsets[state.territories[state.edgeSources[e]]->id + 1]++;
+        }
+    }
+    for (int id = 0; id < n; ++id) {
+        offsets[id + 1] += offsets[id];
+    }
 
-            // Read the points for owning the continent
-            std::getline(iss, token, ',');
-            newContinent->bonusPoints = std::stoi(token);
+    targets.resize(offsets[n]);
+    std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t e = 0; e < state.edgeSources.size(); ++e) {
+        Territory *target = state.territories[state.edgeTargets[e]];
+        if (target != nullptr) {
+            targets[fill[state.territories[state.edgeSources[e]]->id]++] = target->id;
+        }
+    }
 
-            map->continents.insert({continentName, newContinent});
+    std::vector<int>().swap(state.edgeSources);
+    std::vector<int>().swap(state.edgeTargets);
+
+    // Sort the edges of every territory and drop the duplicates, then link the adjacent territories
+    int kept = 0;
+    for (int id = 0; id < n; ++id) {
+        Territory *territory = map->territoriesById[id];
+        int first = offsets[id];
+        offsets[id] = kept;
+
+        std::sort(targets.begin() + first, targets.begin() + offsets[id + 1]);
+        int last = static_cast<int>(std::unique(targets.begin() + first, targets.begin() + offsets[id + 1]) - targets.begin());
+        territory->adjacentTerritories.reserve(last - first);
+        for (int e = first; e < last; ++e) {
+            territory->adjacentTerritories.push_back(map->territoriesById[targets[e]]);
+            targets[kept++] = targets[e];
         }
     }
+    offsets[n] = kept;
+    targets.resize(kept);
+    targets.shrink_to_fit();
+
+    if (!undefinedTerritory.empty()) {
+        throw std::runtime_error("Adjacent territory was never defined: " + undefinedTerritory);
+    }
+
+    if (!state.undefinedContinents.empty()) {
+        throw std::runtime_error("Continent was never defined: " + *state.undefinedContinents.begin());
+    }
 }
 
 /**
- * Parses the territories section of a map file, creates Territory objects, and adds them to the Map.
+ * Captures the armies of every territory of the given map into freshly allocated pages.
  *
- * @param mapFile The input file stream containing the map data.
- * @param map The Map object to populate.
+ * @param map The Map to capture, its territory ids must be assigned.
  */
-void MapLoader::ParseTerritories(std::ifstream &mapFile, Map *map) {
-    mapFile.seekg(0, std::ios::beg);
-
-    std::string line;
-    bool inTerritoriesSection = false;
+MapSnapshot::MapSnapshot(const Map& map) : size(static_cast<int>(map.territoriesById.size())) {
+    for (int first = 0; first < size; first += PAGE_SIZE) {
+        auto page = std::make_shared<Page>();
+        page->reserve(PAGE_SIZE);
 
-    while (!mapFile.eof() && mapFile.peek() != EOF) {
-        std::getline(mapFile, line);
-
-        if (line == "[Territories]") {
-            inTerritoriesSection = true;
-            continue;
+        for (int id = first; id < size && id < first + PAGE_SIZE; ++id) {
+            page->push_back({map.territoriesById[id]->numberOfArmies, -1});
         }
 
-        if (line.empty()) {
-            continue;
-        }
+        pages.push_back(page);
+    }
+}
 
-        if (line[0] == '[') {
-            inTerritoriesSection = false;
-            continue;
-        }
+/**
+ * Creates a fork of this snapshot. Only the page pointers are copied, the pages themselves stay shared.
+ *
+ * @return The forked snapshot.
+ */
+MapSnapshot MapSnapshot::Fork() const {
+    return *this;
+}
 
-        if (inTerritoriesSection) {
-            std::istringstream iss(line);
+int MapSnapshot::Size() const {
+    return size;
+}
 
-            auto *newTerritory = new Territory();
-            std::string territoryName;
-            std::string parentContinent;
+const MapSnapshot::TerritoryState& MapSnapshot::Get(int territoryId) const {
+    return (*pages[territoryId / PAGE_SIZE])[territoryId % PAGE_SIZE];
+}
 
-            std::string token;
+/**
+ * Write access to the state of a territory. If the page holding it is still shared with another fork,
+ * the page is copied first so the write stays private to this snapshot.
+ *
+ * @param territoryId The id of the territory.
+ * @return The state of the territory.
+ */
+MapSnapshot::TerritoryState& MapSnapshot::Mutable(int territoryId) {
+    std::shared_ptr<Page>& page = pages[territoryId / PAGE_SIZE];
 
-            // Read the territory name
-            std::getline(iss, token, ',');
-            territoryName = token;
-            newTerritory->name = territoryName;
+    if (page.use_count() > 1) {
+        page = std::make_shared<Page>(*page); // Copy on write
+    }
 
-            // Read the coordinates
-            std::getline(iss, token, ',');
-            newTerritory->x = std::stoi(token);
+    return (*page)[territoryId % PAGE_SIZE];
+}
 
-            std::getline(iss, token, ',');
-            newTerritory->y = std::stoi(token);
+int MapSnapshot::GetArmies(int territoryId) const {
+    return Get(territoryId).numberOfArmies;
+}
 
-            // Read the parent Continent
-            std::getline(iss, token, ',');
-            parentContinent = trim_white(token);
+void MapSnapshot::SetArmies(int territoryId, int armies) {
+    if (GetArmies(territoryId) != armies) {
+        Mutable(territoryId).numberOfArmies = armies;
+    }
+}
 
-            // Read the adjacent territories
-            while (std::getline(iss, token, ',')) {
-                token.erase(token.begin(), std::find_if(token.begin(), token.end(), [](unsigned char ch) {
-                    return !std::isspace(ch);
-                }));
-                newTerritory->adjacentTerritories.insert({token, NULL}); // Set null for now, only attempt to update pointers once all territories are parsed
-            }
+int MapSnapshot::GetOwner(int territoryId) const {
+    return Get(territoryId).owner;
+}
 
-            map->continents.at(parentContinent)->childTerritories.insert({territoryName, newTerritory});
-            map->territories.insert({territoryName, newTerritory});
-        }
+void MapSnapshot::SetOwner(int territoryId, int owner) {
+    if (GetOwner(territoryId) != owner) {
+        Mutable(territoryId).owner = owner;
     }
-
-    PopulateAdjacentTerritories(map);
 }
 
 /**
- * Populates the adjacentTerritories pointers for each Territory by linking the adjacent territories that were parsed.
- * This ensures that each territory's adjacentTerritories point to the correct Territory object.
+ * Writes the armies held by the snapshot back into the territories of the given map.
  *
- * @param map The Map object containing the territories.
+ * @param map The Map the snapshot was taken from (or a copy of it).
  */
-void MapLoader::PopulateAdjacentTerritories(Map *map) {
-    for (auto& territory : map->territories) {
-        for (auto& adjacentTerritory : territory.second->adjacentTerritories) {
-            std::string name = adjacentTerritory.first;
-            adjacentTerritory.second = map->territories.at(name);
+void MapSnapshot::Restore(Map& map) const {
+    for (int id = 0; id < size && id < static_cast<int>(map.territoriesById.size()); ++id) {
+        map.territoriesById[id]->numberOfArmies = GetArmies(id);
+    }
+}
+
+int MapSnapshot::SharedPageCount(const MapSnapshot& other) const {
+    int shared = 0;
+
+    for (size_t i = 0; i < pages.size() && i < other.pages.size(); ++i) {
+        if (pages[i] == other.pages[i]) {
+            shared++;
         }
     }
+
+    return shared;
 }
@@ -1,9 +1,16 @@
 #ifndef MAP_H
 #define MAP_H
 
+#include <atomic>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <cstdint>
+#include <mutex>
 #include <string>
+#include <vector>
+
+#include "MapFiles/SpatialIndex.h"
 
 /**
  * The Territory class represents a territory in the game, containing information such as its name,
@@ -14,18 +21,30 @@ class Territory
 public:
     int numberOfArmies; ///< The number of armies present in this territory.
     int x, y; ///< The x and y coordinates of the center of the territory.
+    int id; ///< Dense index of the territory in its Map (see Map::territoriesById), -1 until the map is loaded.
     std::string name;
 
     /**
      * Default constructor
      */
-    Territory() : numberOfArmies(0), x(0), y(0) {}
+    Territory() : numberOfArmies(0), x(0), y(0), id(-1) {}
 
-    std::map<std::string, Territory *> adjacentTerritories;  ///< A map of adjacent territories.
+    /**
+     * The adjacent territories, without duplicates and in name order (which is also Territory::id order once the
+     * map is loaded). A flat vector rather than a name keyed map, so large maps do not pay a tree node and a copy
+     * of the name per edge.
+     */
+    std::vector<Territory *> adjacentTerritories;
+
+    /**
+     * @param other Another territory.
+     * @return true if the other territory is one of the adjacentTerritories.
+     */
+    bool IsAdjacentTo(const Territory* other) const;
 
     /**
      * Copy constructor for the Territory class.
-     * Creates a deep copy of the adjacentTerritories map, ensuring each pointer is properly duplicated.
+     * Creates a copy of the adjacentTerritories, whose pointers are updated by the Map copy constructor.
      *
      * @param other The Territory object to copy from.
      */
@@ -33,7 +52,7 @@ public:
 
     /**
     * Copy assignment operator for the Territory class.
-    * Assigns values from another Territory object, making sure to release and reallocate memory for the adjacentTerritories map.
+    * Assigns values from another Territory object, making sure to release and reallocate memory for the adjacentTerritories.
     *
     * @param other The Territory object to assign from.
     * @return A reference to the current Territory object.
@@ -106,12 +125,110 @@ public:
 
     std::map<std::string, Continent *> continents; ///< A map of the continents on the map.
     std::map<std::string, Territory *> territories; ///< A map of all territories on the map.
+    std::vector<Territory *> territoriesById; ///< All territories indexed by Territory::id.
+
+    /**
+     * Adjacency graph in compressed sparse row form, by Territory::id: the ids adjacent to territory i are
+     * adjacencyTargets[adjacencyOffsets[i]] to adjacencyTargets[adjacencyOffsets[i + 1] - 1].
+     * Built by the MapLoader, mirrors the adjacentTerritories of every territory.
+     */
+    std::vector<int> adjacencyOffsets;
+    std::vector<int> adjacencyTargets; ///< See adjacencyOffsets.
 
     /**
      * Default constructor
      */
     Map() = default;
 
+    /**
+     * Assigns a dense id to every territory (in name order) and rebuilds territoriesById.
+     * Called by the MapLoader once a map is parsed and by the copy operations.
+     */
+    void AssignTerritoryIds();
+
+    /**
+     * Rebuilds adjacencyOffsets and adjacencyTargets from the adjacentTerritories of every territory.
+     * Only needed for maps assembled by hand rather than loaded by the MapLoader, or whose adjacentTerritories
+     * were edited.
+     */
+    void BuildAdjacencyArrays();
+
+    /**
+     * Identifies the territories and adjacency of the map as they are now. Every map starts with a generation no
+     * other map has, and gets a new one when its territory ids are assigned (on load and copy) and when its
+     * adjacency arrays are rebuilt. Caches derived from a map are keyed on its generation rather than on its
+     * address, which a map loaded after another one was deleted may reuse.
+     *
+     * @return The generation of the map.
+     */
+    std::uint64_t GetGeneration() const;
+
+    /**
+     * Grid over the territory coordinates for proximity queries. It is built on the first call, after the map is
+     * loaded, and rebuilt on the first call after the territory ids are reassigned.
+     *
+     * @return The spatial index of the territories.
+     */
+    const SpatialIndex& GetSpatialIndex() const;
+
+    static const int DISTANCE_TABLE_LIMIT = 2048; ///< Largest map (in territories) for which distance tables are built.
+    static const std::uint16_t UNREACHABLE = 0xFFFF; ///< Hop distance stored for territories that cannot be reached.
+    static const int DISTANCE_ROW_CACHE = 64; ///< Rows kept by the on-demand searches of maps without distance tables.
+
+    /**
+     * Precomputes the hop distance and the next hop between every pair of territories by running one breadth-first
+     * search per territory over the adjacency graph. The searches are spread over the available hardware threads.
+     * The tables take 4 * N^2 bytes, so they are only built for maps of at most maxTerritories territories; larger
+     * maps answer HopDistance() and NextHop() with one breadth-first search per source territory instead, keeping
+     * the rows of the last DISTANCE_ROW_CACHE sources searched.
+     * Must be called after the map is loaded (and ideally validated); copies of the map keep the tables.
+     *
+     * @param maxTerritories The largest number of territories for which the tables are built.
+     * @return true if the tables were built, false if the map is too large or empty.
+     */
+    bool PrecomputeDistances(int maxTerritories = DISTANCE_TABLE_LIMIT);
+
+    /**
+     * @return true if PrecomputeDistances() built the distance tables for this map.
+     */
+    bool HasDistanceTable() const;
+
+    /**
+     * @return true if PrecomputeDistances() was called on this map, so that HopDistance() and NextHop() answer from
+     * the distance tables or, above the table limit, from on-demand searches.
+     */
+    bool HasDistances() const;
+
+    /**
+     * Looks up the number of hops on a shortest path between two territories, in O(1) from the distance tables.
+     *
+     * @param from The source territory.
+     * @param to The destination territory.
+     * @return The hop distance, or -1 if the destination is unreachable or the distances were not precomputed.
+     */
+    int HopDistance(const Territory* from, const Territory* to) const;
+
+    /**
+     * Looks up the first territory to move to on a shortest path between two territories, in O(1) from the
+     * distance tables.
+     *
+     * @param from The source territory.
+     * @param to The destination territory.
+     * @return The adjacent territory to move to, or nullptr if unreachable, from == to, or the distances were not
+     * precomputed.
+     */
+    Territory* NextHop(const Territory* from, const Territory* to) const;
+
+    /**
+     * Computes the hop distance of every territory to the closest of several source territories, in one
+     * breadth-first search over the adjacency graph that only enters passable territories.
+     *
+     * @param sources The ids of the source territories, at distance 0.
+     * @param passable Marks by territory id the territories the search may enter.
+     * @param distances Receives the hop distance of every territory to the closest source, -1 if it is not reached.
+     */
+    void MultiSourceDistances(const std::vector<int>& sources, const std::vector<char>& passable, std::vector<int>& distances) const;
+
     /**
      * Validates the map by checking if:
      * 1) The map is a connected graph.
@@ -171,6 +288,123 @@ private:
      * @param other The Map object to copy from.
      */
     void DeepCopyMapData(const Map& other);
+
+    static std::atomic<std::uint64_t> generations; ///< Generations handed out so far, by every map.
+    std::uint64_t generation = ++generations; ///< See GetGeneration().
+
+    mutable SpatialIndex spatialIndex; ///< See GetSpatialIndex().
+    mutable bool spatialIndexBuilt = false; ///< spatialIndex holds the current territories.
+    mutable std::mutex spatialIndexMutex; ///< Guards the first build of spatialIndex.
+
+    std::vector<std::uint16_t> hopDistances; ///< N x N hop distances, row-major by source territory id.
+    std::vector<std::uint16_t> nextHops; ///< N x N id of the first territory on a shortest path, row-major by source id.
+
+    /**
+     * Hop distances and next hops from one source territory, by territory id, -1 where unreachable.
+     */
+    struct DistanceRow {
+        int source;
+        std::vector<int> distances;
+        std::vector<int> nextHops;
+    };
+
+    bool distancesOnDemand = false; ///< The map is above the table limit, distances are searched per source.
+    mutable std::mutex distanceRowsMutex; ///< Guards distanceRows, which the strategies of several games may share.
+    mutable std::vector<std::shared_ptr<const DistanceRow>> distanceRows; ///< Rows of the last sources searched.
+    mutable size_t nextDistanceRow = 0; ///< Slot of distanceRows replaced by the next search once it is full.
+
+    /**
+     * @param source The id of a source territory.
+     * @return The row of the source, searched if it is not in distanceRows.
+     */
+    std::shared_ptr<const DistanceRow> DistanceRowFrom(int source) const;
+};
+
+/**
+ * The MapSnapshot class holds a forkable copy of the mutable territory state of a Map (armies and owner),
+ * indexed by Territory::id. The state is split into fixed-size pages that are shared between forks, and a page
+ * is only copied the first time a fork writes to it. Forking is therefore O(number of pages) and territories
+ * that never diverge are never duplicated, which makes it cheap to branch the game state for lookahead.
+ *
+ * Forks may be used from different threads as long as the snapshot they were forked from outlives them.
+ */
+class MapSnapshot
+{
+public:
+    /**
+     * Mutable state of a single territory.
+     */
+    struct TerritoryState
+    {
+        int numberOfArmies; ///< The number of armies present in the territory.
+        int owner; ///< Index of the owning player, -1 if the territory is unowned.
+    };
+
+    static const int PAGE_SIZE = 64; ///< Number of territories stored per shared page.
+
+    /**
+     * Default constructor, creates an empty snapshot.
+     */
+    MapSnapshot() : size(0) {}
+
+    /**
+     * Captures the armies of every territory of the given map. Owners are left unset (-1).
+     *
+     * @param map The Map to capture, its territory ids must be assigned.
+     */
+    explicit MapSnapshot(const Map& map);
+
+    /**
+     * Creates a fork of this snapshot. The fork shares all pages with this snapshot until one of them writes.
+     *
+     * @return The forked snapshot.
+     */
+    MapSnapshot Fork() const;
+
+    /**
+     * @return The number of territories in the snapshot.
+     */
+    int Size() const;
+
+    /**
+     * Read access to the state of a territory.
+     *
+     * @param territoryId The id of the territory.
+     * @return The state of the territory.
+     */
+    const TerritoryState& Get(int territoryId) const;
+
+    /**
+     * Write access to the state of a territory, copying its page first if it is shared with another fork.
+     *
+     * @param territoryId The id of the territory.
+     * @return The state of the territory, private to this snapshot.
+     */
+    TerritoryState& Mutable(int territoryId);
+
+    int GetArmies(int territoryId) const;
+    void SetArmies(int territoryId, int armies);
+    int GetOwner(int territoryId) const;
+    void SetOwner(int territoryId, int owner);
+
+    /**
+     * Writes the armies held by the snapshot back into the territories of the given map.
+     *
+     * @param map The Map the snapshot was taken from (or a copy of it).
+     */
+    void Restore(Map& map) const;
+
+    /**
+     * @param other Another snapshot of the same map.
+     * @return The number of pages physically shared between this snapshot and the other one.
+     */
+    int SharedPageCount(const MapSnapshot& other) const;
+
+private:
+    typedef std::vector<TerritoryState> Page;
+
+    std::vector<std::shared_ptr<Page>> pages; ///< Territory state pages, shared between forks.
+    int size; ///< Number of territories in the snapshot.
 };
 
 /**
@@ -188,36 +422,42 @@ public:
     static void LoadMap(const std::string& sFileName, Map* map);
 
 private:
+    struct StreamingState;
+
     /**
-     * Parses metadata from the map file.
+     * Parses a line of the [Map] section.
      *
-     * @param mapFile The input file stream.
+     * @param line The line to parse.
      * @param map The Map object to populate with metadata.
      */
-    static void ParseMapMetaData(std::ifstream& mapFile, Map* map);
+    static void ParseMapMetaData(const std::string& line, Map* map);
 
     /**
-     * Parses the continents section from the map file and populates the Map object with continents.
+     * Parses a line of the [Continents] section and adds the continent to the Map object.
      *
-     * @param mapFile The input file stream.
+     * @param line The line to parse.
      * @param map The Map object to populate with continents.
+     * @param state The bookkeeping of the current load.
      */
-    static void ParseContinents(std::ifstream& mapFile, Map* map);
+    static void ParseContinent(const std::string& line, Map* map, StreamingState& state);
 
     /**
-     * Parses the territories section from the map file and populates the Map object with territories.
+     * Parses a line of the [Territories] section, adds the territory to the Map object and buffers its edges.
      *
-     * @param mapFile The input file stream.
+     * @param line The line to parse.
      * @param map The Map object to populate with territories.
+     * @param state The bookkeeping of the current load.
      */
-    static void ParseTerritories(std::ifstream& mapFile, Map* map);
+    static void ParseTerritory(const std::string& line, Map* map, StreamingState& state);
 
     /**
-     * Populates the adjacentTerritories pointers for each territory, linking adjacent territories that were parsed.
+     * Assigns the final territory ids, builds the adjacency arrays from the buffered edges and links the
+     * adjacentTerritories of every territory.
      *
      * @param map The Map object containing the territories.
+     * @param state The bookkeeping of the current load.
      */
-    static void PopulateAdjacentTerritories(Map* map);
+    static void FinalizeGraph(Map* map, StreamingState& state);
 };
 
 #endif
\ No newline at end of file
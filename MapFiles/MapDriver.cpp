@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <random>
 
 #include "MapFiles/MapDriver.h"
 
@@ -40,4 +42,191 @@ int testLoadMaps()
     }
 
     return 0;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Demonstrates copy-on-write map snapshots.
+ *
+ * Loads a map, takes a snapshot of its territory state, forks it and modifies a single territory in the fork.
+ * Only the page holding that territory is copied, the other pages stay shared with the original snapshot.
+ * The original snapshot is then restored into the map to show that the fork did not affect it.
+ */
+void testMapSnapshots()
+{
+    Map map;
+    MapLoader::LoadMap(MAP_FILES[1], &map);
+
+    if (map.territoriesById.empty()) {
+        std::cerr << "Error: Could not load " << MAP_FILES[1] << "\n";
+        return;
+    }
+
+    for (Territory *territory : map.territoriesById) {
+        territory->numberOfArmies = 5;
+    }
+
+    MapSnapshot original(map);
+    MapSnapshot fork = original.Fork();
+
+    std::cout << "Snapshot of " << original.Size() << " territories, forked sharing "
+              << fork.SharedPageCount(original) << " page(s).\n";
+
+    Territory *changed = map.territoriesById.back();
+    fork.SetArmies(changed->id, 42);
+
+    std::cout << "After writing to " << changed->name << " in the fork: " << fork.SharedPageCount(original)
+              << " page(s) still shared.\n";
+    std::cout << changed->name << " has " << original.GetArmies(changed->id) << " armies in the original and "
+              << fork.GetArmies(changed->id) << " armies in the fork.\n";
+
+    fork.Restore(map);
+    std::cout << "Map after restoring the fork: " << changed->name << " has " << changed->numberOfArmies << " armies.\n";
+
+    original.Restore(map);
+    std::cout << "Map after restoring the original: " << changed->name << " has " << changed->numberOfArmies << " armies.\n";
+}
+/**
+ * @brief Checks the hop distances and next hops of a map against a breadth-first search over adjacentTerritories.
+ *
+ * The map is checked once with its distance tables and once above the table limit, where every source territory
+ * is searched on demand. A next hop is correct if it is adjacent to the source and one hop closer to the destination,
+ * since several shortest paths may exist.
+ */
+void testDistanceTables()
+{
+    Map tabled;
+    MapLoader::LoadMap(MAP_FILES[3], &tabled);
+
+    if (tabled.territoriesById.empty()) {
+        std::cerr << "Error: Could not load " << MAP_FILES[3] << "\n";
+        return;
+    }
+
+    Map onDemand(tabled);
+    std::cout << "Distance tables built: " << (tabled.PrecomputeDistances() ? "yes" : "no") << "\n";
+    std::cout << "Distance tables built with a limit of 1 territory: " << (onDemand.PrecomputeDistances(1) ? "yes" : "no")
+              << ", distances searched on demand: " << (onDemand.HasDistances() ? "yes" : "no") << "\n";
+
+    const int n = static_cast<int>(tabled.territoriesById.size());
+    Map *maps[2] = {&tabled, &onDemand};
+    int distanceMismatches[2] = {0, 0};
+    int nextHopMismatches[2] = {0, 0};
+
+    for (int source = 0; source < n; ++source) {
+        std::vector<int> expected(n, -1);
+        std::vector<Territory *> frontier = {tabled.territoriesById[source]};
+        expected[source] = 0;
+        for (size_t head = 0; head < frontier.size(); ++head) {
+            for (Territory *adjacent : frontier[head]->adjacentTerritories) {
+                if (expected[adjacent->id] < 0) {
+                    expected[adjacent->id] = expected[frontier[head]->id] + 1;
+                    frontier.push_back(adjacent);
+                }
+            }
+        }
+
+        for (int m = 0; m < 2; ++m) {
+            Territory *from = maps[m]->territoriesById[source];
+            for (int target = 0; target < n; ++target) {
+                Territory *to = maps[m]->territoriesById[target];
+                distanceMismatches[m] += maps[m]->HopDistance(from, to) != expected[target];
+
+                Territory *next = maps[m]->NextHop(from, to);
+                bool correct;
+                if (expected[target] <= 0) {
+                    correct = next == nullptr;
+                } else {
+                    correct = next != nullptr && from->IsAdjacentTo(next)
+                              && maps[m]->HopDistance(next, to) == expected[target] - 1;
+                }
+                nextHopMismatches[m] += !correct;
+            }
+        }
+    }
+
+    const char *names[2] = {"Distance tables", "On-demand searches"};
+    for (int m = 0; m < 2; ++m) {
+        std::cout << names[m] << ": " << n * n << " pairs, " << distanceMismatches[m] << " wrong distance(s), "
+                  << nextHopMismatches[m] << " wrong next hop(s).\n";
+    }
+}
+
+/**
+ * @brief Checks the queries of the spatial index of a map against a scan of every territory.
+ *
+ * Queries random points over and around the map: the nearest territory, the nearest territory with an odd id,
+ * the territories within a radius and the territories within a rectangle. Nearest territories are compared by
+ * their distance to the point, since several territories may be equally close.
+ */
+void testSpatialIndex()
+{
+    Map map;
+    MapLoader::LoadMap(MAP_FILES[1], &map);
+
+    if (map.territoriesById.empty()) {
+        std::cerr << "Error: Could not load " << MAP_FILES[1] << "\n";
+        return;
+    }
+
+    int minX = map.territoriesById[0]->x, maxX = minX, minY = map.territoriesById[0]->y, maxY = minY;
+    for (const Territory *territory : map.territoriesById) {
+        minX = std::min(minX, territory->x);
+        maxX = std::max(maxX, territory->x);
+        minY = std::min(minY, territory->y);
+        maxY = std::max(maxY, territory->y);
+    }
+    const int margin = std::max(maxX - minX, maxY - minY) / 4 + 1;
+
+    auto squaredDistance = [](int x, int y, const Territory *territory) {
+        long long dx = static_cast<long long>(territory->x) - x;
+        long long dy = static_cast<long long>(territory->y) - y;
+        return dx * dx + dy * dy;
+    };
+    auto oddId = [](const Territory *territory) { return territory->id % 2 == 1; };
+    auto sorted = [](std::vector<Territory *> territories) {
+        std::sort(territories.begin(), territories.end());
+        return territories;
+    };
+
+    const SpatialIndex &index = map.GetSpatialIndex();
+    std::mt19937 random(345);
+    std::uniform_int_distribution<int> pickX(minX - margin, maxX + margin);
+    std::uniform_int_distribution<int> pickY(minY - margin, maxY + margin);
+    std::uniform_int_distribution<int> pickRadius(0, margin * 2);
+
+    const int queries = 1000;
+    int nearestMismatches = 0, filteredMismatches = 0, radiusMismatches = 0, rectMismatches = 0;
+    for (int q = 0; q < queries; ++q) {
+        const int x = pickX(random), y = pickY(random), radius = pickRadius(random);
+
+        long long nearest = -1, nearestOdd = -1;
+        std::vector<Territory *> inRadius, inRect;
+        for (Territory *territory : map.territoriesById) {
+            const long long distance = squaredDistance(x, y, territory);
+            nearest = nearest < 0 ? distance : std::min(nearest, distance);
+            if (oddId(territory)) {
+                nearestOdd = nearestOdd < 0 ? distance : std::min(nearestOdd, distance);
+            }
+            if (distance <= static_cast<long long>(radius) * radius) {
+                inRadius.push_back(territory);
+            }
+            if (territory->x >= x - radius && territory->x <= x + radius && territory->y >= y && territory->y <= y + radius) {
+                inRect.push_back(territory);
+            }
+        }
+
+        Territory *found = index.Nearest(x, y);
+        nearestMismatches += found == nullptr || squaredDistance(x, y, found) != nearest;
+        Territory *foundOdd = index.Nearest(x, y, oddId);
+        filteredMismatches += foundOdd == nullptr ? nearestOdd >= 0
+                                                  : !oddId(foundOdd) || squaredDistance(x, y, foundOdd) != nearestOdd;
+        radiusMismatches += sorted(index.WithinRadius(x, y, radius)) != sorted(inRadius);
+        rectMismatches += sorted(index.WithinRect(x - radius, y, x + radius, y + radius)) != sorted(inRect);
+    }
+
+    std::cout << queries << " queries over " << map.territoriesById.size() << " territories of " << MAP_FILES[1] << ":\n"
+              << "Nearest: " << nearestMismatches << " mismatch(es).\n"
+              << "Nearest with an odd id: " << filteredMismatches << " mismatch(es).\n"
+              << "Within radius: " << radiusMismatches << " mismatch(es).\n"
+              << "Within rectangle: " << rectMismatches << " mismatch(es).\n";
+}
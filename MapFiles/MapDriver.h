@@ -23,4 +23,10 @@ const std::string MAP_FILES[7] = {
 
 int testLoadMaps();
 
+void testMapSnapshots();
+
+void testDistanceTables();
+
+void testSpatialIndex();
+
 #endif //COMP345_WARZONE_MAPDRIVER_H
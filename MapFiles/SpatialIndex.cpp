@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+#include "MapFiles/SpatialIndex.h"
+#include "MapFiles/Map.h"
+
+/**
+ * Squared euclidean distance between a point and the center of a territory.
+ */
+static long long SquaredDistance(int x, int y, const Territory* territory) {
+    long long dx = static_cast<long long>(territory->x) - x;
+    long long dy = static_cast<long long>(territory->y) - y;
+    return dx * dx + dy * dy;
+}
+
+SpatialIndex::SpatialIndex() : originX(0), originY(0), cellSize(1), columns(0), rows(0) {}
+
+/**
+ * Builds the grid. The bounding box of the territories is split into square cells sized so that there are
+ * about two territories per cell, then the territories are bucketed by cell with a counting sort.
+ *
+ * @param territories The territories to index.
+ */
+void SpatialIndex::Build(const std::vector<Territory *>& territories) {
+    Clear();
+
+    if (territories.empty()) {
+        return;
+    }
+
+    int minX = INT_MAX, minY = INT_MAX, maxX = INT_MIN, maxY = INT_MIN;
+    for (const Territory* territory : territories) {
+        minX = std::min(minX, territory->x);
+        minY = std::min(minY, territory->y);
+        maxX = std::max(maxX, territory->x);
+        maxY = std::max(maxY, territory->y);
+    }
+
+    double width = static_cast<double>(maxX) - minX + 1;
+    double height = static_cast<double>(maxY) - minY + 1;
+    double targetCells = std::max(1.0, territories.size() / 2.0);
+
+    originX = minX;
+    originY = minY;
+    cellSize = std::max(1, static_cast<int>(std::ceil(std::sqrt(width * height / targetCells))));
+    columns = static_cast<int>(width / cellSize) + 1;
+    rows = static_cast<int>(height / cellSize) + 1;
+
+    // Counting sort of the territories by cell
+    cellOffsets.assign(static_cast<size_t>(columns) * rows + 1, 0);
+    for (const Territory* territory : territories) {
+        cellOffsets[CellRow(territory->y) * columns + CellColumn(territory->x) + 1]++;
+    }
+    for (size_t cell = 1; cell < cellOffsets.size(); ++cell) {
+        cellOffsets[cell] += cellOffsets[cell - 1];
+    }
+
+    std::vector<int> fill(cellOffsets.begin(), cellOffsets.end() - 1);
+    cellTerritories.resize(territories.size());
+    for (Territory* territory : territories) {
+        cellTerritories[fill[CellRow(territory->y) * columns + CellColumn(territory->x)]++] = territory;
+    }
+}
+
+void SpatialIndex::Clear() {
+    cellOffsets.clear();
+    cellTerritories.clear();
+    columns = 0;
+    rows = 0;
+}
+
+bool SpatialIndex::Empty() const {
+    return cellTerritories.empty();
+}
+
+Territory* SpatialIndex::Nearest(int x, int y) const {
+    return Nearest(x, y, [](const Territory*) { return true; });
+}
+
+/**
+ * Finds the closest accepted territory by visiting the grid in square rings around the cell of the point.
+ * Every territory in ring r + 1 is at least r cells away from the point, so the search stops as soon as the
+ * best candidate found so far is closer than that.
+ */
+Territory* SpatialIndex::Nearest(int x, int y, const std::function<bool(const Territory*)>& accept) const {
+    if (Empty()) {
+        return nullptr;
+    }
+
+    int column = std::min(std::max(CellColumn(x), 0), columns - 1);
+    int row = std::min(std::max(CellRow(y), 0), rows - 1);
+    int maxRing = std::max(std::max(column, columns - 1 - column), std::max(row, rows - 1 - row));
+
+    Territory* best = nullptr;
+    long long bestDistance = 0;
+
+    for (int ring = 0; ring <= maxRing; ++ring) {
+        for (int r = row - ring; r <= row + ring; ++r) {
+            if (r < 0 || r >= rows) {
+                continue;
+            }
+
+            // Only the border of the ring is new, inner rows just contribute their two end cells
+            bool fullRow = (r == row - ring || r == row + ring);
+            int step = fullRow || ring == 0 ? 1 : 2 * ring;
+
+            for (int c = column - ring; c <= column + ring; c += step) {
+                if (c < 0 || c >= columns) {
+                    continue;
+                }
+
+                int cell = r * columns + c;
+                for (int i = cellOffsets[cell]; i < cellOffsets[cell + 1]; ++i) {
+                    Territory* candidate = cellTerritories[i];
+                    long long distance = SquaredDistance(x, y, candidate);
+                    if ((best == nullptr || distance < bestDistance) && accept(candidate)) {
+                        best = candidate;
+                        bestDistance = distance;
+                    }
+                }
+            }
+        }
+
+        long long reach = static_cast<long long>(ring) * cellSize;
+        if (best != nullptr && bestDistance <= reach * reach) {
+            break;
+        }
+    }
+
+    return best;
+}
+
+std::vector<Territory *> SpatialIndex::WithinRadius(int x, int y, int radius) const {
+    std::vector<Territory *> found;
+    long long squaredRadius = static_cast<long long>(radius) * radius;
+
+    for (Territory* territory : WithinRect(x - radius, y - radius, x + radius, y + radius)) {
+        if (SquaredDistance(x, y, territory) <= squaredRadius) {
+            found.push_back(territory);
+        }
+    }
+
+    return found;
+}
+
+std::vector<Territory *> SpatialIndex::WithinRect(int minX, int minY, int maxX, int maxY) const {
+    std::vector<Territory *> found;
+    if (Empty() || minX > maxX || minY > maxY) {
+        return found;
+    }
+
+    int firstColumn = std::max(CellColumn(minX), 0);
+    int lastColumn = std::min(CellColumn(maxX), columns - 1);
+    int firstRow = std::max(CellRow(minY), 0);
+    int lastRow = std::min(CellRow(maxY), rows - 1);
+
+    for (int r = firstRow; r <= lastRow; ++r) {
+        for (int c = firstColumn; c <= lastColumn; ++c) {
+            int cell = r * columns + c;
+            for (int i = cellOffsets[cell]; i < cellOffsets[cell + 1]; ++i) {
+                Territory* territory = cellTerritories[i];
+                if (territory->x >= minX && territory->x <= maxX && territory->y >= minY && territory->y <= maxY) {
+                    found.push_back(territory);
+                }
+            }
+        }
+    }
+
+    return found;
+}
+
+int SpatialIndex::CellColumn(int x) const {
+    long long offset = static_cast<long long>(x) - originX;
+    return static_cast<int>(offset >= 0 ? offset / cellSize : (offset - cellSize + 1) / cellSize);
+}
+
+int SpatialIndex::CellRow(int y) const {
+    long long offset = static_cast<long long>(y) - originY;
+    return static_cast<int>(offset >= 0 ? offset / cellSize : (offset - cellSize + 1) / cellSize);
+}
@@ -0,0 +1,89 @@
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include <functional>
+#include <vector>
+
+class Territory;
+
+/**
+ * The SpatialIndex class indexes territories by the coordinates of their center (Territory::x and Territory::y)
+ * in a uniform grid, so proximity queries do not have to scan every territory of the map.
+ * Cells are sized for about two territories each and are stored contiguously, one bucket per cell.
+ */
+class SpatialIndex
+{
+public:
+    /**
+     * Default constructor, creates an empty index.
+     */
+    SpatialIndex();
+
+    /**
+     * Builds the grid over the given territories, replacing any previous content.
+     *
+     * @param territories The territories to index.
+     */
+    void Build(const std::vector<Territory *>& territories);
+
+    /**
+     * Removes every territory from the index.
+     */
+    void Clear();
+
+    /**
+     * @return true if no territory is indexed.
+     */
+    bool Empty() const;
+
+    /**
+     * Finds the territory closest to a point.
+     *
+     * @param x The x coordinate of the point.
+     * @param y The y coordinate of the point.
+     * @return The closest territory, or nullptr if the index is empty.
+     */
+    Territory* Nearest(int x, int y) const;
+
+    /**
+     * Finds the territory closest to a point among the territories accepted by a filter,
+     * e.g. the nearest territory owned by an enemy.
+     *
+     * @param x The x coordinate of the point.
+     * @param y The y coordinate of the point.
+     * @param accept Predicate selecting the candidate territories.
+     * @return The closest accepted territory, or nullptr if there is none.
+     */
+    Territory* Nearest(int x, int y, const std::function<bool(const Territory*)>& accept) const;
+
+    /**
+     * Finds every territory whose center lies within a radius of a point.
+     *
+     * @param x The x coordinate of the point.
+     * @param y The y coordinate of the point.
+     * @param radius The search radius.
+     * @return The territories within the radius, in no particular order.
+     */
+    std::vector<Territory *> WithinRadius(int x, int y, int radius) const;
+
+    /**
+     * Finds every territory whose center lies within an axis aligned rectangle (bounds included),
+     * e.g. the territories to draw in a map viewer tile.
+     *
+     * @return The territories within the rectangle, in no particular order.
+     */
+    std::vector<Territory *> WithinRect(int minX, int minY, int maxX, int maxY) const;
+
+private:
+    int CellColumn(int x) const;
+    int CellRow(int y) const;
+
+    int originX, originY; ///< Coordinates of the corner of the first cell.
+    int cellSize; ///< Width and height of a cell.
+    int columns, rows; ///< Dimensions of the grid in cells.
+
+    std::vector<int> cellOffsets; ///< Start of each cell's bucket in cellTerritories (columns * rows + 1 entries).
+    std::vector<Territory *> cellTerritories; ///< Territories grouped by cell.
+};
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef BATTLE_KERNEL_H
+#define BATTLE_KERNEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Resolves battles between attacking and defending armies.
+ *
+ * Every round of a battle rolls two numbers between 1 and 100: a defending army is killed on a roll below 60 and
+ * an attacking army on a roll below 70, until one side has no army left. Rolls come from a counter based
+ * generator: the rolls of round n of a battle are a hash of the seed, the battle's stream and n, so no generator
+ * state is carried from one roll to the next. A battle therefore has the same outcome whether it is resolved on
+ * its own or in a batch, and the rounds of a batch are computed for all its battles at once in a branch free loop
+ * over contiguous arrays that the compiler can vectorize.
+ */
+class BattleKernel
+{
+public:
+    /**
+     * @brief A defending army is killed on a roll below this value.
+     */
+    static const int DEFENDER_LOSS_BELOW = 60;
+
+    /**
+     * @brief An attacking army is killed on a roll below this value.
+     */
+    static const int ATTACKER_LOSS_BELOW = 70;
+
+    /**
+     * @brief Resolves one battle.
+     *
+     * @param attackers The attacking armies, replaced by the attacking armies left.
+     * @param defenders The defending armies, replaced by the defending armies left.
+     * @param stream Identifies the battle, battles with the same stream and seed roll the same numbers.
+     * @param seed The seed of the rolls.
+     */
+    static void resolve(int &attackers, int &defenders, std::uint64_t stream, std::uint64_t seed);
+
+    /**
+     * @brief Resolves a batch of battles, each with the outcome it would have on its own.
+     *
+     * @param attackers The attacking armies of every battle, replaced by the attacking armies left.
+     * @param defenders The defending armies of every battle, replaced by the defending armies left.
+     * @param streams The stream of every battle.
+     * @param count The number of battles.
+     * @param seed The seed of the rolls.
+     */
+    static void resolve(int *attackers, int *defenders, const std::uint64_t *streams, std::size_t count,
+                        std::uint64_t seed);
+
+    /**
+     * @param source The name of the territory the attack comes from.
+     * @param target The name of the attacked territory.
+     * @return The stream of a battle between the two territories.
+     */
+    static std::uint64_t stream(const std::string &source, const std::string &target);
+
+    /**
+     * @param source The name of the territory the attack comes from.
+     * @param target The name of the attacked territory.
+     * @param sequence The position of the attacking order in its execution phase.
+     * @return The stream of the battle fought by the order at this position of its phase, so that two attacks
+     * between the same territories in a phase roll different numbers.
+     */
+    static std::uint64_t stream(const std::string &source, const std::string &target, int sequence);
+
+    /**
+     * @return The seed of the battles fought now, which changes every second. On a seeded thread, the seed of the
+     * next execution phase of its game instead. The engine draws it once per phase on the thread playing the game,
+     * so the battles of a phase roll the same numbers on whichever thread they are fought.
+     */
+    static std::uint64_t currentSeed();
+
+    /**
+     * @brief Seeds the battles fought by the calling thread, so that a game is replayed with the same rolls. The
+     * battles then derive their seed from this seed and the number of seeds handed out since.
+     *
+     * @param seed The seed of the game played by the calling thread.
+     */
+    static void seedThread(std::uint64_t seed);
+
+    /**
+     * @brief Seeds the battles fought by the calling thread from the clock again.
+     */
+    static void unseedThread();
+};
+
+/**
+ * @brief The outcome of a battle resolved ahead of the order that fights it.
+ */
+struct BattleOutcome
+{
+    int attackers = -1; ///< Attacking armies the battle was resolved for, -1 if none was.
+    int defenders = -1; ///< Defending armies the battle was resolved for.
+    int attackersLeft = 0;
+    int defendersLeft = 0;
+
+    /**
+     * @param attackingArmies The attacking armies of the battle about to be fought.
+     * @param defendingArmies The defending armies of the battle about to be fought.
+     * @return Whether the battle was resolved for these armies.
+     */
+    bool resolvedFor(int attackingArmies, int defendingArmies) const;
+};
+
+/**
+ * @brief Collects the battles of orders that are about to be executed and resolves them in one batch.
+ */
+class BattleBatch
+{
+public:
+    /**
+     * @brief Adds a battle to the batch.
+     *
+     * @param outcome Receives the outcome of the battle when the batch is resolved.
+     * @param attackers The attacking armies.
+     * @param defenders The defending armies.
+     * @param stream The stream of the battle.
+     */
+    void add(BattleOutcome *outcome, int attackers, int defenders, std::uint64_t stream);
+
+    /**
+     * @return The number of battles in the batch.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Resolves every battle of the batch, hands the outcomes out and empties the batch.
+     *
+     * @param seed The seed of the rolls.
+     */
+    void resolve(std::uint64_t seed);
+
+private:
+    std::vector<BattleOutcome *> outcomes;
+    std::vector<int> attackers;
+    std::vector<int> defenders;
+    std::vector<std::uint64_t> streams;
+};
+
+#endif
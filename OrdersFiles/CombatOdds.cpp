@@ -0,0 +1,206 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "CombatOdds.h"
+#include "BattleKernel.h"
+
+const int CombatOdds::EXACT_LIMIT;
+
+namespace
+{
+    // Probabilities that a round kills a defending and an attacking army, rolls being between 1 and 100
+    const double DEFENDER_LOSS = (BattleKernel::DEFENDER_LOSS_BELOW - 1) / 100.0;
+    const double ATTACKER_LOSS = (BattleKernel::ATTACKER_LOSS_BELOW - 1) / 100.0;
+
+    /**
+     * @return The mean of the positive part of a normal variable.
+     */
+    double expectedPositivePart(double mean, double variance)
+    {
+        const double deviation = std::sqrt(variance);
+        const double z = mean / deviation;
+        return mean * 0.5 * std::erfc(-z / std::sqrt(2.0)) + deviation * std::exp(-z * z / 2) / std::sqrt(2 * std::acos(-1.0));
+    }
+
+    /**
+     * @brief The odds of every battle of up to CombatOdds::EXACT_LIMIT armies per side, indexed by attackers then
+     * defenders.
+     */
+    class OddsTable
+    {
+    public:
+        OddsTable() : size(CombatOdds::EXACT_LIMIT + 1), cells(size * size)
+        {
+            // Probabilities of the ways a round can change the armies, given that it changes them
+            const double change = 1 - (1 - DEFENDER_LOSS) * (1 - ATTACKER_LOSS);
+            const double both = DEFENDER_LOSS * ATTACKER_LOSS / change;
+            const double defenderOnly = DEFENDER_LOSS * (1 - ATTACKER_LOSS) / change;
+            const double attackerOnly = ATTACKER_LOSS * (1 - DEFENDER_LOSS) / change;
+
+            for (int a = 0; a < size; ++a)
+            {
+                for (int d = 0; d < size; ++d)
+                {
+                    BattleOdds &odds = cells[a * size + d];
+
+                    if (d == 0)
+                    {
+                        odds.win = 1;
+                        odds.attackersLeft = a;
+                    }
+                    else if (a == 0)
+                    {
+                        odds.defendersLeft = d;
+                    }
+                    else
+                    {
+                        const BattleOdds &afterBoth = at(a - 1, d - 1);
+                        const BattleOdds &afterDefender = at(a, d - 1);
+                        const BattleOdds &afterAttacker = at(a - 1, d);
+
+                        odds.win = both * afterBoth.win + defenderOnly * afterDefender.win + attackerOnly * afterAttacker.win;
+                        odds.attackersLeft = both * afterBoth.attackersLeft + defenderOnly * afterDefender.attackersLeft +
+                                             attackerOnly * afterAttacker.attackersLeft;
+                        odds.defendersLeft = both * afterBoth.defendersLeft + defenderOnly * afterDefender.defendersLeft +
+                                             attackerOnly * afterAttacker.defendersLeft;
+                    }
+                }
+            }
+        }
+
+        const BattleOdds &at(int attackers, int defenders) const
+        {
+            return cells[attackers * size + defenders];
+        }
+
+    private:
+        int size;
+        std::vector<BattleOdds> cells;
+    };
+}
+
+/**
+ * @param attackers The attacking armies.
+ * @param defenders The defending armies.
+ * @return The odds of the battle, exact when both sides have at most EXACT_LIMIT armies.
+ */
+BattleOdds CombatOdds::odds(int attackers, int defenders)
+{
+    attackers = std::max(attackers, 0);
+    defenders = std::max(defenders, 0);
+
+    if (attackers <= EXACT_LIMIT && defenders <= EXACT_LIMIT)
+    {
+        return exact(attackers, defenders);
+    }
+    return approximate(attackers, defenders);
+}
+
+/**
+ * @param attackers The attacking armies.
+ * @param defenders The defending armies.
+ * @return The probability that the attackers conquer the territory.
+ */
+double CombatOdds::winProbability(int attackers, int defenders)
+{
+    return odds(attackers, defenders).win;
+}
+
+/**
+ * @brief Searches the fewest attackers by bisection, the probability of conquest growing with the attackers.
+ *
+ * @param defenders The defending armies.
+ * @param probability The probability of conquest wanted, below 1.
+ * @return The fewest attacking armies that conquer the territory with at least the given probability.
+ */
+int CombatOdds::attackersNeeded(int defenders, double probability)
+{
+    if (defenders <= 0)
+    {
+        return 0;
+    }
+
+    int low = 1;
+    int high = 2 * defenders;
+    while (winProbability(high, defenders) < probability && high < std::numeric_limits<int>::max() / 2)
+    {
+        low = high + 1;
+        high *= 2;
+    }
+
+    while (low < high)
+    {
+        const int middle = low + (high - low) / 2;
+        if (winProbability(middle, defenders) >= probability)
+        {
+            high = middle;
+        }
+        else
+        {
+            low = middle + 1;
+        }
+    }
+    return low;
+}
+
+/**
+ * @return The exact odds of a battle, from the table built on first use.
+ */
+const BattleOdds &CombatOdds::exact(int attackers, int defenders)
+{
+    static const OddsTable table;
+    return table.at(attackers, defenders);
+}
+
+/**
+ * @brief Wiping out d armies takes a negative binomial number of rounds, of mean d / p, variance d (1 - p) / p^2
+ * and third cumulant d (1 - p) (2 - p) / p^3 for a loss probability p. The attackers conquer when they need no
+ * more rounds than the defenders, which is approximated by an Edgeworth expansion of the distribution of the
+ * difference: a normal distribution corrected for its skewness. Armies left are those of the winning side once
+ * the other one is wiped out: the armies of one side less the losses of its Bernoulli rolls over the rounds the
+ * other side takes to fall, whose positive part is averaged over a normal distribution.
+ *
+ * @return The approximate odds of a battle with many armies.
+ */
+BattleOdds CombatOdds::approximate(int attackers, int defenders)
+{
+    BattleOdds odds;
+    if (defenders == 0)
+    {
+        odds.win = 1;
+        odds.attackersLeft = attackers;
+        return odds;
+    }
+    if (attackers == 0)
+    {
+        odds.defendersLeft = defenders;
+        return odds;
+    }
+
+    const double roundsToConquer = defenders / DEFENDER_LOSS;
+    const double roundsToRepel = attackers / ATTACKER_LOSS;
+    const double variance = defenders * (1 - DEFENDER_LOSS) / (DEFENDER_LOSS * DEFENDER_LOSS) +
+                            attackers * (1 - ATTACKER_LOSS) / (ATTACKER_LOSS * ATTACKER_LOSS);
+    const double thirdCumulant =
+        attackers * (1 - ATTACKER_LOSS) * (2 - ATTACKER_LOSS) / (ATTACKER_LOSS * ATTACKER_LOSS * ATTACKER_LOSS) -
+        defenders * (1 - DEFENDER_LOSS) * (2 - DEFENDER_LOSS) / (DEFENDER_LOSS * DEFENDER_LOSS * DEFENDER_LOSS);
+    const double deviation = std::sqrt(variance);
+    const double skewness = thirdCumulant / (variance * deviation);
+
+    // Conquest when the attackers' rounds minus the defenders' rounds is at least 0, with a continuity correction
+    const double z = -(roundsToRepel - roundsToConquer + 0.5) / deviation;
+    const double density = std::exp(-z * z / 2) / std::sqrt(2 * std::acos(-1.0));
+    const double win = 0.5 * std::erfc(z / std::sqrt(2.0)) + density * skewness / 6 * (z * z - 1);
+
+    odds.win = std::min(1.0, std::max(0.0, win));
+    odds.attackersLeft = expectedPositivePart(attackers - roundsToConquer * ATTACKER_LOSS,
+                                              roundsToConquer * ATTACKER_LOSS * (1 - ATTACKER_LOSS) +
+                                                  ATTACKER_LOSS * ATTACKER_LOSS * defenders * (1 - DEFENDER_LOSS) /
+                                                      (DEFENDER_LOSS * DEFENDER_LOSS));
+    odds.defendersLeft = expectedPositivePart(defenders - roundsToRepel * DEFENDER_LOSS,
+                                              roundsToRepel * DEFENDER_LOSS * (1 - DEFENDER_LOSS) +
+                                                  DEFENDER_LOSS * DEFENDER_LOSS * attackers * (1 - ATTACKER_LOSS) /
+                                                      (ATTACKER_LOSS * ATTACKER_LOSS));
+    return odds;
+}
@@ -0,0 +1,65 @@
+#ifndef COMBAT_ODDS_H
+#define COMBAT_ODDS_H
+
+/**
+ * @brief The odds of a battle between attacking and defending armies.
+ */
+struct BattleOdds
+{
+    double win = 0;            ///< Probability that the attackers conquer the territory.
+    double attackersLeft = 0;  ///< Expected attacking armies left, counting 0 for a lost battle.
+    double defendersLeft = 0;  ///< Expected defending armies left, counting 0 for a conquest.
+};
+
+/**
+ * @brief Computes the odds of battles under the rules of the AdvanceOrder (see BattleKernel) without simulating them.
+ *
+ * Every round kills a defending army with probability 59% and an attacking army with probability 69%, so a battle
+ * is a Markov chain on the armies left of both sides. The odds of every battle of up to EXACT_LIMIT armies per side
+ * are computed once by dynamic programming over that chain, a conquest being a battle that ends with no defending
+ * army left even if no attacking army is left either. Larger battles are approximated by comparing the number of
+ * rounds each side needs to wipe out the other, which is close to normal for large armies. Both are O(1) lookups
+ * after the table is built on first use.
+ */
+class CombatOdds
+{
+public:
+    /**
+     * @brief Largest number of armies per side whose odds are exact.
+     */
+    static const int EXACT_LIMIT = 256;
+
+    /**
+     * @param attackers The attacking armies.
+     * @param defenders The defending armies.
+     * @return The odds of the battle.
+     */
+    static BattleOdds odds(int attackers, int defenders);
+
+    /**
+     * @param attackers The attacking armies.
+     * @param defenders The defending armies.
+     * @return The probability that the attackers conquer the territory.
+     */
+    static double winProbability(int attackers, int defenders);
+
+    /**
+     * @param defenders The defending armies.
+     * @param probability The probability of conquest wanted, below 1.
+     * @return The fewest attacking armies that conquer the territory with at least the given probability.
+     */
+    static int attackersNeeded(int defenders, double probability);
+
+private:
+    /**
+     * @return The exact odds of a battle, both sides having at most EXACT_LIMIT armies.
+     */
+    static const BattleOdds &exact(int attackers, int defenders);
+
+    /**
+     * @return The approximate odds of a battle with many armies.
+     */
+    static BattleOdds approximate(int attackers, int defenders);
+};
+
+#endif
@@ -0,0 +1,94 @@
+#include <algorithm>
+#include "NegotiationMatrix.h"
+#include "PlayerFiles/Player.h"
+
+/**
+ * @brief Starts a new turn: indexes the players and links them to the matrix.
+ *
+ * @param players The players of the game.
+ */
+void NegotiationMatrix::beginTurn(const std::vector<Player *> &players)
+{
+    this->players = players;
+    wordsPerRow = (players.size() + 63) / 64;
+    bits.assign(players.size() * wordsPerRow, 0);
+
+    for (size_t i = 0; i < players.size(); ++i)
+    {
+        players[i]->negotiationIndex = static_cast<int>(i);
+        players[i]->negotiations = this;
+    }
+}
+
+/**
+ * @brief Ends the turn, every negotiation expires.
+ */
+void NegotiationMatrix::endTurn()
+{
+    std::fill(bits.begin(), bits.end(), 0);
+}
+
+/**
+ * @brief Records a negotiation between two players, in both directions.
+ *
+ * @param first The index of a player.
+ * @param second The index of another player.
+ */
+void NegotiationMatrix::add(int first, int second)
+{
+    if (first < 0 || second < 0 || first >= static_cast<int>(players.size()) || second >= static_cast<int>(players.size()))
+    {
+        return;
+    }
+
+    bits[first * wordsPerRow + second / 64] |= std::uint64_t(1) << (second % 64);
+    bits[second * wordsPerRow + first / 64] |= std::uint64_t(1) << (first % 64);
+}
+
+/**
+ * @brief Cancels a negotiation between two players, in both directions.
+ *
+ * @param first The index of a player.
+ * @param second The index of another player.
+ */
+void NegotiationMatrix::remove(int first, int second)
+{
+    if (first < 0 || second < 0 || first >= static_cast<int>(players.size()) || second >= static_cast<int>(players.size()))
+    {
+        return;
+    }
+
+    bits[first * wordsPerRow + second / 64] &= ~(std::uint64_t(1) << (second % 64));
+    bits[second * wordsPerRow + first / 64] &= ~(std::uint64_t(1) << (first % 64));
+}
+
+/**
+ * @param first The index of a player.
+ * @param second The index of another player.
+ * @return Whether the two players negotiated this turn.
+ */
+bool NegotiationMatrix::negotiating(int first, int second) const
+{
+    if (first < 0 || second < 0 || first >= static_cast<int>(players.size()) || second >= static_cast<int>(players.size()))
+    {
+        return false;
+    }
+
+    return (bits[first * wordsPerRow + second / 64] >> (second % 64)) & 1;
+}
+
+/**
+ * @param name The name of a player.
+ * @return The indexed player with this name, or nullptr if there is none.
+ */
+Player *NegotiationMatrix::findPlayer(const std::string &name) const
+{
+    for (Player *player : players)
+    {
+        if (player->getPlayerName() == name)
+        {
+            return player;
+        }
+    }
+    return nullptr;
+}
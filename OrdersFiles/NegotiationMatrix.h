@@ -0,0 +1,67 @@
+#ifndef NEGOTIATION_MATRIX_H
+#define NEGOTIATION_MATRIX_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Player;
+
+/**
+ * @brief The negotiations of one game, as a symmetric bit matrix indexed by player.
+ *
+ * A negotiate order between two players prevents attacks between them until the end of the turn. Any number of
+ * negotiations may be active for a player. Players are given their index when a turn begins, so players
+ * eliminated since the previous turn do not keep a row.
+ */
+class NegotiationMatrix
+{
+public:
+    /**
+     * @brief Starts a new turn: indexes the players and links them to the matrix. No negotiation is active.
+     *
+     * @param players The players of the game.
+     */
+    void beginTurn(const std::vector<Player *> &players);
+
+    /**
+     * @brief Ends the turn, every negotiation expires.
+     */
+    void endTurn();
+
+    /**
+     * @brief Records a negotiation between two players, in both directions.
+     *
+     * @param first The index of a player.
+     * @param second The index of another player.
+     */
+    void add(int first, int second);
+
+    /**
+     * @brief Cancels a negotiation between two players, in both directions.
+     *
+     * @param first The index of a player.
+     * @param second The index of another player.
+     */
+    void remove(int first, int second);
+
+    /**
+     * @param first The index of a player.
+     * @param second The index of another player.
+     * @return Whether the two players negotiated this turn. Players without an index never negotiated.
+     */
+    bool negotiating(int first, int second) const;
+
+    /**
+     * @param name The name of a player.
+     * @return The indexed player with this name, or nullptr if there is none.
+     */
+    Player *findPlayer(const std::string &name) const;
+
+private:
+    std::vector<Player *> players;
+    std::size_t wordsPerRow = 0;
+    std::vector<std::uint64_t> bits; ///< Row of a player followed by the row of the next one, one bit per player.
+};
+
+#endif
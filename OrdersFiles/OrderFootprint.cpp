@@ -0,0 +1,141 @@
+#include "OrderFootprint.h"
+#include "MapFiles/Map.h"
+#include "GameEngineFiles/GameEngine.h"
+
+/**
+ * @brief Declares a resource as read.
+ *
+ * @param resource The resource key, a negative key makes the order a barrier.
+ */
+void OrderFootprint::read(int resource)
+{
+    if (resource < 0)
+    {
+        barrier = true;
+        return;
+    }
+    reads.push_back(resource);
+}
+
+/**
+ * @brief Declares a resource as written.
+ *
+ * @param resource The resource key, a negative key makes the order a barrier.
+ */
+void OrderFootprint::write(int resource)
+{
+    if (resource < 0)
+    {
+        barrier = true;
+        return;
+    }
+    writes.push_back(resource);
+}
+
+/**
+ * @brief Declares a resource as updated.
+ *
+ * @param resource The resource key, a negative key makes the order a barrier.
+ */
+void OrderFootprint::update(int resource)
+{
+    if (resource < 0)
+    {
+        barrier = true;
+        return;
+    }
+    updates.push_back(resource);
+}
+
+/**
+ * @brief Clears the footprint so it can be reused for another order.
+ */
+void OrderFootprint::clear()
+{
+    reads.clear();
+    writes.clear();
+    updates.clear();
+    barrier = false;
+}
+
+/**
+ * @brief Prepares the keys for an execution phase. The territory name index is only rebuilt when the generation of
+ * the map changed.
+ *
+ * @param map The map of the game, may be nullptr.
+ */
+void OrderResources::reset(const Map *map)
+{
+    const std::uint64_t generation = map == nullptr ? 0 : map->GetGeneration();
+    const int territories = map == nullptr ? 0 : static_cast<int>(map->territoriesById.size());
+
+    if (generation != indexedGeneration)
+    {
+        territoriesByName.clear();
+        territoriesByName.reserve(territories);
+
+        for (int id = 0; id < territories; ++id)
+        {
+            auto inserted = territoriesByName.insert({GameEngine::toLowerCase(map->territoriesById[id]->name), id});
+            if (!inserted.second)
+            {
+                inserted.first->second = -1; // Two territories only differ by case, orders cannot tell them apart
+            }
+        }
+
+        indexedGeneration = generation;
+        indexedTerritories = territories;
+    }
+
+    players.clear();
+    nextKey = territories + 1; // Territory ids first, then the negotiation table, then the players
+}
+
+/**
+ * @param name The name of a territory, in any case.
+ * @return The key of the territory, or -1 if no single territory of the map has this name.
+ */
+int OrderResources::territory(const std::string &name) const
+{
+    auto it = territoriesByName.find(GameEngine::toLowerCase(name));
+    return it == territoriesByName.end() ? -1 : it->second;
+}
+
+/**
+ * @param player A player, only used as an identity.
+ * @return The key of the player's reinforcement pool.
+ */
+int OrderResources::pool(const Player *player)
+{
+    auto inserted = players.insert({player, nextKey});
+    if (inserted.second)
+    {
+        nextKey += 2;
+    }
+    return inserted.first->second;
+}
+
+/**
+ * @param player A player, only used as an identity.
+ * @return The key of the player's owned territories, strategy and cached lists.
+ */
+int OrderResources::territories(const Player *player)
+{
+    return pool(player) + 1;
+}
+
+/**
+ * @return The key of the negotiation table.
+ */
+int OrderResources::negotiation() const
+{
+    return indexedTerritories;
+}
+
+/**
+ * @return One past the largest key handed out so far.
+ */
+int OrderResources::size() const
+{
+    return nextKey;
+}
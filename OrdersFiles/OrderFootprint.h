@@ -0,0 +1,111 @@
+#ifndef ORDER_FOOTPRINT_H
+#define ORDER_FOOTPRINT_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Map;
+class Player;
+
+/**
+ * @brief The game state an order reads and writes when it is validated and executed.
+ *
+ * State is identified by integer resource keys handed out by OrderResources: one per territory (its armies), two
+ * per player (its reinforcement pool, and its owned territories along with its strategy and the strategy's cached
+ * lists) and one for the negotiation table. Cards are not a resource, since the cards orders draw are dealt once
+ * the phase is over. Two orders conflict when one of them writes a resource the other touches, or when one reads a
+ * resource the other updates. Updates only append to a resource, and the OrderScheduler applies them once the
+ * orders running alongside are done, so several orders can update the same resource together.
+ * An order that cannot describe what it touches is a barrier and conflicts with every other order.
+ */
+class OrderFootprint
+{
+public:
+    std::vector<int> reads;  ///< Resources that are only read.
+    std::vector<int> writes; ///< Resources that are written (and possibly read).
+    std::vector<int> updates; ///< Resources that are appended to, without being read.
+    bool barrier = false;    ///< Whether the order conflicts with every other order.
+
+    /**
+     * @brief Declares a resource as read.
+     *
+     * @param resource The resource key, a negative key makes the order a barrier.
+     */
+    void read(int resource);
+
+    /**
+     * @brief Declares a resource as written.
+     *
+     * @param resource The resource key, a negative key makes the order a barrier.
+     */
+    void write(int resource);
+
+    /**
+     * @brief Declares a resource as updated.
+     *
+     * @param resource The resource key, a negative key makes the order a barrier.
+     */
+    void update(int resource);
+
+    /**
+     * @brief Clears the footprint so it can be reused for another order.
+     */
+    void clear();
+};
+
+/**
+ * @brief Hands out the resource keys of the orders of one execution phase.
+ *
+ * Territory keys are the territory ids of the map, resolved by case insensitive name like the orders do.
+ * The name index is kept between phases as long as the generation of the map does not change.
+ */
+class OrderResources
+{
+public:
+    /**
+     * @brief Prepares the keys for an execution phase on the given map.
+     * Player keys from a previous phase are forgotten.
+     *
+     * @param map The map of the game, may be nullptr in which case no territory can be resolved.
+     */
+    void reset(const Map *map);
+
+    /**
+     * @param name The name of a territory, in any case.
+     * @return The key of the territory, or -1 if no single territory of the map has this name.
+     */
+    int territory(const std::string &name) const;
+
+    /**
+     * @param player A player, only used as an identity.
+     * @return The key of the player's reinforcement pool, assigned on first use.
+     */
+    int pool(const Player *player);
+
+    /**
+     * @param player A player, only used as an identity.
+     * @return The key of the player's owned territories, strategy and cached lists, assigned on first use.
+     */
+    int territories(const Player *player);
+
+    /**
+     * @return The key of the negotiation table.
+     */
+    int negotiation() const;
+
+    /**
+     * @return One past the largest key handed out so far.
+     */
+    int size() const;
+
+private:
+    std::uint64_t indexedGeneration = 0; ///< Map::GetGeneration of the indexed map, 0 for no map.
+    int indexedTerritories = 0;
+    std::unordered_map<std::string, int> territoriesByName; ///< Lowercase name to territory id, -1 if ambiguous.
+    std::unordered_map<const Player *, int> players; ///< The first of the two keys of every player.
+    int nextKey = 0;
+};
+
+#endif
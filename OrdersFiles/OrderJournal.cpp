@@ -0,0 +1,411 @@
+#include "OrderJournal.h"
+#include "PlayerFiles/Player.h"
+#include "CardsFiles/Cards.h"
+#include "NegotiationMatrix.h"
+#include "OrderScheduler.h"
+
+thread_local OrderJournal *OrderJournal::current = nullptr;
+
+/**
+ * @brief Stops the journal if it is recording and deletes the strategies it holds for undo or redo.
+ */
+OrderJournal::~OrderJournal()
+{
+    stop();
+    clear();
+}
+
+/**
+ * @brief Records the changes made by the calling thread until the journal is stopped.
+ */
+void OrderJournal::start()
+{
+    if (recording)
+    {
+        return;
+    }
+
+    previous = current;
+    current = this;
+    recording = true;
+}
+
+/**
+ * @brief Stops recording, the journal that was recording before this one was started records again.
+ */
+void OrderJournal::stop()
+{
+    if (!recording)
+    {
+        return;
+    }
+
+    if (current == this)
+    {
+        current = previous;
+    }
+    previous = nullptr;
+    recording = false;
+}
+
+/**
+ * @return The journal recording on the calling thread, or nullptr.
+ */
+OrderJournal *OrderJournal::active()
+{
+    return current;
+}
+
+/**
+ * @return The number of changes currently applied.
+ */
+std::size_t OrderJournal::position() const
+{
+    return applied;
+}
+
+/**
+ * @return The number of recorded changes, applied or undone.
+ */
+std::size_t OrderJournal::size() const
+{
+    return changes.size();
+}
+
+/**
+ * @brief Undoes every applied change, most recent first.
+ */
+void OrderJournal::undo()
+{
+    undoTo(0);
+}
+
+/**
+ * @brief Undoes the applied changes made after the given position, most recent first.
+ *
+ * @param position A position returned by position().
+ */
+void OrderJournal::undoTo(std::size_t position)
+{
+    while (applied > position)
+    {
+        revert(changes[--applied]);
+    }
+}
+
+/**
+ * @brief Applies again every undone change, in the order they were made.
+ */
+void OrderJournal::redo()
+{
+    while (applied < changes.size())
+    {
+        apply(changes[applied++]);
+    }
+}
+
+/**
+ * @brief Forgets every change, keeping the game as it is.
+ */
+void OrderJournal::clear()
+{
+    for (std::size_t i = 0; i < changes.size(); ++i)
+    {
+        release(changes[i], i < applied);
+    }
+
+    changes.clear();
+    applied = 0;
+}
+
+/**
+ * @brief Sets the armies of a territory.
+ *
+ * @param territory The territory.
+ * @param armies The new number of armies.
+ */
+void OrderJournal::setArmies(Territory *territory, int armies)
+{
+    OrderJournal *journal = recorder();
+    if (journal != nullptr)
+    {
+        Change change{ChangeKind::ARMIES};
+        change.territory = territory;
+        change.before = territory->numberOfArmies;
+        change.after = armies;
+        journal->record(change);
+    }
+
+    territory->numberOfArmies = armies;
+}
+
+/**
+ * @brief Sets the reinforcement pool of a player.
+ *
+ * @param player The player.
+ * @param armies The new number of armies in the pool.
+ */
+void OrderJournal::setPool(Player *player, int armies)
+{
+    OrderJournal *journal = recorder();
+    if (journal != nullptr)
+    {
+        Change change{ChangeKind::POOL};
+        change.player = player;
+        change.before = player->getNumArmies();
+        change.after = armies;
+        journal->record(change);
+    }
+
+    player->setNumArmies(armies);
+}
+
+/**
+ * @brief Adds a territory at the end of a player's territories.
+ *
+ * @param player The player.
+ * @param territory The territory gained.
+ */
+void OrderJournal::addTerritory(Player *player, Territory *territory)
+{
+    player->getOwnedTerritories().push_back(territory);
+
+    OrderJournal *journal = recorder();
+    if (journal != nullptr)
+    {
+        Change change{ChangeKind::TERRITORY_ADDED};
+        change.player = player;
+        change.territory = territory;
+        change.before = static_cast<int>(player->getOwnedTerritories().size()) - 1;
+        journal->record(change);
+    }
+}
+
+/**
+ * @brief Removes a territory from a player's territories, wherever it appears. Occurrences are removed from the
+ * last one, so undoing puts them back from the first one.
+ *
+ * @param player The player.
+ * @param territory The territory lost.
+ */
+void OrderJournal::removeTerritory(Player *player, Territory *territory)
+{
+    std::vector<Territory *> &territories = player->getOwnedTerritories();
+
+    for (std::size_t i = territories.size(); i-- > 0;)
+    {
+        if (territories[i] == territory)
+        {
+            removeTerritoryAt(player, i);
+        }
+    }
+}
+
+/**
+ * @brief Removes the territory at the given position of a player's territories.
+ *
+ * @param player The player.
+ * @param position The position of the territory in Player::getOwnedTerritories.
+ */
+void OrderJournal::removeTerritoryAt(Player *player, std::size_t position)
+{
+    std::vector<Territory *> &territories = player->getOwnedTerritories();
+
+    OrderJournal *journal = recorder();
+    if (journal != nullptr)
+    {
+        Change change{ChangeKind::TERRITORY_REMOVED};
+        change.player = player;
+        change.territory = territories[position];
+        change.before = static_cast<int>(position);
+        journal->record(change);
+    }
+
+    territories.erase(territories.begin() + position);
+}
+
+/**
+ * @brief Draws a card from a deck into a hand.
+ *
+ * @param deck The deck to draw from.
+ * @param hand The hand receiving the card.
+ */
+void OrderJournal::draw(Deck *deck, Hand *hand)
+{
+    const int type = deck->draw(*hand);
+
+    OrderJournal *journal = recorder();
+    if (journal != nullptr && type >= 0)
+    {
+        Change change{ChangeKind::CARD_DRAWN};
+        change.deck = deck;
+        change.hand = hand;
+        change.before = type;
+        journal->record(change);
+    }
+}
+
+/**
+ * @brief Replaces the strategy of a player. The previous strategy is deleted, or kept by the journal so the
+ * change can be undone.
+ *
+ * @param player The player.
+ * @param strategy The new strategy.
+ */
+void OrderJournal::replaceStrategy(Player *player, PlayerStrategy *strategy)
+{
+    PlayerStrategy *previousStrategy = player->getStrategy();
+    player->setStrategy(strategy);
+
+    OrderJournal *journal = recorder();
+    if (journal != nullptr)
+    {
+        Change change{ChangeKind::STRATEGY_REPLACED};
+        change.player = player;
+        change.previousStrategy = previousStrategy;
+        change.nextStrategy = strategy;
+        journal->record(change);
+    }
+    else
+    {
+        delete previousStrategy;
+    }
+}
+
+/**
+ * @brief Records a negotiation between two players.
+ *
+ * @param negotiations The negotiations of the game.
+ * @param first The index of a player.
+ * @param second The index of another player.
+ */
+void OrderJournal::negotiate(NegotiationMatrix *negotiations, int first, int second)
+{
+    OrderJournal *journal = recorder();
+    if (journal != nullptr)
+    {
+        Change change{ChangeKind::NEGOTIATION};
+        change.negotiations = negotiations;
+        change.first = first;
+        change.second = second;
+        change.before = negotiations->negotiating(first, second);
+        journal->record(change);
+    }
+
+    negotiations->add(first, second);
+}
+
+/**
+ * @return The journal recording the changes made by the calling thread: the one the OrderScheduler gave the order
+ * being executed, or the one started on the thread.
+ */
+OrderJournal *OrderJournal::recorder()
+{
+    OrderExecutionContext *context = OrderExecutionContext::current();
+    return context != nullptr ? context->journal : current;
+}
+
+/**
+ * @brief Records a change that was just applied. Changes that were undone can no longer be redone. The orders of a
+ * level of the OrderScheduler record their changes from several threads, so the changes are recorded under a lock.
+ *
+ * @param change The change.
+ */
+void OrderJournal::record(const Change &change)
+{
+    std::lock_guard<std::mutex> lock(recordMutex);
+    for (std::size_t i = applied; i < changes.size(); ++i)
+    {
+        release(changes[i], false);
+    }
+    changes.resize(applied);
+
+    changes.push_back(change);
+    applied++;
+}
+
+/**
+ * @brief Reverts a change.
+ *
+ * @param change The change.
+ */
+void OrderJournal::revert(const Change &change)
+{
+    switch (change.kind)
+    {
+    case ChangeKind::ARMIES:
+        change.territory->numberOfArmies = change.before;
+        break;
+    case ChangeKind::POOL:
+        change.player->setNumArmies(change.before);
+        break;
+    case ChangeKind::TERRITORY_ADDED:
+        change.player->getOwnedTerritories().erase(change.player->getOwnedTerritories().begin() + change.before);
+        break;
+    case ChangeKind::TERRITORY_REMOVED:
+        change.player->getOwnedTerritories().insert(change.player->getOwnedTerritories().begin() + change.before,
+                                                    change.territory);
+        break;
+    case ChangeKind::CARD_DRAWN:
+        change.hand->play(static_cast<CardType>(change.before), *change.deck);
+        break;
+    case ChangeKind::STRATEGY_REPLACED:
+        change.player->setStrategy(change.previousStrategy);
+        break;
+    case ChangeKind::NEGOTIATION:
+        if (!change.before)
+        {
+            change.negotiations->remove(change.first, change.second);
+        }
+        break;
+    }
+}
+
+/**
+ * @brief Applies a change again.
+ *
+ * @param change The change.
+ */
+void OrderJournal::apply(const Change &change)
+{
+    switch (change.kind)
+    {
+    case ChangeKind::ARMIES:
+        change.territory->numberOfArmies = change.after;
+        break;
+    case ChangeKind::POOL:
+        change.player->setNumArmies(change.after);
+        break;
+    case ChangeKind::TERRITORY_ADDED:
+        change.player->getOwnedTerritories().insert(change.player->getOwnedTerritories().begin() + change.before,
+                                                    change.territory);
+        break;
+    case ChangeKind::TERRITORY_REMOVED:
+        change.player->getOwnedTerritories().erase(change.player->getOwnedTerritories().begin() + change.before);
+        break;
+    case ChangeKind::CARD_DRAWN:
+        change.deck->remove(static_cast<CardType>(change.before));
+        change.hand->add(static_cast<CardType>(change.before));
+        break;
+    case ChangeKind::STRATEGY_REPLACED:
+        change.player->setStrategy(change.nextStrategy);
+        break;
+    case ChangeKind::NEGOTIATION:
+        change.negotiations->add(change.first, change.second);
+        break;
+    }
+}
+
+/**
+ * @brief Deletes the strategy a change holds: the previous one if the change is applied, the next one if not.
+ *
+ * @param change The change.
+ * @param isApplied Whether the change is applied.
+ */
+void OrderJournal::release(const Change &change, bool isApplied)
+{
+    if (change.kind == ChangeKind::STRATEGY_REPLACED)
+    {
+        delete (isApplied ? change.previousStrategy : change.nextStrategy);
+    }
+}
@@ -0,0 +1,222 @@
+#ifndef ORDER_JOURNAL_H
+#define ORDER_JOURNAL_H
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+class Territory;
+class Player;
+class PlayerStrategy;
+class Deck;
+class Hand;
+class NegotiationMatrix;
+
+/**
+ * @brief Records the changes orders make to the game so they can be undone and redone.
+ *
+ * A journal is started on a thread, orders executed on that thread, or by the OrderScheduler for a phase run on that
+ * thread, then go through its static helpers to change the game: armies of territories, reinforcement pools, territories gained and lost, cards drawn, strategies
+ * replaced and negotiations. Without a started journal the helpers only apply the change. Undoing reverts the
+ * changes in reverse order, which lets a search try a set of orders on the real game and roll it back without
+ * copying the map. Caches derived from the game, like the territories a player wants to attack, are not recorded,
+ * and neither is the state of the random number generators used for battles and draws.
+ */
+class OrderJournal
+{
+public:
+    OrderJournal() = default;
+    OrderJournal(const OrderJournal &) = delete;
+    OrderJournal &operator=(const OrderJournal &) = delete;
+
+    /**
+     * @brief Stops the journal if it is recording and deletes the strategies it holds for undo or redo.
+     */
+    ~OrderJournal();
+
+    /**
+     * @brief Records the changes made by the calling thread until the journal is stopped.
+     * A journal started while another one records on the same thread takes its place until it is stopped.
+     */
+    void start();
+
+    /**
+     * @brief Stops recording. Recorded changes can still be undone and redone.
+     */
+    void stop();
+
+    /**
+     * @return The journal recording on the calling thread, or nullptr.
+     */
+    static OrderJournal *active();
+
+    /**
+     * @return The number of changes currently applied, to be given to undoTo.
+     */
+    std::size_t position() const;
+
+    /**
+     * @return The number of recorded changes, applied or undone.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Undoes every applied change, most recent first.
+     */
+    void undo();
+
+    /**
+     * @brief Undoes the applied changes made after the given position, most recent first.
+     *
+     * @param position A position returned by position().
+     */
+    void undoTo(std::size_t position);
+
+    /**
+     * @brief Applies again every undone change, in the order they were made.
+     */
+    void redo();
+
+    /**
+     * @brief Forgets every change, keeping the game as it is.
+     */
+    void clear();
+
+    /**
+     * @brief Sets the armies of a territory.
+     *
+     * @param territory The territory.
+     * @param armies The new number of armies.
+     */
+    static void setArmies(Territory *territory, int armies);
+
+    /**
+     * @brief Sets the reinforcement pool of a player.
+     *
+     * @param player The player.
+     * @param armies The new number of armies in the pool.
+     */
+    static void setPool(Player *player, int armies);
+
+    /**
+     * @brief Adds a territory at the end of a player's territories.
+     *
+     * @param player The player.
+     * @param territory The territory gained.
+     */
+    static void addTerritory(Player *player, Territory *territory);
+
+    /**
+     * @brief Removes a territory from a player's territories, wherever it appears.
+     *
+     * @param player The player.
+     * @param territory The territory lost.
+     */
+    static void removeTerritory(Player *player, Territory *territory);
+
+    /**
+     * @brief Removes the territory at the given position of a player's territories.
+     *
+     * @param player The player.
+     * @param position The position of the territory in Player::getOwnedTerritories.
+     */
+    static void removeTerritoryAt(Player *player, std::size_t position);
+
+    /**
+     * @brief Draws a card from a deck into a hand.
+     *
+     * @param deck The deck to draw from.
+     * @param hand The hand receiving the card.
+     */
+    static void draw(Deck *deck, Hand *hand);
+
+    /**
+     * @brief Replaces the strategy of a player. The previous strategy is deleted, or kept by the journal so
+     * the change can be undone.
+     *
+     * @param player The player.
+     * @param strategy The new strategy.
+     */
+    static void replaceStrategy(Player *player, PlayerStrategy *strategy);
+
+    /**
+     * @brief Records a negotiation between two players.
+     *
+     * @param negotiations The negotiations of the game.
+     * @param first The index of a player.
+     * @param second The index of another player.
+     */
+    static void negotiate(NegotiationMatrix *negotiations, int first, int second);
+
+private:
+    /**
+     * @brief The kinds of recorded changes.
+     */
+    enum class ChangeKind
+    {
+        ARMIES,
+        POOL,
+        TERRITORY_ADDED,
+        TERRITORY_REMOVED,
+        CARD_DRAWN,
+        STRATEGY_REPLACED,
+        NEGOTIATION
+    };
+
+    /**
+     * @brief One recorded change, only the fields of its kind are set.
+     */
+    struct Change
+    {
+        ChangeKind kind;
+        Territory *territory = nullptr;
+        Player *player = nullptr;
+        int before = 0; ///< Armies before, position of the territory, type of the card or whether the players negotiated.
+        int after = 0;  ///< Armies after.
+        Deck *deck = nullptr;
+        Hand *hand = nullptr;
+        PlayerStrategy *previousStrategy = nullptr;
+        PlayerStrategy *nextStrategy = nullptr;
+        NegotiationMatrix *negotiations = nullptr;
+        int first = -1;
+        int second = -1;
+    };
+
+    std::vector<Change> changes;
+    std::size_t applied = 0;
+    OrderJournal *previous = nullptr; ///< Journal recording on the thread before this one was started.
+    bool recording = false;
+
+    std::mutex recordMutex; ///< Guards the changes recorded by the orders of a level, executed by several threads.
+
+    static thread_local OrderJournal *current;
+
+    /**
+     * @return The journal recording the changes made by the calling thread, or nullptr.
+     */
+    static OrderJournal *recorder();
+
+    /**
+     * @brief Records a change that was just applied, dropping the undone changes.
+     *
+     * @param change The change.
+     */
+    void record(const Change &change);
+
+    /**
+     * @brief Reverts a change.
+     */
+    static void revert(const Change &change);
+
+    /**
+     * @brief Applies a change again.
+     */
+    static void apply(const Change &change);
+
+    /**
+     * @brief Deletes the strategy a change holds: the previous one if the change is applied, the next one if not.
+     */
+    static void release(const Change &change, bool isApplied);
+};
+
+#endif
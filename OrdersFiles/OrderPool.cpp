@@ -0,0 +1,145 @@
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <vector>
+#include "OrderPool.h"
+
+namespace
+{
+    // Blocks are multiples of the fundamental alignment, one size class per multiple
+    const std::size_t GRANULARITY = alignof(std::max_align_t);
+    const std::size_t SIZE_CLASSES = OrderPool::MAX_BLOCK_SIZE / GRANULARITY;
+    const std::size_t BLOCKS_PER_SLAB = 128;
+
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    /**
+     * Free lists of the calling thread, one per size class.
+     */
+    struct ThreadFreeLists
+    {
+        FreeBlock *heads[SIZE_CLASSES] = {};
+    };
+
+    thread_local ThreadFreeLists freeLists;
+
+    /**
+     * Blocks handed out and not yet released. Shared by every thread, since a block may be released by another
+     * thread than the one that allocated it.
+     */
+    std::atomic<std::size_t> liveBlockCount(0);
+
+    /**
+     * Slabs of every thread. They are never released, since a block may be returned to the free list of another
+     * thread than the one that carved it, and orders may still be deleted while static objects are destroyed.
+     */
+    struct SlabRegistry
+    {
+        std::mutex mutex;
+        std::vector<void *> slabs;
+    };
+
+    SlabRegistry &slabRegistry()
+    {
+        static SlabRegistry *registry = new SlabRegistry();
+        return *registry;
+    }
+
+    std::size_t sizeClassOf(std::size_t size)
+    {
+        return size == 0 ? 0 : (size - 1) / GRANULARITY;
+    }
+
+    /**
+     * Carves a new slab into blocks of the given size class and pushes them on the free list of the calling thread.
+     */
+    void refill(std::size_t sizeClass)
+    {
+        const std::size_t blockSize = (sizeClass + 1) * GRANULARITY;
+        char *slab = static_cast<char *>(std::malloc(blockSize * BLOCKS_PER_SLAB));
+        if (slab == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+
+        {
+            SlabRegistry &registry = slabRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            registry.slabs.push_back(slab);
+        }
+
+        for (std::size_t i = BLOCKS_PER_SLAB; i-- > 0;)
+        {
+            FreeBlock *block = reinterpret_cast<FreeBlock *>(slab + i * blockSize);
+            block->next = freeLists.heads[sizeClass];
+            freeLists.heads[sizeClass] = block;
+        }
+    }
+}
+
+const std::size_t OrderPool::MAX_BLOCK_SIZE;
+
+/**
+ * @brief Allocates a block of at least the given size, from the slabs of the calling thread when it is small enough.
+ *
+ * @param size The size of the block, in bytes.
+ * @return A pointer to the block.
+ */
+void *OrderPool::allocate(std::size_t size)
+{
+    if (size > MAX_BLOCK_SIZE)
+    {
+        return ::operator new(size);
+    }
+
+    const std::size_t sizeClass = sizeClassOf(size);
+    if (freeLists.heads[sizeClass] == nullptr)
+    {
+        refill(sizeClass);
+    }
+
+    FreeBlock *block = freeLists.heads[sizeClass];
+    freeLists.heads[sizeClass] = block->next;
+    liveBlockCount.fetch_add(1, std::memory_order_relaxed);
+    return block;
+}
+
+/**
+ * @brief Returns a block to the free list of its size class on the calling thread.
+ *
+ * @param memory The block to release, may be nullptr.
+ * @param size The size that was requested when the block was allocated.
+ */
+void OrderPool::release(void *memory, std::size_t size)
+{
+    if (memory == nullptr)
+    {
+        return;
+    }
+
+    if (size > MAX_BLOCK_SIZE)
+    {
+        ::operator delete(memory);
+        return;
+    }
+
+    const std::size_t sizeClass = sizeClassOf(size);
+    FreeBlock *block = static_cast<FreeBlock *>(memory);
+    block->next = freeLists.heads[sizeClass];
+    freeLists.heads[sizeClass] = block;
+    liveBlockCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Counts the blocks currently handed out, on every thread.
+ *
+ * @return The number of blocks allocated and not yet released.
+ */
+std::size_t OrderPool::liveBlocks()
+{
+    return liveBlockCount.load(std::memory_order_relaxed);
+}
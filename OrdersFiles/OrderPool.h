@@ -0,0 +1,49 @@
+#ifndef ORDER_POOL_H
+#define ORDER_POOL_H
+
+#include <cstddef>
+
+/**
+ * @brief Slab allocator backing the allocation of every Order.
+ *
+ * Orders are small, short lived and created by the hundreds every turn. Instead of going to the heap for each of
+ * them, blocks are carved out of large slabs and recycled through per size class free lists, so once the first
+ * turns have been played, issuing and executing orders no longer allocates at all.
+ *
+ * Free lists are per thread, so concurrent games do not contend on them. Slabs are never returned to the system,
+ * which makes it safe to release an order on another thread than the one that created it: the block then joins
+ * the free list of the releasing thread. Only the count of live blocks is shared between threads.
+ */
+class OrderPool
+{
+public:
+    /**
+     * @brief Size of the largest block served from the slabs, larger requests go to the global allocator.
+     */
+    static const std::size_t MAX_BLOCK_SIZE = 512;
+
+    /**
+     * @brief Allocates a block of at least the given size.
+     *
+     * @param size The size of the block, in bytes.
+     * @return A pointer to the block, suitably aligned for any order.
+     */
+    static void *allocate(std::size_t size);
+
+    /**
+     * @brief Releases a block obtained from allocate.
+     *
+     * @param memory The block to release, may be nullptr.
+     * @param size The size that was requested when the block was allocated.
+     */
+    static void release(void *memory, std::size_t size);
+
+    /**
+     * @brief Counts the blocks currently handed out by the slabs, on every thread.
+     *
+     * @return The number of blocks allocated and not yet released.
+     */
+    static std::size_t liveBlocks();
+};
+
+#endif
@@ -0,0 +1,434 @@
+#include <algorithm>
+#include <iostream>
+#include "OrderScheduler.h"
+#include "Orders.h"
+#include "OrderJournal.h"
+#include "PlayerFiles/Player.h"
+#include "CardsFiles/Cards.h"
+
+thread_local OrderExecutionContext *OrderExecutionContext::active = nullptr;
+
+/**
+ * @return The context of the order executed by the calling thread, or nullptr outside of the OrderScheduler.
+ */
+OrderExecutionContext *OrderExecutionContext::current()
+{
+    return active;
+}
+
+/**
+ * @return Where orders print: the output of the order executed by the calling thread, or std::cout outside of the
+ * OrderScheduler.
+ */
+std::ostream &OrderExecutionContext::console()
+{
+    return active != nullptr ? static_cast<std::ostream &>(active->out) : std::cout;
+}
+
+/**
+ * @return Where orders print their errors: the errors of the order executed by the calling thread, or std::cerr
+ * outside of the OrderScheduler.
+ */
+std::ostream &OrderExecutionContext::errors()
+{
+    return active != nullptr ? static_cast<std::ostream &>(active->err) : std::cerr;
+}
+
+/**
+ * @brief Draws a card from the deck into the hand, or defers the draw when called from the OrderScheduler.
+ *
+ * @param deck The deck to draw from.
+ * @param hand The hand receiving the card.
+ */
+void OrderExecutionContext::draw(Deck *deck, Hand *hand)
+{
+    if (active != nullptr)
+    {
+        active->deferredDraws.emplace_back(deck, hand);
+    }
+    else
+    {
+        OrderJournal::draw(deck, hand);
+    }
+}
+
+/**
+ * @brief Adds a territory at the end of a player's territories, or defers it to the end of the level when called
+ * from the OrderScheduler.
+ *
+ * @param player The player.
+ * @param territory The territory gained.
+ */
+void OrderExecutionContext::addTerritory(Player *player, Territory *territory)
+{
+    if (active != nullptr)
+    {
+        active->deferredTerritories.emplace_back(player, territory);
+    }
+    else
+    {
+        OrderJournal::addTerritory(player, territory);
+    }
+}
+
+const int OrderScheduler::PARALLEL_BATCH_MIN;
+
+/**
+ * @param threads The number of worker threads, 0 to use one per hardware thread.
+ */
+OrderScheduler::OrderScheduler(int threads) : threads(threads)
+{
+    if (this->threads <= 0)
+    {
+        this->threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+/**
+ * @brief Stops and joins the worker threads.
+ */
+OrderScheduler::~OrderScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(workMutex);
+        stopping = true;
+    }
+    workReady.notify_all();
+
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Executes and deletes every order of the given players, level by level. Output and card draws of the
+ * orders are held in their context while the levels run, then replayed in sequence order.
+ *
+ * @param players The players of the game, in turn order.
+ * @param map The map of the game, used to resolve territory names.
+ * @param validation The batch that prevalidated the orders, may be nullptr.
+ */
+void OrderScheduler::executePhase(const std::vector<Player *> &players, const Map *map, OrderValidation *validation)
+{
+    resources.reset(map);
+
+    std::string epilogue;
+    std::vector<ScheduledOrder> sequence = layout(players, epilogue);
+    orders = static_cast<int>(sequence.size());
+
+    // Battles roll from the position of their order in the sequence, not from the level it runs in, and changes are
+    // recorded by the journal of the calling thread, not of the worker executing the order
+    const std::uint64_t phaseSeed = BattleKernel::currentSeed();
+    OrderJournal *journal = OrderJournal::active();
+    for (int i = 0; i < orders; ++i)
+    {
+        sequence[i].order->sequence = i;
+        sequence[i].order->phaseSeed = phaseSeed;
+        sequence[i].context.journal = journal;
+    }
+    levels = assignLevels(sequence);
+
+    // Bucket the orders by level, keeping the sequence order within each level
+    std::vector<std::vector<ScheduledOrder *>> batches(levels);
+    orderLevels.clear();
+    for (ScheduledOrder &scheduled : sequence)
+    {
+        batches[scheduled.level].push_back(&scheduled);
+        orderLevels.push_back(scheduled.level);
+    }
+
+    parallelLevels = 0;
+    BattleBatch battles;
+    for (const auto &batch : batches)
+    {
+        // Orders of a level do not conflict, so their battles can be resolved together before any of them runs
+        for (ScheduledOrder *scheduled : batch)
+        {
+            scheduled->order->prepareBattle(battles);
+        }
+        if (battles.size() > 0)
+        {
+            battles.resolve(phaseSeed);
+        }
+
+        executeLevel(batch);
+
+        // Territories gained by the level are added in sequence order, as the sequential engine adds them
+        for (ScheduledOrder *scheduled : batch)
+        {
+            for (const auto &gained : scheduled->context.deferredTerritories)
+            {
+                OrderJournal::addTerritory(gained.first, gained.second);
+            }
+        }
+
+        // Verdicts are only read by the orders of later levels, so they are dropped between levels
+        if (validation != nullptr)
+        {
+            for (ScheduledOrder *scheduled : batch)
+            {
+                validation->executed(scheduled->order);
+            }
+        }
+    }
+
+    for (ScheduledOrder &scheduled : sequence)
+    {
+        std::cout << scheduled.preamble << scheduled.context.out.str();
+        std::cerr << scheduled.context.err.str();
+
+        for (const auto &draw : scheduled.context.deferredDraws)
+        {
+            OrderJournal::draw(draw.first, draw.second);
+        }
+
+        delete scheduled.order;
+    }
+
+    std::cout << epilogue;
+}
+
+/**
+ * @return The number of levels of the last phase.
+ */
+int OrderScheduler::lastLevelCount() const
+{
+    return levels;
+}
+
+/**
+ * @return The number of orders of the last phase.
+ */
+int OrderScheduler::lastOrderCount() const
+{
+    return orders;
+}
+
+/**
+ * @return The level of every order of the last phase, in sequence order.
+ */
+const std::vector<int> &OrderScheduler::lastOrderLevels() const
+{
+    return orderLevels;
+}
+
+/**
+ * @return The number of levels of the last phase that were spread over the worker threads.
+ */
+int OrderScheduler::lastParallelLevelCount() const
+{
+    return parallelLevels;
+}
+
+/**
+ * @brief Lays out the orders of the players in the sequence of GameEngine::executeOrdersPhase, along with the
+ * messages it prints between them.
+ *
+ * @param players The players of the game.
+ * @param epilogue Receives what the sequential engine prints after the last order.
+ * @return The orders, in sequence.
+ */
+std::vector<OrderScheduler::ScheduledOrder> OrderScheduler::layout(const std::vector<Player *> &players, std::string &epilogue)
+{
+    std::vector<ScheduledOrder> sequence;
+    std::string pending;
+
+    // Every deploy order first, player by player
+    for (Player *player : players)
+    {
+        std::vector<Order *> deployOrders = player->getOrdersList()->extractOrders("deploy");
+
+        if (deployOrders.empty())
+        {
+            pending += "No deploy orders to execute for " + player->getPlayerName() + ".\n";
+            continue;
+        }
+
+        pending += "Deploy Orders Execution Phase for " + player->getPlayerName() + "\n";
+        for (Order *order : deployOrders)
+        {
+            sequence.emplace_back(order, pending);
+            pending.clear();
+        }
+    }
+
+    // Then one order per player at a time
+    bool ordersLeft = true;
+    while (ordersLeft)
+    {
+        ordersLeft = false;
+
+        for (Player *player : players)
+        {
+            Order *order = player->getOrdersList()->popFront();
+
+            if (order == nullptr)
+            {
+                pending += "No more orders to execute for " + player->getPlayerName() + ".\n";
+                continue;
+            }
+
+            pending += "Orders Execution Phase for " + player->getPlayerName() + "\n";
+            sequence.emplace_back(order, pending);
+            pending.clear();
+            ordersLeft = true;
+        }
+    }
+
+    epilogue = pending;
+    return sequence;
+}
+
+/**
+ * @brief Assigns every order to the first level after all the earlier orders it conflicts with: an order reading a
+ * resource comes after its last writer and updater, an order updating a resource comes after its last reader and
+ * writer, and an order writing a resource comes after all of them. A barrier comes after every earlier order, and
+ * every later order comes after it.
+ *
+ * @param sequence The orders, in sequence.
+ * @return The number of levels.
+ */
+int OrderScheduler::assignLevels(std::vector<ScheduledOrder> &sequence)
+{
+    std::vector<int> lastWrite;
+    std::vector<int> lastRead;
+    std::vector<int> lastUpdate;
+    OrderFootprint footprint;
+    int floor = 0;
+    int maxLevel = -1;
+
+    for (ScheduledOrder &scheduled : sequence)
+    {
+        footprint.clear();
+        scheduled.order->footprint(footprint, resources);
+
+        if (lastWrite.size() < static_cast<size_t>(resources.size()))
+        {
+            lastWrite.resize(resources.size(), -1);
+            lastRead.resize(resources.size(), -1);
+            lastUpdate.resize(resources.size(), -1);
+        }
+
+        int level = floor;
+        if (footprint.barrier)
+        {
+            level = std::max(level, maxLevel + 1);
+            floor = level + 1;
+        }
+        else
+        {
+            for (int resource : footprint.reads)
+            {
+                level = std::max(level, std::max(lastWrite[resource], lastUpdate[resource]) + 1);
+            }
+            for (int resource : footprint.updates)
+            {
+                level = std::max(level, std::max(lastWrite[resource], lastRead[resource]) + 1);
+            }
+            for (int resource : footprint.writes)
+            {
+                level = std::max(level, std::max({lastWrite[resource], lastRead[resource], lastUpdate[resource]}) + 1);
+            }
+            for (int resource : footprint.reads)
+            {
+                lastRead[resource] = std::max(lastRead[resource], level);
+            }
+            for (int resource : footprint.updates)
+            {
+                lastUpdate[resource] = std::max(lastUpdate[resource], level);
+            }
+            for (int resource : footprint.writes)
+            {
+                lastWrite[resource] = level;
+            }
+        }
+
+        scheduled.level = level;
+        maxLevel = std::max(maxLevel, level);
+    }
+
+    return maxLevel + 1;
+}
+
+/**
+ * @brief Executes the orders of one level, sharing them with the worker threads when the level is large enough.
+ * The workers are started on the first such level.
+ *
+ * @param level The orders of the level, in sequence order.
+ */
+void OrderScheduler::executeLevel(const std::vector<ScheduledOrder *> &level)
+{
+    nextOrder = 0;
+    if (threads <= 1 || static_cast<int>(level.size()) < PARALLEL_BATCH_MIN)
+    {
+        executeOrders(level);
+        return;
+    }
+
+    while (static_cast<int>(workers.size()) < threads - 1)
+    {
+        workers.emplace_back(&OrderScheduler::work, this);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(workMutex);
+        sharedLevel = &level;
+        workersBusy = static_cast<int>(workers.size());
+        levelsShared++;
+    }
+    workReady.notify_all();
+
+    executeOrders(level);
+
+    std::unique_lock<std::mutex> lock(workMutex);
+    workFinished.wait(lock, [this]() { return workersBusy == 0; });
+    sharedLevel = nullptr;
+    parallelLevels++;
+}
+
+/**
+ * @brief Executes orders of a level until none is left, each with its context, on the calling thread.
+ *
+ * @param level The orders of the level.
+ */
+void OrderScheduler::executeOrders(const std::vector<ScheduledOrder *> &level)
+{
+    for (std::size_t i = nextOrder.fetch_add(1); i < level.size(); i = nextOrder.fetch_add(1))
+    {
+        OrderExecutionContext::active = &level[i]->context;
+        level[i]->order->execute();
+        OrderExecutionContext::active = nullptr;
+    }
+}
+
+/**
+ * @brief The loop of a worker thread: waits for a level to be shared and helps execute it, until stopped.
+ */
+void OrderScheduler::work()
+{
+    unsigned long long levelsSeen = 0;
+
+    while (true)
+    {
+        const std::vector<ScheduledOrder *> *level;
+        {
+            std::unique_lock<std::mutex> lock(workMutex);
+            workReady.wait(lock, [this, levelsSeen]() { return stopping || levelsShared != levelsSeen; });
+            if (stopping)
+            {
+                return;
+            }
+            levelsSeen = levelsShared;
+            level = sharedLevel;
+        }
+
+        executeOrders(*level);
+
+        std::lock_guard<std::mutex> lock(workMutex);
+        if (--workersBusy == 0)
+        {
+            workFinished.notify_one();
+        }
+    }
+}
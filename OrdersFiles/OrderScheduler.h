@@ -0,0 +1,211 @@
+#ifndef ORDER_SCHEDULER_H
+#define ORDER_SCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "OrderFootprint.h"
+#include "OrderValidation.h"
+
+class Order;
+class Player;
+class Deck;
+class Hand;
+class Territory;
+class OrderJournal;
+
+/**
+ * @brief State of the order being executed by the calling thread while the OrderScheduler runs a phase.
+ *
+ * Orders print to the console of their context, which holds their output so it can be replayed in sequential
+ * order, and record their changes in the journal of their context, whichever thread executes them. Card draws, which share the deck and its random number generator between all players, are deferred until
+ * the phase is over, and territories gained are deferred until the level of the order is over.
+ */
+class OrderExecutionContext
+{
+public:
+    std::ostringstream out; ///< What the order printed.
+    std::ostringstream err; ///< What the order printed as errors.
+    std::vector<std::pair<Deck *, Hand *>> deferredDraws; ///< Cards to draw once the phase is over, in order.
+    std::vector<std::pair<Player *, Territory *>> deferredTerritories; ///< Territories to add once the level is over.
+    OrderJournal *journal = nullptr; ///< Records the changes of the order, the journal of the thread running the phase.
+
+    /**
+     * @return The context of the order executed by the calling thread, or nullptr outside of the OrderScheduler.
+     */
+    static OrderExecutionContext *current();
+
+    /**
+     * @return Where orders print: the output of the order executed by the calling thread, or std::cout outside of
+     * the OrderScheduler.
+     */
+    static std::ostream &console();
+
+    /**
+     * @return Where orders print their errors: the errors of the order executed by the calling thread, or
+     * std::cerr outside of the OrderScheduler.
+     */
+    static std::ostream &errors();
+
+    /**
+     * @brief Draws a card from the deck into the hand, or defers the draw when called from the OrderScheduler.
+     *
+     * @param deck The deck to draw from.
+     * @param hand The hand receiving the card.
+     */
+    static void draw(Deck *deck, Hand *hand);
+
+    /**
+     * @brief Adds a territory at the end of a player's territories, or defers it to the end of the level when
+     * called from the OrderScheduler, so orders of the level looking up the player's territories do not race.
+     *
+     * @param player The player.
+     * @param territory The territory gained.
+     */
+    static void addTerritory(Player *player, Territory *territory);
+
+private:
+    friend class OrderScheduler;
+    static thread_local OrderExecutionContext *active;
+};
+
+/**
+ * @brief Executes the orders of an execution phase in conflict-free parallel batches.
+ *
+ * The phase is first laid out in the exact sequence the sequential engine would use: every deploy order player
+ * by player, then one order per player in a round-robin fashion. Each order is then placed on the first level
+ * after every earlier order it conflicts with, according to their footprints. Orders of a level touch disjoint
+ * state, apart from the territories they add to players, which are added in sequence order once the level is
+ * over. Running the levels one after the other, and the orders of a level in any order, gives the same game state
+ * as the sequence. Console output and card draws are held back and replayed in sequence order once every level
+ * has run, so they are the same as well.
+ *
+ * Large levels are spread over worker threads that the scheduler starts on the first such level and keeps until
+ * it is deleted.
+ */
+class OrderScheduler
+{
+public:
+    /**
+     * @brief Smallest level worth spreading over worker threads, smaller levels run on the calling thread.
+     */
+    static const int PARALLEL_BATCH_MIN = 8;
+
+    /**
+     * @param threads The number of worker threads, 0 to use one per hardware thread.
+     */
+    explicit OrderScheduler(int threads = 0);
+
+    OrderScheduler(const OrderScheduler &) = delete;
+    OrderScheduler &operator=(const OrderScheduler &) = delete;
+
+    /**
+     * @brief Stops and joins the worker threads.
+     */
+    ~OrderScheduler();
+
+    /**
+     * @brief Executes and deletes every order of the given players.
+     *
+     * @param players The players of the game, in turn order.
+     * @param map The map of the game, used to resolve territory names.
+     * @param validation The batch that prevalidated the orders, told about the orders of every level once it has
+     * run. May be nullptr.
+     */
+    void executePhase(const std::vector<Player *> &players, const Map *map, OrderValidation *validation = nullptr);
+
+    /**
+     * @return The number of levels of the last phase.
+     */
+    int lastLevelCount() const;
+
+    /**
+     * @return The number of orders of the last phase.
+     */
+    int lastOrderCount() const;
+
+    /**
+     * @return The level of every order of the last phase, in sequence order.
+     */
+    const std::vector<int> &lastOrderLevels() const;
+
+    /**
+     * @return The number of levels of the last phase that were spread over the worker threads.
+     */
+    int lastParallelLevelCount() const;
+
+private:
+    /**
+     * @brief An order at its place in the sequence, with what the sequential engine prints before it.
+     */
+    struct ScheduledOrder
+    {
+        Order *order;
+        std::string preamble;
+        int level = 0;
+        OrderExecutionContext context; ///< Output and card draws of the order, replayed once the phase is over.
+
+        ScheduledOrder(Order *order, const std::string &preamble) : order(order), preamble(preamble) {}
+    };
+
+    int threads;
+    OrderResources resources;
+    int levels = 0;
+    int orders = 0;
+    int parallelLevels = 0;
+    std::vector<int> orderLevels;
+
+    std::vector<std::thread> workers;
+    std::mutex workMutex;
+    std::condition_variable workReady;    ///< Signals the workers that a level is ready, or that they must stop.
+    std::condition_variable workFinished; ///< Signals the calling thread that every worker is done with the level.
+    const std::vector<ScheduledOrder *> *sharedLevel = nullptr; ///< The level the workers help with.
+    std::atomic<std::size_t> nextOrder{0};  ///< The next order of the shared level to execute.
+    unsigned long long levelsShared = 0;    ///< Levels handed to the workers so far, tells a worker a new one is ready.
+    int workersBusy = 0;                    ///< Workers still executing orders of the shared level.
+    bool stopping = false;
+
+    /**
+     * @brief Lays out the orders of the players in sequential execution order, emptying their lists.
+     *
+     * @param players The players of the game.
+     * @param epilogue Receives what the sequential engine prints after the last order.
+     * @return The orders, in sequence.
+     */
+    std::vector<ScheduledOrder> layout(const std::vector<Player *> &players, std::string &epilogue);
+
+    /**
+     * @brief Assigns every order to the first level after all the earlier orders it conflicts with.
+     *
+     * @param sequence The orders, in sequence.
+     * @return The number of levels.
+     */
+    int assignLevels(std::vector<ScheduledOrder> &sequence);
+
+    /**
+     * @brief Executes the orders of one level, in parallel when it is large enough.
+     *
+     * @param level The orders of the level, in sequence order.
+     */
+    void executeLevel(const std::vector<ScheduledOrder *> &level);
+
+    /**
+     * @brief Executes orders of the shared level until none is left, on the calling thread.
+     *
+     * @param level The orders of the level.
+     */
+    void executeOrders(const std::vector<ScheduledOrder *> &level);
+
+    /**
+     * @brief The loop of a worker thread: waits for a level to be shared and helps execute it, until stopped.
+     */
+    void work();
+};
+
+#endif
@@ -0,0 +1,224 @@
+#include "OrderValidation.h"
+#include "Orders.h"
+#include "MapFiles/Map.h"
+#include "PlayerFiles/Player.h"
+
+const int OrderValidation::UNKNOWN;
+const int OrderValidation::VALID;
+
+/**
+ * @brief Validates every order of the given players against the current state of the game, in list order.
+ *
+ * @param players The players of the game.
+ * @param map The map of the game, may be nullptr in which case every order is validated in full.
+ */
+void OrderValidation::prevalidate(const std::vector<Player *> &players, const Map *map)
+{
+    this->map = map;
+    resources.reset(map);
+    indexMap();
+
+    ownership.clear();
+    verdicts.clear();
+    dependencies.clear();
+    dependencyOffsets.assign(1, 0);
+    everythingWritten = false;
+    phase++;
+
+    for (Player *player : players)
+    {
+        for (Order *order : player->getOrdersList()->ordersVector)
+        {
+            order->validation = this;
+            order->validationSlot = static_cast<int>(verdicts.size());
+
+            verdicts.push_back(static_cast<signed char>(order->prevalidate(*this)));
+            dependencyOffsets.push_back(static_cast<int>(dependencies.size()));
+        }
+    }
+}
+
+/**
+ * @param order An order.
+ * @return The verdict recorded for the order, or UNKNOWN if it is no longer reliable.
+ */
+int OrderValidation::verdict(const Order *order) const
+{
+    if (order->validation != this || everythingWritten)
+    {
+        return UNKNOWN;
+    }
+
+    const int slot = order->validationSlot;
+    for (int i = dependencyOffsets[slot]; i < dependencyOffsets[slot + 1]; ++i)
+    {
+        if (writtenInPhase[dependencies[i]] == phase)
+        {
+            return UNKNOWN;
+        }
+    }
+
+    return verdicts[slot];
+}
+
+/**
+ * @brief Marks the territories written by an executed order. Orders that cannot tell what they write drop
+ * every verdict of the phase.
+ *
+ * @param order The order that was executed.
+ */
+void OrderValidation::executed(const Order *order)
+{
+    footprint.clear();
+    order->footprint(footprint, resources);
+
+    if (footprint.barrier)
+    {
+        everythingWritten = true;
+        return;
+    }
+
+    // Keys past the territory ids are players and the negotiation table, which validation does not look at
+    for (int resource : footprint.writes)
+    {
+        if (resource < territories)
+        {
+            writtenInPhase[resource] = phase;
+        }
+    }
+}
+
+/**
+ * @param name The name of a territory, in any case.
+ * @return The id of the territory, or -1 if no single territory of the map has this name.
+ */
+int OrderValidation::territory(const std::string &name) const
+{
+    return resources.territory(name);
+}
+
+/**
+ * @brief Checks whether a player owns a territory, the verdict being computed depends on the territory.
+ *
+ * @param player The player.
+ * @param territory The id of the territory.
+ * @return Whether the territory is among the player's territories.
+ */
+bool OrderValidation::owns(Player *player, int territory)
+{
+    auto it = ownership.find(player);
+    if (it == ownership.end())
+    {
+        it = ownership.emplace(player, std::vector<bool>(territories, false)).first;
+
+        for (Territory *t : player->getOwnedTerritories())
+        {
+            if (t->id >= 0 && t->id < territories)
+            {
+                it->second[t->id] = true;
+            }
+        }
+    }
+
+    dependencies.push_back(territory);
+    return it->second[territory];
+}
+
+/**
+ * @brief Checks whether a player owns a territory adjacent to the given one.
+ *
+ * @param player The player.
+ * @param territory The id of the territory.
+ * @return Whether one of the player's territories has the given territory among its adjacent territories.
+ */
+bool OrderValidation::ownsNeighbourOf(Player *player, int territory)
+{
+    for (int i = incomingOffsets[territory]; i < incomingOffsets[territory + 1]; ++i)
+    {
+        if (owns(player, incomingSources[i]))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @param from The id of a territory.
+ * @param to The id of another territory.
+ * @return Whether the second territory is among the adjacent territories of the first one.
+ */
+bool OrderValidation::adjacent(int from, int to) const
+{
+    for (int i = outgoingOffsets[from]; i < outgoingOffsets[from + 1]; ++i)
+    {
+        if (outgoingTargets[i] == to)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Reads the armies of a territory, the verdict being computed depends on the territory.
+ *
+ * @param territory The id of the territory.
+ * @return The number of armies in the territory.
+ */
+int OrderValidation::armies(int territory)
+{
+    dependencies.push_back(territory);
+    return map->territoriesById[territory]->numberOfArmies;
+}
+
+/**
+ * @brief Rebuilds the adjacency of the map by id, in both directions, when the generation of the map changed: another
+ * map, possibly at the same address, or the same map loaded again or with its adjacency rebuilt.
+ */
+void OrderValidation::indexMap()
+{
+    const std::uint64_t generation = map == nullptr ? 0 : map->GetGeneration();
+    if (generation == indexedGeneration)
+    {
+        return;
+    }
+
+    const int count = map == nullptr ? 0 : static_cast<int>(map->territoriesById.size());
+    indexedGeneration = generation;
+    territories = count;
+    writtenInPhase.assign(count, 0);
+    outgoingOffsets.assign(count + 1, 0);
+    outgoingTargets.clear();
+    incomingOffsets.assign(count + 1, 0);
+
+    for (int id = 0; id < count; ++id)
+    {
+        for (const Territory *adjacent : map->territoriesById[id]->adjacentTerritories)
+        {
+            const int target = adjacent->id;
+            if (target >= 0 && target < count)
+            {
+                outgoingTargets.push_back(target);
+                incomingOffsets[target + 1]++;
+            }
+        }
+        outgoingOffsets[id + 1] = static_cast<int>(outgoingTargets.size());
+    }
+
+    // Counting sort of the edges by target gives the incoming edges of every territory
+    for (int id = 0; id < count; ++id)
+    {
+        incomingOffsets[id + 1] += incomingOffsets[id];
+    }
+
+    incomingSources.assign(outgoingTargets.size(), 0);
+    std::vector<int> next(incomingOffsets.begin(), incomingOffsets.end() - 1);
+    for (int id = 0; id < count; ++id)
+    {
+        for (int i = outgoingOffsets[id]; i < outgoingOffsets[id + 1]; ++i)
+        {
+            incomingSources[next[outgoingTargets[i]]++] = id;
+        }
+    }
+}
@@ -0,0 +1,131 @@
+#ifndef ORDER_VALIDATION_H
+#define ORDER_VALIDATION_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "OrderFootprint.h"
+
+class Map;
+class Order;
+class Player;
+
+/**
+ * @brief Validates every order of an execution phase in one pass, before the first order is executed.
+ *
+ * Orders validate themselves by looking their territories up by name in their player's territories, every time
+ * they are executed. The batch resolves the names once to territory ids and answers the same questions on id
+ * indexed tables built for the phase: which territories a player owns, how many armies a territory holds and
+ * which territories are adjacent. The verdict of every order is recorded along with the territories it depends
+ * on. Executed orders mark the territories they wrote (see Order::footprint), and Order::validate only reuses a
+ * verdict none of whose territories were written since, validating the order in full otherwise.
+ */
+class OrderValidation
+{
+public:
+    /**
+     * @brief Verdict of an order that has to be validated in full.
+     */
+    static const int UNKNOWN = -1;
+
+    /**
+     * @brief Verdict of a valid order. Other verdicts are reasons defined by each order.
+     */
+    static const int VALID = 0;
+
+    /**
+     * @brief Validates every order of the given players against the current state of the game.
+     * Verdicts of a previous phase are forgotten.
+     *
+     * @param players The players of the game.
+     * @param map The map of the game, may be nullptr in which case every order is validated in full.
+     */
+    void prevalidate(const std::vector<Player *> &players, const Map *map);
+
+    /**
+     * @param order An order.
+     * @return The verdict recorded for the order, or UNKNOWN if it was not prevalidated by this batch or if a
+     * territory it depends on was written since.
+     */
+    int verdict(const Order *order) const;
+
+    /**
+     * @brief Marks the territories written by an executed order, the verdicts depending on them are dropped.
+     *
+     * @param order The order that was executed.
+     */
+    void executed(const Order *order);
+
+    /**
+     * @param name The name of a territory, in any case.
+     * @return The id of the territory, or -1 if no single territory of the map has this name.
+     */
+    int territory(const std::string &name) const;
+
+    /**
+     * @brief Checks whether a player owns a territory. The verdict being computed depends on the territory.
+     *
+     * @param player The player.
+     * @param territory The id of the territory.
+     * @return Whether the territory is among the player's territories.
+     */
+    bool owns(Player *player, int territory);
+
+    /**
+     * @brief Checks whether a player owns a territory adjacent to the given one. The verdict being computed
+     * depends on the territories looked at.
+     *
+     * @param player The player.
+     * @param territory The id of the territory.
+     * @return Whether one of the player's territories has the given territory among its adjacent territories.
+     */
+    bool ownsNeighbourOf(Player *player, int territory);
+
+    /**
+     * @param from The id of a territory.
+     * @param to The id of another territory.
+     * @return Whether the second territory is among the adjacent territories of the first one.
+     */
+    bool adjacent(int from, int to) const;
+
+    /**
+     * @brief Reads the armies of a territory. The verdict being computed depends on the territory.
+     *
+     * @param territory The id of the territory.
+     * @return The number of armies in the territory.
+     */
+    int armies(int territory);
+
+private:
+    OrderResources resources;
+    const Map *map = nullptr;
+
+    // Adjacency of the map by territory id, in both directions, kept between phases as long as the generation of the
+    // map is the same
+    std::uint64_t indexedGeneration = 0;
+    int territories = 0;
+    std::vector<int> outgoingOffsets;
+    std::vector<int> outgoingTargets;
+    std::vector<int> incomingOffsets;
+    std::vector<int> incomingSources;
+
+    std::unordered_map<const Player *, std::vector<bool>> ownership; ///< Territories of a player, built on first use.
+
+    // Verdict of every prevalidated order and the territories it depends on, indexed by Order::validationSlot
+    std::vector<signed char> verdicts;
+    std::vector<int> dependencyOffsets;
+    std::vector<int> dependencies;
+
+    unsigned phase = 0;
+    std::vector<unsigned> writtenInPhase; ///< Phase in which each territory was last written by an executed order.
+    bool everythingWritten = false;       ///< Whether a barrier order was executed during the phase.
+    OrderFootprint footprint;
+
+    /**
+     * @brief Rebuilds the adjacency of the map by id when the generation of the map changed.
+     */
+    void indexMap();
+};
+
+#endif
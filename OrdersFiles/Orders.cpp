@@ -1,13 +1,11 @@
-#include <ctime>
-#include <random>
 #include <algorithm>
 #include <sstream>
 #include "Orders.h"
+#include "OrderScheduler.h"
+#include "OrderJournal.h"
 #include "PlayerFiles/Player.h"
 #include "GameEngineFiles/GameEngine.h"
 
-std::unordered_map<std::string, std::string> NegotiateOrder::negotiatedPlayers;
-
 /*
 Note that the orders’ actions do not need to be implemented at this point. Invalid
 orders can be created and put in the list, but their execution will not result in any action.
@@ -45,6 +43,33 @@ void Order::operator=(const Order &order)
     }
 }
 
+/**
+ * @brief Destructor for the Order class.
+ */
+Order::~Order() {}
+
+/**
+ * @brief Allocates an order from the OrderPool.
+ *
+ * @param size The size of the order, in bytes.
+ * @return A pointer to the memory for the order.
+ */
+void *Order::operator new(std::size_t size)
+{
+    return OrderPool::allocate(size);
+}
+
+/**
+ * @brief Returns the memory of an order to the OrderPool.
+ *
+ * @param memory The memory of the order.
+ * @param size The size of the order, in bytes.
+ */
+void Order::operator delete(void *memory, std::size_t size)
+{
+    OrderPool::release(memory, size);
+}
+
 /**
  * @brief Stream insertion operator overload for the Order class.
  * Outputs the orderType to an output stream.
@@ -65,8 +90,13 @@ std::ostream &operator<<(std::ostream &COUT, const Order &ORDER)
  */
 void Order::execute()
 {
-    std::cout << "Executing " << orderType << " order." << std::endl;
-    notify(this);
+    OrderExecutionContext::console() << "Executing " << orderType << " order." << std::endl;
+
+    // Observers are attached to the orders list rather than to every order
+    if (ownerList != nullptr)
+    {
+        ownerList->notify(this);
+    }
 }
 
 std::string Order::stringToLog() const
@@ -76,6 +106,46 @@ std::string Order::stringToLog() const
     return SS.str();
 }
 
+/**
+ * @brief Declares the order as a barrier, an order of unknown type may touch anything.
+ *
+ * @param footprint The footprint to fill.
+ * @param resources Resolves territories and players to resource keys.
+ */
+void Order::footprint(OrderFootprint &footprint, OrderResources & /* resources */) const
+{
+    footprint.barrier = true;
+}
+
+/**
+ * @brief By default an order cannot be prevalidated and is validated in full when executed.
+ *
+ * @param validation The batch validating the orders of the phase.
+ * @return OrderValidation::UNKNOWN.
+ */
+int Order::prevalidate(OrderValidation & /* validation */) const
+{
+    return OrderValidation::UNKNOWN;
+}
+
+/**
+ * @brief By default an order fights no battle.
+ *
+ * @param battles The batch of the orders executed next.
+ */
+void Order::prepareBattle(BattleBatch & /* battles */)
+{
+}
+
+/**
+ * @return The verdict of the batch that prevalidated the order, or OrderValidation::UNKNOWN if the order has to be
+ * validated in full.
+ */
+int Order::prevalidatedVerdict() const
+{
+    return validation == nullptr ? OrderValidation::UNKNOWN : validation->verdict(this);
+}
+
 // ---------------------- Deploy Order ----------------------
 
 /**
@@ -119,44 +189,42 @@ std::ostream &operator<<(std::ostream &COUT, const DeployOrder &ORDER)
 void DeployOrder::validate()
 {
     // Notify that the deploy order is being validated.
-    std::cout << "Validating deploy order..." << std::endl;
+    OrderExecutionContext::console() << "Validating deploy order..." << std::endl;
+
+    // Reuse the verdict of the validation batch on the target territory when it still holds
+    int verdict = prevalidatedVerdict();
 
     // Flag indicating if the target territory was found in the player's owned territories.
-    bool tFound = false;
-    // Flag indicating if the player has enough army units to deploy.
-    bool enoughArmy = false;
-    for (Territory *t : player->toDefend())
+    bool tFound = verdict == OrderValidation::VALID;
+    if (verdict == OrderValidation::UNKNOWN)
     {
-        // If the player's owned territory matches the target territory name
-        if (GameEngine::toLowerCase(t->name) == GameEngine::toLowerCase(territoryDeployName))
+        for (Territory *t : player->toDefend())
         {
-            // The target territory was found.
-            tFound = true;
-
-            // Check if the player has enough army units to deploy to the target territory.
-            if (player->getNumArmies() >= army)
+            // If the player's owned territory matches the target territory name
+            if (GameEngine::toLowerCase(t->name) == GameEngine::toLowerCase(territoryDeployName))
             {
-                // Player has enough army units.
-                enoughArmy = true;
+                // The target territory was found, exit the loop.
+                tFound = true;
+                break;
             }
-
-            // Exit the loop once the target territory is found.
-            break;
         }
     }
 
+    // Flag indicating if the player has enough army units to deploy to the target territory.
+    bool enoughArmy = tFound && player->getNumArmies() >= army;
+
     // If the target territory was not found in the player's owned territories, the order is invalid.
     if (!tFound)
     {
         // Mark the order as invalid.
-        std::cout << "Order Invalid: Target territory not found in " << player->getPlayerName() << "'s owned territories.\n";
+        OrderExecutionContext::console() << "Order Invalid: Target territory not found in " << player->getPlayerName() << "'s owned territories.\n";
         validOrder = false;
     }
     // If the player does not have enough army units, the order is invalid.
     else if (!enoughArmy)
     {
         // Mark the order as invalid.
-        std::cout << "Order Invalid: Not enough army units in " << player->getPlayerName() << "'s reinforcement pool to deploy.\n";
+        OrderExecutionContext::console() << "Order Invalid: Not enough army units in " << player->getPlayerName() << "'s reinforcement pool to deploy.\n";
         validOrder = false;
     }
     // If the target territory is found and the player has enough army units, the order is valid.
@@ -184,18 +252,56 @@ void DeployOrder::execute()
         {
             if (GameEngine::toLowerCase(t->name) == GameEngine::toLowerCase(territoryDeployName))
             {
-                t->numberOfArmies += army;                           // Add the armies to the target territory
-                player->setNumArmies(player->getNumArmies() - army); // Deduct armies from reinforcement pool
-                std::cout << "Successfully deployed " << army << " units to " << t->name << ".\n";
+                OrderJournal::setArmies(t, t->numberOfArmies + army);         // Add the armies to the target territory
+                OrderJournal::setPool(player, player->getNumArmies() - army); // Deduct armies from reinforcement pool
+                OrderExecutionContext::console() << "Successfully deployed " << army << " units to " << t->name << ".\n";
                 break;
             }
         }
     }
     else
     {
-        std::cout << "Deploy order is invalid and will not be executed.\n";
+        OrderExecutionContext::console() << "Deploy order is invalid and will not be executed.\n";
     }
 }
+
+/**
+ * @brief A deploy order adds armies to its territory and takes them from the player's reinforcement pool.
+ * Validation goes through the player's strategy, which may refresh the player's cached lists and look at the
+ * armies of every territory of the player.
+ *
+ * @param footprint The footprint to fill.
+ * @param resources Resolves territories and players to resource keys.
+ */
+void DeployOrder::footprint(OrderFootprint &footprint, OrderResources &resources) const
+{
+    footprint.write(resources.pool(player));
+    footprint.write(resources.territories(player));
+    footprint.write(resources.territory(territoryDeployName));
+
+    for (Territory *t : player->getOwnedTerritories())
+    {
+        footprint.read(t->id);
+    }
+}
+
+/**
+ * @brief Checks that the target territory is owned by the player.
+ *
+ * @param validation The batch validating the orders of the phase.
+ * @return OrderValidation::VALID, TARGET_NOT_OWNED or OrderValidation::UNKNOWN.
+ */
+int DeployOrder::prevalidate(OrderValidation &validation) const
+{
+    const int target = validation.territory(territoryDeployName);
+    if (player == nullptr || target < 0)
+    {
+        return OrderValidation::UNKNOWN;
+    }
+
+    return validation.owns(player, target) ? OrderValidation::VALID : TARGET_NOT_OWNED;
+}
+
 // ---------------------- Advance Order ----------------------
 
 /**
@@ -233,60 +339,74 @@ std::ostream &operator<<(std::ostream &COUT, const AdvanceOrder &ORDER)
  */
 void AdvanceOrder::validate()
 {
-    std::cout << "Validating advance order: " << territoryAdvanceSName << " -> " << territoryAdvanceTName
-              << " with " << army << " armies.\n";
+    OrderExecutionContext::console() << "Validating advance order: " << territoryAdvanceSName << " -> " << territoryAdvanceTName
+                                     << " with " << army << " armies.\n";
 
-    bool sFound = false;
-    bool adjacent = false;
+    // Reuse the verdict of the validation batch when it still holds
+    int verdict = prevalidatedVerdict();
+    if (verdict == OrderValidation::UNKNOWN)
+    {
+        verdict = check();
+    }
+
+    validOrder = verdict == OrderValidation::VALID;
+
+    if (verdict == SOURCE_NOT_OWNED)
+    {
+        OrderExecutionContext::console() << "Order Invalid: Source territory " << territoryAdvanceSName << " not found.\n";
+    }
+    else if (verdict == TARGET_NOT_ADJACENT)
+    {
+        OrderExecutionContext::console() << "Order Invalid: Target territory " << territoryAdvanceTName << " is not adjacent to source.\n";
+    }
+    else if (verdict == NOT_ENOUGH_ARMIES)
+    {
+        OrderExecutionContext::console() << "Order Invalid: Not enough armies in source territory " << territoryAdvanceSName << ".\n";
+    }
+}
+
+/**
+ * @brief Validates the AdvanceOrder by name on the player's territories.
+ *
+ * @return OrderValidation::VALID or the reason the order is invalid.
+ */
+int AdvanceOrder::check() const
+{
     Territory *sourceT = nullptr;
-    Territory *targetT = nullptr;
 
     // Check source territory
     for (Territory *t : player->getOwnedTerritories())
     {
         if (GameEngine::toLowerCase(t->name) == GameEngine::toLowerCase(territoryAdvanceSName))
         {
-            sFound = true;
             sourceT = t;
             break;
         }
     }
 
-    if (!sFound)
+    if (!sourceT)
     {
-        std::cout << "Order Invalid: Source territory " << territoryAdvanceSName << " not found.\n";
-        validOrder = false;
-        return;
+        return SOURCE_NOT_OWNED;
     }
 
     // Check adjacency
-    for (const auto &pair : sourceT->adjacentTerritories)
+    bool adjacent = false;
+    for (Territory *adjacentT : sourceT->adjacentTerritories)
     {
-        if (GameEngine::toLowerCase(pair.second->name) == GameEngine::toLowerCase(territoryAdvanceTName))
+        if (GameEngine::toLowerCase(adjacentT->name) == GameEngine::toLowerCase(territoryAdvanceTName))
         {
             adjacent = true;
-            targetT = pair.second;
             break;
         }
     }
 
     if (!adjacent)
     {
-        std::cout << "Order Invalid: Target territory " << territoryAdvanceTName << " is not adjacent to source.\n";
-        validOrder = false;
-        return;
+        return TARGET_NOT_ADJACENT;
     }
 
     // Validate army count
-    if (sourceT->numberOfArmies >= army)
-    {
-        validOrder = true;
-    }
-    else
-    {
-        std::cout << "Order Invalid: Not enough armies in source territory " << territoryAdvanceSName << ".\n";
-        validOrder = false;
-    }
+    return sourceT->numberOfArmies >= army ? OrderValidation::VALID : NOT_ENOUGH_ARMIES;
 }
 
 /**
@@ -300,11 +420,11 @@ void AdvanceOrder::execute()
     if (validOrder)
     {
         // Check if negotiation prevents the attack
-        if (NegotiateOrder::negotiatedPlayers.count(player->getPlayerName()) > 0 &&
-            NegotiateOrder::negotiatedPlayers.at(player->getPlayerName()) == enemyPlayer->getPlayerName())
+        if (enemyPlayer != nullptr && player->negotiations != nullptr &&
+            player->negotiations->negotiating(player->negotiationIndex, enemyPlayer->negotiationIndex))
         {
-            std::cout << "Advance order prevented due to active negotiation between "
-                      << player->getPlayerName() << " and " << enemyPlayer->getPlayerName() << ".\n";
+            OrderExecutionContext::console() << "Advance order prevented due to active negotiation between "
+                                             << player->getPlayerName() << " and " << enemyPlayer->getPlayerName() << ".\n";
             return; // Exit without executing the attack
         }
 
@@ -317,14 +437,14 @@ void AdvanceOrder::execute()
             if (GameEngine::toLowerCase(t->name) == GameEngine::toLowerCase(territoryAdvanceSName))
             {
                 sourceT = t;
-                sourceT->numberOfArmies -= army; // Deduct armies
+                OrderJournal::setArmies(sourceT, sourceT->numberOfArmies - army); // Deduct armies
                 break;
             }
         }
 
         if (!sourceT)
         {
-            std::cerr << "Error: Source territory not found.\n";
+            OrderExecutionContext::errors() << "Error: Source territory not found.\n";
             return;
         }
 
@@ -335,9 +455,9 @@ void AdvanceOrder::execute()
             if (GameEngine::toLowerCase(t->name) == GameEngine::toLowerCase(territoryAdvanceTName))
             {
                 targetOwned = true;
-                t->numberOfArmies += army; // Add armies
-                std::cout << "Advanced " << army << " units from " << territoryAdvanceSName
-                          << " to defend " << territoryAdvanceTName << ".\n";
+                OrderJournal::setArmies(t, t->numberOfArmies + army); // Add armies
+                OrderExecutionContext::console() << "Advanced " << army << " units from " << territoryAdvanceSName
+                                                 << " to defend " << territoryAdvanceTName << ".\n";
                 break;
             }
         }
@@ -346,76 +466,175 @@ void AdvanceOrder::execute()
         if (!targetOwned)
         {
             // Find the target territory among adjacent ones
-            for (const auto &pair : sourceT->adjacentTerritories)
+            for (Territory *adjacentT : sourceT->adjacentTerritories)
             {
-                if (GameEngine::toLowerCase(pair.second->name) == GameEngine::toLowerCase(territoryAdvanceTName))
+                if (GameEngine::toLowerCase(adjacentT->name) == GameEngine::toLowerCase(territoryAdvanceTName))
                 {
-                    targetT = pair.second;
+                    targetT = adjacentT;
                     break;
                 }
             }
 
             if (!targetT)
             {
-                std::cerr << "Error: Target territory is not adjacent to source territory.\n";
+                OrderExecutionContext::errors() << "Error: Target territory is not adjacent to source territory.\n";
                 return;
             }
 
             int attackingUnits = army;
             int defendingUnits = targetT->numberOfArmies;
 
-            std::mt19937 rng(static_cast<unsigned>(std::time(0)));
-            std::uniform_int_distribution<int> dist(1, 100);
-
-            // Battle loop
-            while (attackingUnits > 0 && defendingUnits > 0)
+            // Use the outcome resolved in a batch for these armies, or fight the battle now
+            if (resolvedBattle.resolvedFor(attackingUnits, defendingUnits))
             {
-                if (dist(rng) < 60)
-                    defendingUnits--;
-                if (dist(rng) < 70)
-                    attackingUnits--;
-                if (attackingUnits == 0 || defendingUnits == 0)
-                    break; // Exit loop when one side loses
+                attackingUnits = resolvedBattle.attackersLeft;
+                defendingUnits = resolvedBattle.defendersLeft;
+            }
+            else
+            {
+                BattleKernel::resolve(attackingUnits, defendingUnits, battleStream(),
+                                      sequence >= 0 ? phaseSeed : BattleKernel::currentSeed());
             }
 
             // Enemy player will become aggressive player if neutral
-            if (enemyPlayer != nullptr && dynamic_cast<NeutralPlayerStrategy*>(enemyPlayer->getStrategy()) != nullptr) {
-                delete enemyPlayer->getStrategy();
-
-                enemyPlayer->setStrategy(new AggressivePlayerStrategy(enemyPlayer));
+            if (enemyPlayer != nullptr && PlayerStrategy::isKind(enemyPlayer->getStrategy(), StrategyKind::NEUTRAL)) {
+                OrderJournal::replaceStrategy(enemyPlayer, new AggressivePlayerStrategy(enemyPlayer));
             }
 
             if (defendingUnits == 0)
             {
-                targetT->numberOfArmies = attackingUnits;
-                std::cout << "Attack successful: " << territoryAdvanceTName
-                          << " conquered with " << attackingUnits << " remaining units.\n";
-                player->getOwnedTerritories().push_back(targetT);
+                OrderJournal::setArmies(targetT, attackingUnits);
+                OrderExecutionContext::console() << "Attack successful: " << territoryAdvanceTName
+                                                 << " conquered with " << attackingUnits << " remaining units.\n";
+                OrderExecutionContext::addTerritory(player, targetT);
 
                 if (enemyPlayer != nullptr)
                 {
-                    enemyPlayer->getOwnedTerritories().erase(std::remove(enemyPlayer->getOwnedTerritories().begin(),
-                                                                         enemyPlayer->getOwnedTerritories().end(), targetT),
-                                                             enemyPlayer->getOwnedTerritories().end());
+                    OrderJournal::removeTerritory(enemyPlayer, targetT);
                 }
 
                 if (player->deck != nullptr)
                 {
-                    player->deck->draw(*player->getPlayerHand());
+                    OrderExecutionContext::draw(player->deck, player->getPlayerHand());
                 }
             }
             else
             {
-                targetT->numberOfArmies = defendingUnits;
-                std::cout << "Attack failed: " << territoryAdvanceTName
-                          << " defended with " << defendingUnits << " units remaining.\n";
+                OrderJournal::setArmies(targetT, defendingUnits);
+                OrderExecutionContext::console() << "Attack failed: " << territoryAdvanceTName
+                                                 << " defended with " << defendingUnits << " units remaining.\n";
             }
         }
     }
     else
     {
-        std::cout << "Advance order is invalid and will not be executed.\n";
+        OrderExecutionContext::console() << "Advance order is invalid and will not be executed.\n";
+    }
+}
+
+/**
+ * @brief An advance order moves armies between its two territories, which it looks up in the player's
+ * territories. A conquest adds the target to the player's territories, an update since no other order looks for
+ * the target alongside it. A conquest also takes the target from the enemy player and may replace the strategy of a
+ * neutral enemy, and draws a card, which is deferred by the scheduler. It also reads the negotiation table.
+ *
+ * @param footprint The footprint to fill.
+ * @param resources Resolves territories and players to resource keys.
+ */
+void AdvanceOrder::footprint(OrderFootprint &footprint, OrderResources &resources) const
+{
+    footprint.read(resources.negotiation());
+    footprint.update(resources.territories(player));
+    footprint.write(resources.territory(territoryAdvanceSName));
+    footprint.write(resources.territory(territoryAdvanceTName));
+
+    if (enemyPlayer != nullptr)
+    {
+        footprint.write(resources.territories(enemyPlayer));
+    }
+}
+
+/**
+ * @brief Checks the source territory, its adjacency to the target and its armies.
+ *
+ * @param validation The batch validating the orders of the phase.
+ * @return OrderValidation::VALID, the reason the order is invalid or OrderValidation::UNKNOWN.
+ */
+int AdvanceOrder::prevalidate(OrderValidation &validation) const
+{
+    const int source = validation.territory(territoryAdvanceSName);
+    const int target = validation.territory(territoryAdvanceTName);
+    if (player == nullptr || source < 0 || target < 0)
+    {
+        return OrderValidation::UNKNOWN;
+    }
+
+    if (!validation.owns(player, source))
+    {
+        return SOURCE_NOT_OWNED;
     }
+    if (!validation.adjacent(source, target))
+    {
+        return TARGET_NOT_ADJACENT;
+    }
+    return validation.armies(source) >= army ? OrderValidation::VALID : NOT_ENOUGH_ARMIES;
+}
+
+/**
+ * @brief Adds the attack on the target territory to the batch when the order is valid and the player does not
+ * own the target. The orders of a batch do not conflict, so the armies of the target are the ones the order
+ * finds when it is executed.
+ *
+ * @param battles The batch of the orders executed next.
+ */
+void AdvanceOrder::prepareBattle(BattleBatch &battles)
+{
+    if (player == nullptr)
+    {
+        return;
+    }
+
+    const int verdict = prevalidatedVerdict();
+    if (verdict != OrderValidation::VALID && (verdict != OrderValidation::UNKNOWN || check() != OrderValidation::VALID))
+    {
+        return;
+    }
+
+    Territory *sourceT = nullptr;
+    for (Territory *t : player->getOwnedTerritories())
+    {
+        if (GameEngine::toLowerCase(t->name) == GameEngine::toLowerCase(territoryAdvanceTName))
+        {
+            return; // A move, not an attack
+        }
+        if (sourceT == nullptr && GameEngine::toLowerCase(t->name) == GameEngine::toLowerCase(territoryAdvanceSName))
+        {
+            sourceT = t;
+        }
+    }
+
+    if (sourceT == nullptr)
+    {
+        return;
+    }
+
+    for (Territory *adjacentT : sourceT->adjacentTerritories)
+    {
+        if (GameEngine::toLowerCase(adjacentT->name) == GameEngine::toLowerCase(territoryAdvanceTName))
+        {
+            battles.add(&resolvedBattle, army, adjacentT->numberOfArmies, battleStream());
+            return;
+        }
+    }
+}
+
+/**
+ * @return The stream of the order's battle, which depends on its position in the phase when it has one.
+ */
+std::uint64_t AdvanceOrder::battleStream() const
+{
+    return sequence >= 0 ? BattleKernel::stream(territoryAdvanceSName, territoryAdvanceTName, sequence)
+                         : BattleKernel::stream(territoryAdvanceSName, territoryAdvanceTName);
 }
 
 // ---------------------- Bomb Order ----------------------
@@ -457,61 +676,61 @@ void BombOrder::setPlayer(Player *p)
  */
 void BombOrder::validate()
 {
-    std::cout << "Validating bomb order...\n";
+    OrderExecutionContext::console() << "Validating bomb order...\n";
 
     if (!player)
     {
-        std::cout << "Order Invalid: Issuing player not specified.\n";
+        OrderExecutionContext::console() << "Order Invalid: Issuing player not specified.\n";
         validOrder = false;
         return;
     }
 
-    bool targetIsEnemy = true; // Assume target is enemy until proven otherwise
-    bool hasAdjacentTerritory = false;
+    // Reuse the verdict of the validation batch when it still holds
+    int verdict = prevalidatedVerdict();
+    if (verdict == OrderValidation::UNKNOWN)
+    {
+        verdict = check();
+    }
+
+    validOrder = verdict == OrderValidation::VALID;
 
+    if (verdict == OWN_TERRITORY)
+    {
+        OrderExecutionContext::console() << "Order Invalid: Cannot bomb own territory " << territoryBombName << ".\n";
+    }
+    else if (verdict == TARGET_NOT_ADJACENT)
+    {
+        OrderExecutionContext::console() << "Order Invalid: Target territory " << territoryBombName
+                                         << " is not adjacent to any territory owned by " << player->getPlayerName() << ".\n";
+    }
+}
+
+/**
+ * @brief Validates the BombOrder by name on the player's territories.
+ *
+ * @return OrderValidation::VALID or the reason the order is invalid.
+ */
+int BombOrder::check() const
+{
     // Check if the target territory is not owned by the player
     for (Territory *t : player->getOwnedTerritories())
     {
         if (GameEngine::toLowerCase(t->name) == GameEngine::toLowerCase(territoryBombName))
         {
-            std::cout << "Order Invalid: Cannot bomb own territory " << territoryBombName << ".\n";
-            validOrder = false;
-            return;
+            return OWN_TERRITORY;
         }
 
         // Check if any of the player's territories are adjacent to the target
-        for (const auto &adjPair : t->adjacentTerritories)
+        for (Territory *adjacentT : t->adjacentTerritories)
         {
-            if (GameEngine::toLowerCase(adjPair.second->name) == GameEngine::toLowerCase(territoryBombName))
+            if (GameEngine::toLowerCase(adjacentT->name) == GameEngine::toLowerCase(territoryBombName))
             {
-                hasAdjacentTerritory = true;
-                break;
+                return OrderValidation::VALID;
             }
         }
-
-        if (hasAdjacentTerritory)
-        {
-            break; // Exit the loop if we found an adjacent territory
-        }
-    }
-
-    if (!hasAdjacentTerritory)
-    {
-        std::cout << "Order Invalid: Target territory " << territoryBombName
-                  << " is not adjacent to any territory owned by " << player->getPlayerName() << ".\n";
-        validOrder = false;
-        return;
     }
 
-    if (!targetIsEnemy)
-    {
-        std::cout << "Order Invalid: Target territory not found among enemy territories.\n";
-        validOrder = false;
-    }
-    else
-    {
-        validOrder = true;
-    }
+    return TARGET_NOT_ADJACENT;
 }
 
 /**
@@ -531,15 +750,15 @@ void BombOrder::execute()
         {
             if (GameEngine::toLowerCase(t->name) == GameEngine::toLowerCase(territoryBombName))
             {
-                t->numberOfArmies /= 2; // Halve the armies
-                std::cout << "Bombing " << territoryBombName << ": Armies reduced to " << t->numberOfArmies << ".\n";
+                OrderJournal::setArmies(t, t->numberOfArmies / 2); // Halve the armies
+                OrderExecutionContext::console() << "Bombing " << territoryBombName << ": Armies reduced to " << t->numberOfArmies << ".\n";
                 break;
             }
         }
     }
     else
     {
-        std::cout << "Bomb order is invalid and will not be executed.\n";
+        OrderExecutionContext::console() << "Bomb order is invalid and will not be executed.\n";
     }
 }
 
@@ -551,6 +770,37 @@ BombOrder::BombOrder(Player *player, const std::string &territoryBombName) : pla
     validOrder = false;
 }
 
+/**
+ * @brief A bomb order halves the armies of its territory. Execution goes through the player's strategy,
+ * which refreshes the player's cached list of territories to attack.
+ *
+ * @param footprint The footprint to fill.
+ * @param resources Resolves territories and players to resource keys.
+ */
+void BombOrder::footprint(OrderFootprint &footprint, OrderResources &resources) const
+{
+    footprint.write(resources.territories(player));
+    footprint.write(resources.territory(territoryBombName));
+}
+
+/**
+ * @brief Checks that the target is adjacent to one of the player's territories. Whether the player's own
+ * territory is rejected depends on the order of the player's territories, so it is left to the full validation.
+ *
+ * @param validation The batch validating the orders of the phase.
+ * @return OrderValidation::VALID, TARGET_NOT_ADJACENT or OrderValidation::UNKNOWN.
+ */
+int BombOrder::prevalidate(OrderValidation &validation) const
+{
+    const int target = validation.territory(territoryBombName);
+    if (player == nullptr || target < 0 || validation.owns(player, target))
+    {
+        return OrderValidation::UNKNOWN;
+    }
+
+    return validation.ownsNeighbourOf(player, target) ? OrderValidation::VALID : TARGET_NOT_ADJACENT;
+}
+
 // ---------------------- BlockadeOrder Class Implementation ----------------------
 
 /**
@@ -591,31 +841,36 @@ std::ostream &operator<<(std::ostream &COUT, const BlockadeOrder &ORDER)
  */
 void BlockadeOrder::validate()
 {
-    std::cout << "Validating blockade order...\n";
+    OrderExecutionContext::console() << "Validating blockade order...\n";
 
     if (!player)
     {
-        std::cout << "Order Invalid: Issuing player not specified.\n";
+        OrderExecutionContext::console() << "Order Invalid: Issuing player not specified.\n";
         validOrder = false;
         return;
     }
 
-    bool targetIsOwned = false;
-
-    // Check if the target territory is owned by the player
-    for (Territory *t : player->getOwnedTerritories())
+    // Reuse the verdict of the validation batch when it still holds
+    int verdict = prevalidatedVerdict();
+    if (verdict == OrderValidation::UNKNOWN)
     {
-        if (GameEngine::toLowerCase(t->name) == GameEngine::toLowerCase(territoryBlockadeName))
+        verdict = TARGET_NOT_OWNED;
+
+        // Check if the target territory is owned by the player
+        for (Territory *t : player->getOwnedTerritories())
         {
-            targetIsOwned = true;
-            break;
+            if (GameEngine::toLowerCase(t->name) == GameEngine::toLowerCase(territoryBlockadeName))
+            {
+                verdict = OrderValidation::VALID;
+                break;
+            }
         }
     }
 
-    if (!targetIsOwned)
+    if (verdict == TARGET_NOT_OWNED)
     {
-        std::cout << "Order Invalid: Target territory " << territoryBlockadeName << " is not owned by "
-                  << player->getPlayerName() << ".\n";
+        OrderExecutionContext::console() << "Order Invalid: Target territory " << territoryBlockadeName << " is not owned by "
+                                         << player->getPlayerName() << ".\n";
         validOrder = false;
     }
     else
@@ -647,26 +902,61 @@ void BlockadeOrder::execute()
         if (it != ownedTerritories.end())
         {
             Territory *targetTerritory = *it;
-            targetTerritory->numberOfArmies *= 3; // Triple the armies in the territory
+            OrderJournal::setArmies(targetTerritory, targetTerritory->numberOfArmies * 3); // Triple the armies in the territory
 
             // Remove the territory from the current player's list
-            ownedTerritories.erase(it);
+            OrderJournal::removeTerritoryAt(player, it - ownedTerritories.begin());
 
             // Transfer ownership to the Neutral player
             // Assuming `neutralPlayer` is a global or accessible instance of the Neutral player
-            neutralPlayer->getOwnedTerritories().push_back(targetTerritory);
+            OrderExecutionContext::addTerritory(neutralPlayer, targetTerritory);
 
-            std::cout << "Blockading " << territoryBlockadeName << ": Armies increased to "
-                      << targetTerritory->numberOfArmies
-                      << " and territory is now owned by the Neutral player.\n";
+            OrderExecutionContext::console() << "Blockading " << territoryBlockadeName << ": Armies increased to "
+                                             << targetTerritory->numberOfArmies
+                                             << " and territory is now owned by the Neutral player.\n";
         }
     }
     else
     {
-        std::cout << "Blockade order is invalid and will not be executed.\n";
+        OrderExecutionContext::console() << "Blockade order is invalid and will not be executed.\n";
     }
 }
 
+/**
+ * @brief A blockade order triples the armies of its territory and hands it from the player to the neutral player,
+ * which only adds to the territories of the neutral player.
+ *
+ * @param footprint The footprint to fill.
+ * @param resources Resolves territories and players to resource keys.
+ */
+void BlockadeOrder::footprint(OrderFootprint &footprint, OrderResources &resources) const
+{
+    footprint.write(resources.territories(player));
+    footprint.write(resources.territory(territoryBlockadeName));
+
+    if (neutralPlayer != nullptr)
+    {
+        footprint.update(resources.territories(neutralPlayer));
+    }
+}
+
+/**
+ * @brief Checks that the target territory is owned by the player.
+ *
+ * @param validation The batch validating the orders of the phase.
+ * @return OrderValidation::VALID, TARGET_NOT_OWNED or OrderValidation::UNKNOWN.
+ */
+int BlockadeOrder::prevalidate(OrderValidation &validation) const
+{
+    const int target = validation.territory(territoryBlockadeName);
+    if (player == nullptr || target < 0)
+    {
+        return OrderValidation::UNKNOWN;
+    }
+
+    return validation.owns(player, target) ? OrderValidation::VALID : TARGET_NOT_OWNED;
+}
+
 // ---------------------- AirliftOrder Class Implementation ----------------------
 
 /**
@@ -710,16 +1000,16 @@ std::ostream &operator<<(std::ostream &COUT, const AirliftOrder &ORDER)
  */
 void AirliftOrder::validate()
 {
-    std::cout << "Validating airlift order...\n";
+    OrderExecutionContext::console() << "Validating airlift order...\n";
     for (Territory *t : player->getOwnedTerritories())
     {
 
-        std::cout << t->name;
+        OrderExecutionContext::console() << t->name;
     }
 
     if (!player)
     {
-        std::cout << "Order Invalid: Issuing player not specified.\n";
+        OrderExecutionContext::console() << "Order Invalid: Issuing player not specified.\n";
         validOrder = false;
         return;
     }
@@ -748,17 +1038,17 @@ void AirliftOrder::validate()
 
     if (!sourceT)
     {
-        std::cout << "Order Invalid: Source territory not found in " << player->getPlayerName() << "'s owned territories.\n";
+        OrderExecutionContext::console() << "Order Invalid: Source territory not found in " << player->getPlayerName() << "'s owned territories.\n";
         validOrder = false;
     }
     else if (!targetT)
     {
-        std::cout << "Order Invalid: Target territory not found in " << player->getPlayerName() << "'s owned territories.\n";
+        OrderExecutionContext::console() << "Order Invalid: Target territory not found in " << player->getPlayerName() << "'s owned territories.\n";
         validOrder = false;
     }
     else if (sourceT->numberOfArmies < army)
     {
-        std::cout << "Order Invalid: Not enough army units in source territory " << sourceT->name << " for airlift.\n";
+        OrderExecutionContext::console() << "Order Invalid: Not enough army units in source territory " << sourceT->name << " for airlift.\n";
         validOrder = false;
     }
     else
@@ -784,22 +1074,36 @@ void AirliftOrder::execute()
         {
             if (GameEngine::toLowerCase(t->name) == GameEngine::toLowerCase(territoryAirliftSName))
             {
-                t->numberOfArmies -= army; // Deduct armies from source
+                OrderJournal::setArmies(t, t->numberOfArmies - army); // Deduct armies from source
             }
             else if (GameEngine::toLowerCase(t->name) == GameEngine::toLowerCase(territoryAirliftTName))
             {
-                t->numberOfArmies += army; // Add armies to target
-                std::cout << "Airlifting " << army << " units from " << territoryAirliftSName
-                          << " to " << territoryAirliftTName << ".\n";
+                OrderJournal::setArmies(t, t->numberOfArmies + army); // Add armies to target
+                OrderExecutionContext::console() << "Airlifting " << army << " units from " << territoryAirliftSName
+                                                 << " to " << territoryAirliftTName << ".\n";
             }
         }
     }
     else
     {
-        std::cout << "Airlift order is invalid and will not be executed.\n";
+        OrderExecutionContext::console() << "Airlift order is invalid and will not be executed.\n";
     }
 }
 
+/**
+ * @brief An airlift order moves armies between two territories of the player, which it looks up in the
+ * player's territories.
+ *
+ * @param footprint The footprint to fill.
+ * @param resources Resolves territories and players to resource keys.
+ */
+void AirliftOrder::footprint(OrderFootprint &footprint, OrderResources &resources) const
+{
+    footprint.read(resources.territories(player));
+    footprint.write(resources.territory(territoryAirliftSName));
+    footprint.write(resources.territory(territoryAirliftTName));
+}
+
 // ---------------------- NegotiateOrder Class Implementation ----------------------
 
 /**
@@ -836,11 +1140,11 @@ NegotiateOrder::NegotiateOrder(Player *p, std::string pTargetName)
  */
 void NegotiateOrder::validate()
 {
-    std::cout << "Validating negotiate order...\n";
+    OrderExecutionContext::console() << "Validating negotiate order...\n";
 
     if (!player || player->getPlayerName() == playerTargetName)
     {
-        std::cout << "Order Invalid: Negotiation requires two distinct players.\n";
+        OrderExecutionContext::console() << "Order Invalid: Negotiation requires two distinct players.\n";
         validOrder = false;
         return;
     }
@@ -850,7 +1154,7 @@ void NegotiateOrder::validate()
 
 /**
  * @brief Executes the NegotiateOrder.
- * Marks the negotiation as successful, preventing attacks between the two players.
+ * Marks the negotiation as successful, preventing attacks between the two players until the end of the turn.
  */
 void NegotiateOrder::execute()
 {
@@ -860,19 +1164,19 @@ void NegotiateOrder::execute()
     {
         Order::execute();
 
-        // Placeholder for negotiation logic enforcement
-        // This would ideally be checked in the main game loop to prevent attacks between negotiated players
-
-        std::cout << "Negotiation order executed between " << player->getPlayerName()
-                  << " and " << playerTargetName << ". Attacks between these players are now prevented.\n";
+        OrderExecutionContext::console() << "Negotiation order executed between " << player->getPlayerName()
+                                         << " and " << playerTargetName << ". Attacks between these players are now prevented.\n";
 
-        // Notify the game engine or a higher-level mechanism that the players are negotiating
-        negotiatedPlayers[player->getPlayerName()] = playerTargetName;
-        negotiatedPlayers[playerTargetName] = player->getPlayerName();
+        // Record the negotiation in the game's matrix, advance orders check it until the end of the turn
+        Player *targetPlayer = player->negotiations == nullptr ? nullptr : player->negotiations->findPlayer(playerTargetName);
+        if (targetPlayer != nullptr)
+        {
+            OrderJournal::negotiate(player->negotiations, player->negotiationIndex, targetPlayer->negotiationIndex);
+        }
     }
     else
     {
-        std::cout << "Negotiate order is invalid and will not be executed.\n";
+        OrderExecutionContext::console() << "Negotiate order is invalid and will not be executed.\n";
     }
 }
 
@@ -880,6 +1184,17 @@ NegotiateOrder::NegotiateOrder(std::string pTargetNAme) : playerTargetName(pTarg
 {
 }
 
+/**
+ * @brief A negotiate order only updates the negotiation table.
+ *
+ * @param footprint The footprint to fill.
+ * @param resources Resolves territories and players to resource keys.
+ */
+void NegotiateOrder::footprint(OrderFootprint &footprint, OrderResources &resources) const
+{
+    footprint.write(resources.negotiation());
+}
+
 // ---------------------- OrdersList Class Implementation ----------------------
 
 /**
@@ -920,6 +1235,7 @@ void OrdersList::operator=(const OrdersList &ordersList)
  */
 void OrdersList::add(Order *order)
 {
+    order->ownerList = this;
     ordersVector.push_back(order);
     notify(this);
 }
@@ -1002,6 +1318,50 @@ void OrdersList::remove(int orderPos)
     }
 }
 
+/**
+ * @brief Removes the first Order of the list and hands it over to the caller.
+ *
+ * @return The first order, or nullptr if the list is empty.
+ */
+Order *OrdersList::popFront()
+{
+    if (ordersVector.empty())
+    {
+        return nullptr;
+    }
+
+    Order *order = ordersVector.front();
+    ordersVector.pop_front();
+    return order;
+}
+
+/**
+ * @brief Removes every Order of the given type from the list, keeping the relative order of the others.
+ *
+ * @param orderType The type of the orders to extract.
+ * @return The extracted orders, in list order.
+ */
+std::vector<Order *> OrdersList::extractOrders(const std::string &orderType)
+{
+    std::vector<Order *> extracted;
+    auto kept = ordersVector.begin();
+
+    for (auto it = ordersVector.begin(); it != ordersVector.end(); ++it)
+    {
+        if ((*it)->orderType == orderType)
+        {
+            extracted.push_back(*it);
+        }
+        else
+        {
+            *kept++ = *it;
+        }
+    }
+
+    ordersVector.erase(kept, ordersVector.end());
+    return extracted;
+}
+
 /**
  * @brief Stream insertion operator overload for the OrdersList class.
  * Outputs the list of orders with their positions to an output stream.
@@ -1,18 +1,23 @@
 #ifndef ORDERS_H
 #define ORDERS_H
 
+#include <deque>
 #include <vector>
 #include <string>
 #include <iostream>
 #include "LogFiles/LoggingObserver.h"
-#include <unordered_map>
+#include "OrderPool.h"
+#include "OrderFootprint.h"
+#include "OrderValidation.h"
+#include "BattleKernel.h"
 class Player;
+class OrdersList;
 
 /**
  * @brief The base class representing an Order in the game.
  * Defines a generic order with type and validation/execution mechanisms.
  */
-class Order : public Subject, public ILoggable
+class Order : public ILoggable
 {
 public:
     /**
@@ -23,6 +28,43 @@ public:
     // A flag indicating whether the order has been validated and is ready for execution.
     bool validOrder;
 
+    /**
+     * @brief The orders list the order was added to, if any.
+     * Orders have no observers of their own, they report their execution to the observers of this list.
+     */
+    OrdersList *ownerList = nullptr;
+
+    /**
+     * @brief The batch that prevalidated the order for the current execution phase, if any, and the slot of the
+     * order's verdict in it.
+     */
+    OrderValidation *validation = nullptr;
+    int validationSlot = -1;
+
+    /**
+     * @brief The position of the order in its execution phase and the seed of the battles of the phase, set by the
+     * engine before the order is executed so that its battle does not depend on the thread or level fighting it. An
+     * order executed on its own has no position and rolls from BattleKernel::currentSeed.
+     */
+    int sequence = -1;
+    std::uint64_t phaseSeed = 0;
+
+    /**
+     * @brief Allocates orders from the OrderPool slabs rather than one heap allocation each.
+     *
+     * @param size The size of the order, in bytes.
+     * @return A pointer to the memory for the order.
+     */
+    static void *operator new(std::size_t size);
+
+    /**
+     * @brief Returns the memory of a deleted order to the OrderPool.
+     *
+     * @param memory The memory of the order.
+     * @param size The size of the order, in bytes.
+     */
+    static void operator delete(void *memory, std::size_t size);
+
     /**
      * @brief Validates whether the order is valid.
      * This method is purely virtual and must be implemented by derived classes.
@@ -35,6 +77,32 @@ public:
      */
     virtual void execute() = 0;
 
+    /**
+     * @brief Declares the game state the order reads and writes when it is validated and executed.
+     * Used by the OrderScheduler to run independent orders in parallel. The default declares a barrier.
+     *
+     * @param footprint The footprint to fill.
+     * @param resources Resolves territories and players to resource keys.
+     */
+    virtual void footprint(OrderFootprint &footprint, OrderResources &resources) const;
+
+    /**
+     * @brief Validates the order on the id indexed state of an OrderValidation batch, without printing anything.
+     * The default cannot tell and leaves the order to be validated in full.
+     *
+     * @param validation The batch, which records the territories the verdict depends on.
+     * @return OrderValidation::VALID, a reason the order is invalid, or OrderValidation::UNKNOWN.
+     */
+    virtual int prevalidate(OrderValidation &validation) const;
+
+    /**
+     * @brief Adds the battle the order is about to fight, if any, to a batch resolved before the order is executed.
+     * The default fights no battle.
+     *
+     * @param battles The batch of the orders executed next.
+     */
+    virtual void prepareBattle(BattleBatch &battles);
+
     /**
      * @brief Default constructor for the Order class.
      * Initializes the orderType to "unknown".
@@ -57,6 +125,11 @@ public:
      */
     void operator=(const Order &order);
 
+    /**
+     * @brief Virtual destructor, orders are owned and deleted through Order pointers.
+     */
+    virtual ~Order();
+
     /**
      * @brief Stream insertion operator overload for the Order class.
      * Outputs the order details to an output stream.
@@ -68,6 +141,13 @@ public:
     friend std::ostream &operator<<(std::ostream &COUT, const Order &ORDER);
 
     std::string stringToLog() const override;
+
+protected:
+    /**
+     * @return The verdict of the batch that prevalidated the order, or OrderValidation::UNKNOWN if the order has
+     * to be validated in full.
+     */
+    int prevalidatedVerdict() const;
 };
 
 /**
@@ -78,9 +158,10 @@ class OrdersList : public Subject, public ILoggable
 {
 public:
     /**
-     * @brief Vector containing pointers to the list of orders.
+     * @brief Queue containing pointers to the list of orders, in execution order.
+     * A deque keeps positional access for move and remove while popping the front in constant time.
      */
-    std::vector<Order *> ordersVector;
+    std::deque<Order *> ordersVector;
 
     /**
      * @brief Adds an Order to the list of orders.
@@ -107,6 +188,22 @@ public:
      */
     void remove(int orderPos);
 
+    /**
+     * @brief Removes the first Order of the list and hands it over to the caller.
+     *
+     * @return The first order, or nullptr if the list is empty. The caller becomes responsible for deleting it.
+     */
+    Order *popFront();
+
+    /**
+     * @brief Removes every Order of the given type from the list, keeping the relative order of the others.
+     * The list is compacted in a single pass.
+     *
+     * @param orderType The type of the orders to extract (e.g., "deploy").
+     * @return The extracted orders, in list order. The caller becomes responsible for deleting them.
+     */
+    std::vector<Order *> extractOrders(const std::string &orderType);
+
     /**
      * @brief Default constructor for the OrdersList class.
      */
@@ -154,6 +251,14 @@ public:
 class DeployOrder : public Order
 {
 public:
+    /**
+     * @brief Reasons a deploy order is invalid. The reinforcement pool is left out, it is always checked live.
+     */
+    enum Verdict
+    {
+        TARGET_NOT_OWNED = 1
+    };
+
     // The name of the territory where army units are to be deployed.
     std::string territoryDeployName;
     // The number of army units to be deployed to the specified territory.
@@ -187,6 +292,16 @@ public:
      * Deploys troops if the order is valid.
      */
     void execute() override;
+
+    /**
+     * @brief Declares the state read and written by the DeployOrder.
+     */
+    void footprint(OrderFootprint &footprint, OrderResources &resources) const override;
+
+    /**
+     * @brief Checks that the target territory is owned by the player.
+     */
+    int prevalidate(OrderValidation &validation) const override;
 };
 
 /**
@@ -196,6 +311,16 @@ public:
 class AdvanceOrder : public Order
 {
 public:
+    /**
+     * @brief Reasons an advance order is invalid.
+     */
+    enum Verdict
+    {
+        SOURCE_NOT_OWNED = 1,
+        TARGET_NOT_ADJACENT,
+        NOT_ENOUGH_ARMIES
+    };
+
     // The name of the territory from which the army will advance.
     std::string territoryAdvanceSName;
     // The name of the territory to which the army will advance.
@@ -205,6 +330,8 @@ public:
     // A pointer to the player who issued the advance order.
     Player *player;
     Player *enemyPlayer;
+    // The outcome of the order's battle when it was resolved in a batch ahead of execution.
+    BattleOutcome resolvedBattle;
 
     /**
      * @brief Constructor for AdvanceOrder.
@@ -233,6 +360,34 @@ public:
      * Advances troops if the order is valid.
      */
     void execute() override;
+
+    /**
+     * @brief Declares the state read and written by the AdvanceOrder.
+     */
+    void footprint(OrderFootprint &footprint, OrderResources &resources) const override;
+
+    /**
+     * @brief Checks the source territory, its adjacency to the target and its armies.
+     */
+    int prevalidate(OrderValidation &validation) const override;
+
+    /**
+     * @brief Adds the attack on the target territory to the batch, when the order is valid and attacks.
+     */
+    void prepareBattle(BattleBatch &battles) override;
+
+private:
+    /**
+     * @return The stream of the order's battle, which depends on its position in the phase when it has one.
+     */
+    std::uint64_t battleStream() const;
+
+    /**
+     * @brief Validates the order by name on the player's territories, without printing anything.
+     *
+     * @return OrderValidation::VALID or the reason the order is invalid.
+     */
+    int check() const;
 };
 
 /**
@@ -242,6 +397,15 @@ public:
 class BombOrder : public Order
 {
 public:
+    /**
+     * @brief Reasons a bomb order is invalid, other than a missing player.
+     */
+    enum Verdict
+    {
+        OWN_TERRITORY = 1,
+        TARGET_NOT_ADJACENT
+    };
+
     void setPlayer(Player *p);
 
     std::string territoryBombName;
@@ -273,6 +437,25 @@ public:
      * Bombs the target if the order is valid.
      */
     void execute() override;
+
+    /**
+     * @brief Declares the state read and written by the BombOrder.
+     */
+    void footprint(OrderFootprint &footprint, OrderResources &resources) const override;
+
+    /**
+     * @brief Checks that the target is adjacent to one of the player's territories. Bombing one of the player's own
+     * territories depends on the order of the player's territories and is left to the full validation.
+     */
+    int prevalidate(OrderValidation &validation) const override;
+
+private:
+    /**
+     * @brief Validates the order by name on the player's territories, without printing anything.
+     *
+     * @return OrderValidation::VALID or the reason the order is invalid.
+     */
+    int check() const;
 };
 
 /**
@@ -282,6 +465,14 @@ public:
 class BlockadeOrder : public Order
 {
 public:
+    /**
+     * @brief Reasons a blockade order is invalid, other than a missing player.
+     */
+    enum Verdict
+    {
+        TARGET_NOT_OWNED = 1
+    };
+
     // The name of the territory to block.
     std::string territoryBlockadeName;
     Player *player;
@@ -313,6 +504,16 @@ public:
      * Initiates a blockade if the order is valid.
      */
     void execute() override;
+
+    /**
+     * @brief Declares the state read and written by the BlockadeOrder.
+     */
+    void footprint(OrderFootprint &footprint, OrderResources &resources) const override;
+
+    /**
+     * @brief Checks that the target territory is owned by the player.
+     */
+    int prevalidate(OrderValidation &validation) const override;
 };
 
 /**
@@ -358,6 +559,11 @@ public:
      * Airlifts units if the order is valid.
      */
     void execute() override;
+
+    /**
+     * @brief Declares the state read and written by the AirliftOrder.
+     */
+    void footprint(OrderFootprint &footprint, OrderResources &resources) const override;
 };
 
 /**
@@ -370,7 +576,6 @@ public:
     // The name of the player to negotiate with.
     std::string playerTargetName;
     Player *player;
-    static std::unordered_map<std::string, std::string> negotiatedPlayers;
     void setPlayer(Player *p);
 
     /**
@@ -399,6 +604,11 @@ public:
      * Negotiates peace if the order is valid.
      */
     void execute() override;
+
+    /**
+     * @brief Declares the state read and written by the NegotiateOrder.
+     */
+    void footprint(OrderFootprint &footprint, OrderResources &resources) const override;
 };
 
 #endif
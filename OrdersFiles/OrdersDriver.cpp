@@ -7,6 +7,15 @@
 #include "CardsFiles/Cards.h"
 #include "PlayerFiles/Player.h"
 #include "MapFiles/Map.h"
+#include "PlayerFiles/PlayerStrategies.h"
+#include "OrderJournal.h"
+#include "CombatOdds.h"
+#include "OrderScheduler.h"
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <set>
+#include <thread>
 void testOrdersLists() {
     OrdersList ordersList;
 
@@ -111,6 +120,10 @@ void testOrderExecution()
     player1.deck = &deck;
     player2.deck = &deck;
 
+    // Index the players in the negotiations, as the game engine does at the start of every turn
+    NegotiationMatrix negotiations;
+    negotiations.beginTurn({&player1, &player2, &neutralPlayer});
+
     // Test 1: Deploy Order
     std::cout << "=== Testing Deploy Order ===\n";
     DeployOrder* deployOrder = new DeployOrder(&player1, "Lachine", 14);
@@ -250,4 +263,591 @@ void testOrderExecution()
     delete invalidAirliftEnemyTarget;
     delete invalidAirliftTooMany;
     delete invalidNegotiateSelf;
-}
\ No newline at end of file
+}
+// Test function to demonstrate undoing and redoing the changes made by executed orders
+void testOrderJournal()
+{
+    Map *gameMap = new Map();
+    MapLoader mapLoader;
+    mapLoader.LoadMap("../SomeMapsFromOnline/Montreal/Grand Montreal.map", gameMap);
+
+    Player player1("Player1", {gameMap->territories["Lachine"], gameMap->territories["Cote St-Luc"]});
+    Player player2("Player2", {gameMap->territories["NDG CDN"], gameMap->territories["Mont Royal"]});
+    Player neutralPlayer("Neutral");
+    player1.setStrategy(new AggressivePlayerStrategy(&player1));
+    player2.setStrategy(new NeutralPlayerStrategy(&player2));
+    neutralPlayer.setStrategy(new NeutralPlayerStrategy(&neutralPlayer));
+    player1.setNumArmies(20);
+
+    Deck deck;
+    player1.deck = &deck;
+
+    NegotiationMatrix negotiations;
+    negotiations.beginTurn({&player1, &player2, &neutralPlayer});
+
+    // Describes everything the orders below may change
+    auto describe = [&]()
+    {
+        std::ostringstream state;
+        for (Player *player : {&player1, &player2, &neutralPlayer})
+        {
+            state << player->getPlayerName() << " pool " << player->getNumArmies()
+                  << " cards " << player->getPlayerHand()->size()
+                  << " strategy " << player->getStrategy() << " owns";
+            for (Territory *territory : player->getOwnedTerritories())
+            {
+                state << " " << territory->name << "(" << territory->numberOfArmies << ")";
+            }
+            state << "\n";
+        }
+        state << "Deck " << deck.size() << " cards\n";
+        state << "Player1 and Player2 negotiating " << negotiations.negotiating(0, 1) << "\n";
+        return state.str();
+    };
+
+    const std::string before = describe();
+    std::cout << "=== Before the orders ===\n" << before;
+
+    BlockadeOrder *blockadeOrder = new BlockadeOrder("Cote St-Luc");
+    blockadeOrder->player = &player1;
+    blockadeOrder->neutralPlayer = &neutralPlayer;
+    std::vector<Order *> orders = {
+        new DeployOrder(&player1, "Lachine", 14),
+        new AdvanceOrder(&player1, &player2, "Lachine", "NDG CDN", 14),
+        blockadeOrder,
+        new NegotiateOrder(&player1, "Player2")};
+
+    OrderJournal journal;
+    journal.start();
+    for (Order *order : orders)
+    {
+        order->execute();
+    }
+    journal.stop();
+
+    const std::string after = describe();
+    std::cout << "\n=== After the orders (" << journal.size() << " changes recorded) ===\n" << after;
+
+    journal.undo();
+    std::cout << "\n=== After undo ===\n" << describe();
+    std::cout << "State restored: " << (describe() == before ? "yes" : "no") << "\n";
+
+    journal.redo();
+    std::cout << "\n=== After redo ===\n" << describe();
+    std::cout << "State replayed: " << (describe() == after ? "yes" : "no") << "\n";
+
+    for (Order *order : orders)
+    {
+        delete order;
+    }
+
+    // Orders the OrderScheduler spreads over its workers are recorded by the journal of the thread running the phase
+    std::vector<Player *> deployers;
+    for (int i = 0; i < OrderScheduler::PARALLEL_BATCH_MIN; ++i)
+    {
+        Territory *territory = gameMap->territoriesById[i];
+        Player *deployer = new Player("Deployer" + std::to_string(i), {territory});
+        deployer->setStrategy(new AggressivePlayerStrategy(deployer));
+        deployer->setNumArmies(10);
+        deployer->getOrdersList()->add(new DeployOrder(deployer, territory->name, 4));
+        deployers.push_back(deployer);
+    }
+    auto describeDeployers = [&]()
+    {
+        std::ostringstream state;
+        for (Player *deployer : deployers)
+        {
+            state << deployer->getPlayerName() << " pool " << deployer->getNumArmies() << " "
+                  << deployer->getOwnedTerritories().front()->name << "("
+                  << deployer->getOwnedTerritories().front()->numberOfArmies << ")\n";
+        }
+        return state.str();
+    };
+
+    const std::string beforePhase = describeDeployers();
+    OrderScheduler scheduler(4);
+    OrderJournal phaseJournal;
+    phaseJournal.start();
+    std::ostringstream silenced;
+    std::streambuf *console = std::cout.rdbuf(silenced.rdbuf());
+    scheduler.executePhase(deployers, gameMap);
+    std::cout.rdbuf(console);
+    phaseJournal.stop();
+
+    std::cout << "\n=== After " << deployers.size() << " deploys run by the scheduler ("
+              << scheduler.lastParallelLevelCount() << " level(s) on its workers, " << phaseJournal.size()
+              << " changes recorded) ===\n" << describeDeployers();
+    phaseJournal.undo();
+    std::cout << "State restored: " << (describeDeployers() == beforePhase ? "yes" : "no") << "\n";
+
+    for (Player *deployer : deployers)
+    {
+        deployer->setOwnedTerritories({});
+        delete deployer;
+    }
+    delete gameMap;
+}
+
+// Test function to demonstrate resolving many battles at once
+void testBattleKernel()
+{
+    const std::size_t battles = 1000000;
+    const std::uint64_t seed = 345;
+    std::vector<int> attackers(battles);
+    std::vector<int> defenders(battles);
+    std::vector<std::uint64_t> streams(battles);
+    for (std::size_t i = 0; i < battles; ++i)
+    {
+        attackers[i] = 1 + static_cast<int>(i % 20);
+        defenders[i] = 1 + static_cast<int>((i / 20) % 20);
+        streams[i] = i;
+    }
+
+    std::vector<int> attackersLeft = attackers;
+    std::vector<int> defendersLeft = defenders;
+    auto start = std::chrono::steady_clock::now();
+    BattleKernel::resolve(attackersLeft.data(), defendersLeft.data(), streams.data(), battles, seed);
+    std::chrono::duration<double> batchTime = std::chrono::steady_clock::now() - start;
+
+    // Every battle of the batch has the outcome it has on its own
+    std::size_t mismatches = 0;
+    std::size_t conquests = 0;
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < battles; ++i)
+    {
+        int attackersAlone = attackers[i];
+        int defendersAlone = defenders[i];
+        BattleKernel::resolve(attackersAlone, defendersAlone, streams[i], seed);
+        mismatches += attackersAlone != attackersLeft[i] || defendersAlone != defendersLeft[i];
+        conquests += defendersLeft[i] == 0;
+    }
+    std::chrono::duration<double> singleTime = std::chrono::steady_clock::now() - start;
+
+    std::cout << "Resolved " << battles << " battles in a batch in " << batchTime.count() << "s and one by one in "
+              << singleTime.count() << "s\n";
+    std::cout << "Battles whose outcome differs: " << mismatches << "\n";
+    std::cout << "Territories conquered: " << conquests << "\n";
+}
+
+// Test function to demonstrate the odds of battles against simulated battles
+void testCombatOdds()
+{
+    const int battles = 100000;
+    const int pairs[][2] = {{1, 1}, {5, 3}, {10, 10}, {20, 12}, {100, 80}, {300, 250}};
+
+    for (const auto &pair : pairs)
+    {
+        int conquests = 0;
+        double attackersLeft = 0;
+        for (int i = 0; i < battles; ++i)
+        {
+            int attackers = pair[0];
+            int defenders = pair[1];
+            BattleKernel::resolve(attackers, defenders, static_cast<std::uint64_t>(i), 345);
+            conquests += defenders == 0;
+            attackersLeft += attackers;
+        }
+
+        BattleOdds odds = CombatOdds::odds(pair[0], pair[1]);
+        std::cout << pair[0] << " attackers against " << pair[1] << " defenders: conquest "
+                  << odds.win << " (simulated " << static_cast<double>(conquests) / battles << "), attackers left "
+                  << odds.attackersLeft << " (simulated " << attackersLeft / battles << ")\n";
+    }
+
+    std::cout << "Attackers needed to conquer 10 defenders 80% of the time: " << CombatOdds::attackersNeeded(10, 0.8) << "\n";
+}
+
+/**
+ * @brief Checks the dependency levels the OrderScheduler assigns to the orders of an execution phase.
+ *
+ * Two players hold neighbouring territories of Grand Montreal. Each scenario gives them a few orders, runs the
+ * phase through the scheduler and compares the level of every order, in sequence order (deploys first, then one
+ * order per player at a time), with the expected levels: orders touching the same territory, reinforcement pool or
+ * negotiation table must fall in separate levels, orders touching disjoint state must share one, even when they come
+ * from the same player.
+ */
+void testOrderScheduler()
+{
+    Map *gameMap = new Map();
+    MapLoader::LoadMap("../SomeMapsFromOnline/Montreal/Grand Montreal.map", gameMap);
+    if (gameMap->territories.count("Lachine") == 0)
+    {
+        std::cerr << "Error: Could not load Grand Montreal\n";
+        delete gameMap;
+        return;
+    }
+
+    Player player1("Player1", {gameMap->territories["Lachine"], gameMap->territories["Cote St-Luc"]});
+    Player player2("Player2", {gameMap->territories["NDG CDN"], gameMap->territories["Mont Royal"],
+                               gameMap->territories["Westmount"]});
+    std::vector<Player *> players = {&player1, &player2};
+    player1.setStrategy(new AggressivePlayerStrategy(&player1));
+    player2.setStrategy(new AggressivePlayerStrategy(&player2));
+
+    Deck deck;
+    player1.deck = &deck;
+    player2.deck = &deck;
+
+    NegotiationMatrix negotiations;
+    OrderScheduler scheduler(2);
+    int failures = 0;
+
+    auto check = [&](const std::string &scenario, const std::vector<int> &expected) {
+        for (Territory *territory : gameMap->territoriesById)
+        {
+            territory->numberOfArmies = 10;
+        }
+        player1.setNumArmies(10);
+        player2.setNumArmies(10);
+        negotiations.beginTurn(players);
+
+        std::ostringstream silenced;
+        std::streambuf *console = std::cout.rdbuf(silenced.rdbuf());
+        scheduler.executePhase(players, gameMap);
+        std::cout.rdbuf(console);
+
+        const std::vector<int> &levels = scheduler.lastOrderLevels();
+        std::cout << scenario << ": levels";
+        for (int level : levels)
+        {
+            std::cout << " " << level;
+        }
+        const bool passed = levels == expected;
+        failures += !passed;
+        std::cout << (passed ? " (as expected)\n" : " (UNEXPECTED)\n");
+    };
+
+    player1.getOrdersList()->add(new DeployOrder(&player1, "Lachine", 5));
+    player2.getOrdersList()->add(new DeployOrder(&player2, "NDG CDN", 5));
+    check("Deploys of two players to their own territories", {0, 0});
+
+    player1.getOrdersList()->add(new DeployOrder(&player1, "Lachine", 5));
+    player1.getOrdersList()->add(new AdvanceOrder(&player1, nullptr, "Lachine", "Cote St-Luc", 3));
+    check("A deploy to a territory, then an advance out of it", {0, 1});
+
+    player1.getOrdersList()->add(new AdvanceOrder(&player1, nullptr, "Lachine", "Cote St-Luc", 3));
+    player2.getOrdersList()->add(new AdvanceOrder(&player2, nullptr, "Westmount", "NDG CDN", 3));
+    check("Advances of two players between their own territories", {0, 0});
+
+    player1.getOrdersList()->add(new AdvanceOrder(&player1, nullptr, "Lachine", "Dorval", 3));
+    player1.getOrdersList()->add(new AdvanceOrder(&player1, nullptr, "Cote St-Luc", "St-Laurent", 3));
+    check("Attacks of one player from two of its territories", {0, 0});
+
+    player1.getOrdersList()->add(new AdvanceOrder(&player1, nullptr, "Cote St-Luc", "Lachine", 3));
+    player2.getOrdersList()->add(new AdvanceOrder(&player2, nullptr, "NDG CDN", "Lachine", 3));
+    check("A move into a territory, then an attack on it", {0, 1});
+
+    player1.getOrdersList()->add(new DeployOrder(&player1, "Lachine", 2));
+    player1.getOrdersList()->add(new DeployOrder(&player1, "Cote St-Luc", 2));
+    check("Two deploys from the same reinforcement pool", {0, 1});
+
+    player1.getOrdersList()->add(new NegotiateOrder(&player1, "Player2"));
+    player2.getOrdersList()->add(new AdvanceOrder(&player2, nullptr, "Westmount", "NDG CDN", 3));
+    check("A negotiation, then an advance checking it", {0, 1});
+
+    std::cout << (failures == 0 ? "Every scenario got the expected levels.\n"
+                                : std::to_string(failures) + " scenario(s) got unexpected levels.\n");
+
+    delete gameMap;
+}
+
+/**
+ * @brief Checks that the OrderPool recycles the memory of deleted orders and counts live blocks across threads.
+ *
+ * Orders deleted on the thread that created them are handed out again to the next orders of the same size.
+ * Orders created on one thread and deleted on another must leave the count of live blocks where it started.
+ */
+void testOrderPool()
+{
+    const int count = 200;
+    const std::size_t liveBefore = OrderPool::liveBlocks();
+
+    std::vector<Order *> orders;
+    std::set<void *> addresses;
+    for (int i = 0; i < count; ++i)
+    {
+        orders.push_back(new DeployOrder(nullptr, "Territory", i));
+        addresses.insert(orders.back());
+    }
+    std::cout << "Live blocks after creating " << count << " orders: " << OrderPool::liveBlocks() - liveBefore << "\n";
+
+    for (Order *order : orders)
+    {
+        delete order;
+    }
+    std::cout << "Live blocks after deleting them: " << OrderPool::liveBlocks() - liveBefore << "\n";
+
+    int reused = 0;
+    orders.clear();
+    for (int i = 0; i < count; ++i)
+    {
+        orders.push_back(new DeployOrder(nullptr, "Territory", i));
+        reused += addresses.count(orders.back()) > 0;
+    }
+    std::cout << "Orders created again in recycled blocks: " << reused << " of " << count << "\n";
+
+    // Delete them on another thread, as the scheduler workers may do
+    std::thread releaser([&orders]() {
+        for (Order *order : orders)
+        {
+            delete order;
+        }
+    });
+    releaser.join();
+    std::cout << "Live blocks after deleting them on another thread: " << OrderPool::liveBlocks() - liveBefore << "\n";
+
+    const bool passed = reused == count && OrderPool::liveBlocks() == liveBefore;
+    std::cout << (passed ? "The pool recycled every block and counted them on both threads.\n"
+                         : "UNEXPECTED: blocks were not recycled or were miscounted.\n");
+}
+
+namespace
+{
+    /**
+     * @brief Plays a seeded game of eight players on a map, dealt its territories in turn, and records the game
+     * state at the end of every turn: the armies of every territory and, for every player, its reinforcement pool,
+     * its cards and its territories.
+     *
+     * @param mapFile The map of the game.
+     * @param threads The threads executing the orders, as given to -E.
+     * @param turns The turns to play.
+     * @param seed The seed of the battles and of the deck.
+     * @return The state of the game after every turn.
+     */
+    std::vector<std::string> playSeededGame(const std::string &mapFile, int threads, int turns, std::uint64_t seed)
+    {
+        std::vector<std::string> states;
+        BattleKernel::seedThread(seed);
+
+        Deck *deck = new Deck(seed);
+        {
+            GameEngine engine;
+            engine.setOrderExecutionThreads(threads);
+            Map *map = new Map();
+            MapLoader::LoadMap(mapFile, map);
+            map->PrecomputeDistances();
+            engine.setCurrentMap(map);
+            engine.setGameDeck(deck);
+
+            const int playerCount = 8;
+            for (int i = 0; i < playerCount; ++i)
+            {
+                Player *player = new Player((i % 2 == 0 ? "Aggressive" : "Benevolent") + std::to_string(i / 2), {});
+                player->map = map;
+                player->deck = deck;
+                if (i % 2 == 0)
+                {
+                    player->setStrategy(new AggressivePlayerStrategy(player));
+                }
+                else
+                {
+                    player->setStrategy(new BenevolentPlayerStrategy(player));
+                }
+                Player::players.push_back(player);
+            }
+            for (Territory *territory : map->territoriesById)
+            {
+                Player::players[territory->id % playerCount]->getOwnedTerritories().push_back(territory);
+            }
+            for (Player *player : Player::players)
+            {
+                player->setNumArmies(50);
+                deck->draw(*player->getPlayerHand());
+            }
+
+            std::ostringstream silenced;
+            std::streambuf *console = std::cout.rdbuf(silenced.rdbuf());
+            for (int turn = 0; turn < turns && Player::players.size() > 1; ++turn)
+            {
+                for (std::size_t i = 0; i < Player::players.size(); ++i)
+                {
+                    if (Player::players[i]->getOwnedTerritories().empty())
+                    {
+                        delete Player::players[i];
+                        Player::players.erase(Player::players.begin() + i--);
+                        continue;
+                    }
+                    engine.reinforcementPhase(Player::players[i]);
+                }
+                for (Player *player : Player::players)
+                {
+                    player->issueOrder(deck);
+                }
+                engine.executeOrdersPhase();
+
+                std::ostringstream state;
+                for (Territory *territory : map->territoriesById)
+                {
+                    state << territory->numberOfArmies << ",";
+                }
+                for (Player *player : Player::players)
+                {
+                    state << "|" << player->getPlayerName() << ":" << player->getNumArmies() << ":";
+                    for (int cards : player->getPlayerHand()->counts)
+                    {
+                        state << cards << ",";
+                    }
+                    state << ":";
+                    for (Territory *territory : player->getOwnedTerritories())
+                    {
+                        state << territory->id << ",";
+                    }
+                }
+                states.push_back(state.str());
+            }
+            std::cout.rdbuf(console);
+        }
+        delete deck;
+
+        BattleKernel::unseedThread();
+        return states;
+    }
+}
+
+/**
+ * @brief Plays one seeded game with its orders executed sequentially (-E 1) and again with the OrderScheduler
+ * (-E 4), and checks that every turn ends on the same game state.
+ *
+ * Battles roll from the seed of the game, the turn and the position of their order, and cards come from the same
+ * seeded deck, so both runs see the same rolls and draws whichever thread executes an order.
+ */
+void testOrderSchedulerGame()
+{
+    const std::string mapFile = "../SomeMapsFromOnline/Montreal/Grand Montreal.map";
+    const int turns = 30;
+    const std::uint64_t seed = 345;
+
+    const std::vector<std::string> sequential = playSeededGame(mapFile, 1, turns, seed);
+    const std::vector<std::string> scheduled = playSeededGame(mapFile, 4, turns, seed);
+    if (sequential.empty())
+    {
+        std::cerr << "Error: Could not load Grand Montreal\n";
+        return;
+    }
+
+    std::size_t turn = 0;
+    while (turn < sequential.size() && turn < scheduled.size() && sequential[turn] == scheduled[turn])
+    {
+        turn++;
+    }
+
+    std::cout << "Turns played with -E 1: " << sequential.size() << ", with -E 4: " << scheduled.size() << "\n";
+    if (turn == sequential.size() && turn == scheduled.size())
+    {
+        std::cout << "Every turn ended on the same game state.\n";
+    }
+    else
+    {
+        std::cout << "UNEXPECTED: the game states differ from turn " << turn + 1 << ".\n";
+    }
+}
+
+/**
+ * @brief Checks the verdicts of an OrderValidation batch against the full validation of every order.
+ *
+ * Two players hold neighbouring territories of Grand Montreal and issue deploy, advance and bomb orders, valid or
+ * not. The batch prevalidates them, then every order it judged is validated in full on its own and both verdicts
+ * are compared. The same batch is used three times: on the map as loaded, once the border between Lachine and
+ * Cote St-Luc is removed, and once the map is loaded again at the same address, which brings the border back.
+ * The batch must see both changes of the adjacency, which keep the address and the size of the map.
+ */
+void testOrderValidation()
+{
+    const std::string mapFile = "../SomeMapsFromOnline/Montreal/Grand Montreal.map";
+    Map *gameMap = new Map();
+    MapLoader::LoadMap(mapFile, gameMap);
+    if (gameMap->territories.count("Lachine") == 0)
+    {
+        std::cerr << "Error: Could not load Grand Montreal\n";
+        delete gameMap;
+        return;
+    }
+
+    Player player1("Player1", {});
+    Player player2("Player2", {});
+    std::vector<Player *> players = {&player1, &player2};
+    player1.setStrategy(new AggressivePlayerStrategy(&player1));
+    player2.setStrategy(new AggressivePlayerStrategy(&player2));
+
+    OrderValidation validation;
+    int failures = 0;
+
+    auto check = [&](const std::string &scenario, bool bordered) {
+        player1.setOwnedTerritories({gameMap->territories["Lachine"], gameMap->territories["Cote St-Luc"]});
+        player2.setOwnedTerritories({gameMap->territories["NDG CDN"], gameMap->territories["Mont Royal"],
+                                     gameMap->territories["Westmount"]});
+        for (Territory *territory : gameMap->territoriesById)
+        {
+            territory->numberOfArmies = 10;
+        }
+        player1.setNumArmies(10);
+        player2.setNumArmies(10);
+
+        player1.getOrdersList()->add(new DeployOrder(&player1, "Lachine", 5));
+        player1.getOrdersList()->add(new DeployOrder(&player1, "Westmount", 5));
+        player2.getOrdersList()->add(new DeployOrder(&player2, "NDG CDN", 5));
+        player1.getOrdersList()->add(new AdvanceOrder(&player1, nullptr, "Lachine", "Cote St-Luc", 3));
+        player1.getOrdersList()->add(new AdvanceOrder(&player1, nullptr, "Cote St-Luc", "Lachine", 30));
+        player1.getOrdersList()->add(new AdvanceOrder(&player1, nullptr, "Lachine", "Verdun", 3));
+        player1.getOrdersList()->add(new AdvanceOrder(&player1, nullptr, "Westmount", "NDG CDN", 3));
+        player2.getOrdersList()->add(new AdvanceOrder(&player2, nullptr, "NDG CDN", "Lachine", 3));
+        player1.getOrdersList()->add(new BombOrder(&player1, "Mont Royal"));
+        player1.getOrdersList()->add(new BombOrder(&player1, "Verdun"));
+        player2.getOrdersList()->add(new BombOrder(&player2, "Lachine"));
+
+        validation.prevalidate(players, gameMap);
+
+        int orders = 0;
+        int judged = 0;
+        int disagreements = 0;
+        std::ostringstream silenced;
+        std::streambuf *console = std::cout.rdbuf(silenced.rdbuf());
+        for (Player *player : players)
+        {
+            for (Order *order = player->getOrdersList()->popFront(); order != nullptr;
+                 order = player->getOrdersList()->popFront())
+            {
+                orders++;
+                const int verdict = validation.verdict(order);
+                if (verdict != OrderValidation::UNKNOWN)
+                {
+                    judged++;
+                    order->validation = nullptr;
+                    order->validate();
+                    disagreements += order->validOrder != (verdict == OrderValidation::VALID);
+                }
+                delete order;
+            }
+        }
+        std::cout.rdbuf(console);
+
+        // The advance between Lachine and Cote St-Luc is valid only while they border each other
+        const bool advanceAcross = gameMap->territories["Lachine"]->IsAdjacentTo(gameMap->territories["Cote St-Luc"]);
+        const bool passed = disagreements == 0 && advanceAcross == bordered;
+        failures += !passed;
+        std::cout << scenario << ": " << judged << " of " << orders << " orders prevalidated, " << disagreements
+                  << " disagreeing with their full validation" << (passed ? " (as expected)\n" : " (UNEXPECTED)\n");
+    };
+
+    check("Grand Montreal as loaded", true);
+
+    Territory *lachine = gameMap->territories["Lachine"];
+    Territory *coteStLuc = gameMap->territories["Cote St-Luc"];
+    lachine->adjacentTerritories.erase(std::find(lachine->adjacentTerritories.begin(),
+                                                 lachine->adjacentTerritories.end(), coteStLuc));
+    coteStLuc->adjacentTerritories.erase(std::find(coteStLuc->adjacentTerritories.begin(),
+                                                   coteStLuc->adjacentTerritories.end(), lachine));
+    gameMap->BuildAdjacencyArrays();
+    check("Without the border between Lachine and Cote St-Luc", false);
+
+    *gameMap = Map();
+    MapLoader::LoadMap(mapFile, gameMap);
+    check("Loaded again at the same address", true);
+
+    std::cout << (failures == 0 ? "Every prevalidated verdict matched the full validation.\n"
+                                : std::to_string(failures) + " scenario(s) got unexpected verdicts.\n");
+
+    player1.setOwnedTerritories({});
+    player2.setOwnedTerritories({});
+    delete gameMap;
+}
@@ -7,5 +7,12 @@
 
 void testOrdersLists();
 void testOrderExecution();
+void testOrderJournal();
+void testBattleKernel();
+void testCombatOdds();
+void testOrderScheduler();
+void testOrderSchedulerGame();
+void testOrderValidation();
+void testOrderPool();
 
 #endif //COMP345_WARZONE_ORDERSDRIVER_H
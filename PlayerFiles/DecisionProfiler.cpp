@@ -0,0 +1,434 @@
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <istream>
+#include <ostream>
+#include "PlayerFiles/DecisionProfiler.h"
+#include "PlayerFiles/PlayerStrategies.h"
+
+namespace
+{
+    const char *decisionNames[] = {"issueOrder", "toAttack", "toDefend"};
+
+    static_assert(sizeof(decisionNames) / sizeof(decisionNames[0]) == DECISION_COUNT,
+                  "every decision needs a name");
+
+    /**
+     * Profiles of every strategy, in order of first use. They are never deleted, strategies keep pointers to them.
+     */
+    struct ProfileRegistry
+    {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<DecisionProfile>> profiles;
+    };
+
+    ProfileRegistry &profileRegistry()
+    {
+        static ProfileRegistry registry;
+        return registry;
+    }
+
+    std::atomic<bool> profilingEnabled(true);
+}
+
+/**
+ * @param decision A kind of decision.
+ * @return The name of the decision, as reported.
+ */
+const char *decisionName(Decision decision)
+{
+    return decisionNames[static_cast<int>(decision)];
+}
+
+/**
+ * @param name The name of a decision, as reported.
+ * @param decision Receives the decision.
+ * @return true if the name is the name of a decision.
+ */
+bool parseDecision(const std::string &name, Decision &decision)
+{
+    for (int i = 0; i < DECISION_COUNT; ++i)
+    {
+        if (name == decisionNames[i])
+        {
+            decision = static_cast<Decision>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+// ---------------------- LatencyHistogram Class Implementation ----------------------
+
+const int LatencyHistogram::SUB_BUCKET_BITS;
+const int LatencyHistogram::MAX_VALUE_BITS;
+const int LatencyHistogram::BUCKET_COUNT;
+
+LatencyHistogram::LatencyHistogram()
+{
+    reset();
+}
+
+/**
+ * @param nanoseconds A latency.
+ * @return The index of the bucket of the latency: the latency itself below 2^SUB_BUCKET_BITS, otherwise its
+ * magnitude followed by its SUB_BUCKET_BITS - 1 bits after the leading one.
+ */
+int LatencyHistogram::bucketOf(std::uint64_t nanoseconds)
+{
+    const std::uint64_t largestValue = (std::uint64_t(1) << MAX_VALUE_BITS) - 1;
+    nanoseconds = std::min(nanoseconds, largestValue);
+    if (nanoseconds < (std::uint64_t(1) << SUB_BUCKET_BITS))
+    {
+        return static_cast<int>(nanoseconds);
+    }
+
+    int leadingBit = 0;
+    while ((nanoseconds >> (leadingBit + 1)) != 0)
+    {
+        ++leadingBit;
+    }
+    const int shift = leadingBit - (SUB_BUCKET_BITS - 1);
+    return (shift << (SUB_BUCKET_BITS - 1)) + static_cast<int>(nanoseconds >> shift);
+}
+
+/**
+ * @param bucket The index of a bucket.
+ * @return The highest latency of the bucket.
+ */
+std::uint64_t LatencyHistogram::highestValueOf(int bucket)
+{
+    if (bucket < (1 << SUB_BUCKET_BITS))
+    {
+        return static_cast<std::uint64_t>(bucket);
+    }
+
+    const int shift = (bucket >> (SUB_BUCKET_BITS - 1)) - 1;
+    const std::uint64_t mantissa = static_cast<std::uint64_t>(bucket - (shift << (SUB_BUCKET_BITS - 1)));
+    return ((mantissa + 1) << shift) - 1;
+}
+
+/**
+ * @brief Records a latency.
+ *
+ * @param nanoseconds The latency, in nanoseconds.
+ */
+void LatencyHistogram::record(std::uint64_t nanoseconds)
+{
+    counts[bucketOf(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+    std::uint64_t previous = largest.load(std::memory_order_relaxed);
+    while (nanoseconds > previous && !largest.compare_exchange_weak(previous, nanoseconds, std::memory_order_relaxed))
+    {
+    }
+}
+
+/**
+ * @brief Forgets every latency recorded.
+ */
+void LatencyHistogram::reset()
+{
+    for (std::atomic<std::uint64_t> &count : counts)
+    {
+        count.store(0, std::memory_order_relaxed);
+    }
+    total.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    largest.store(0, std::memory_order_relaxed);
+}
+
+std::uint64_t LatencyHistogram::count() const
+{
+    return total.load(std::memory_order_relaxed);
+}
+
+std::uint64_t LatencyHistogram::max() const
+{
+    return largest.load(std::memory_order_relaxed);
+}
+
+double LatencyHistogram::mean() const
+{
+    const std::uint64_t calls = count();
+    return calls == 0 ? 0 : static_cast<double>(sum.load(std::memory_order_relaxed)) / calls;
+}
+
+/**
+ * @param percentile A percentile, between 0 and 100.
+ * @return The highest latency of the bucket holding the percentile, at most the largest latency recorded,
+ * 0 if nothing was recorded.
+ */
+std::uint64_t LatencyHistogram::valueAtPercentile(double percentile) const
+{
+    std::uint64_t recorded = 0;
+    for (const std::atomic<std::uint64_t> &count : counts)
+    {
+        recorded += count.load(std::memory_order_relaxed);
+    }
+    if (recorded == 0)
+    {
+        return 0;
+    }
+
+    percentile = std::max(0.0, std::min(100.0, percentile));
+    const std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(percentile / 100 * recorded)));
+
+    std::uint64_t seen = 0;
+    for (int bucket = 0; bucket < BUCKET_COUNT; ++bucket)
+    {
+        seen += counts[bucket].load(std::memory_order_relaxed);
+        if (seen >= rank)
+        {
+            return std::min(highestValueOf(bucket), max());
+        }
+    }
+    return max();
+}
+
+/**
+ * @brief Writes the histogram on one line: its count, sum and largest latency, then every bucket that is not empty
+ * as index:count.
+ *
+ * @param out The stream to write to.
+ */
+void LatencyHistogram::write(std::ostream &out) const
+{
+    out << count() << ' ' << sum.load(std::memory_order_relaxed) << ' ' << max();
+    for (int bucket = 0; bucket < BUCKET_COUNT; ++bucket)
+    {
+        const std::uint64_t bucketCount = counts[bucket].load(std::memory_order_relaxed);
+        if (bucketCount > 0)
+        {
+            out << ' ' << bucket << ':' << bucketCount;
+        }
+    }
+}
+
+/**
+ * @brief Adds a histogram written by write to this one.
+ *
+ * @param in The stream to read the histogram from.
+ * @return false if the histogram is malformed, in which case nothing is added.
+ */
+bool LatencyHistogram::read(std::istream &in)
+{
+    std::uint64_t readCount = 0, readSum = 0, readMax = 0;
+    if (!(in >> readCount >> readSum >> readMax))
+    {
+        return false;
+    }
+
+    std::vector<std::pair<int, std::uint64_t>> buckets;
+    std::uint64_t bucketTotal = 0;
+    int bucket = 0;
+    char separator = 0;
+    std::uint64_t bucketCount = 0;
+    while (in >> bucket >> separator >> bucketCount)
+    {
+        if (separator != ':' || bucket < 0 || bucket >= BUCKET_COUNT)
+        {
+            return false;
+        }
+        buckets.emplace_back(bucket, bucketCount);
+        bucketTotal += bucketCount;
+    }
+    if (bucketTotal != readCount)
+    {
+        return false;
+    }
+
+    for (const auto &entry : buckets)
+    {
+        counts[entry.first].fetch_add(entry.second, std::memory_order_relaxed);
+    }
+    total.fetch_add(readCount, std::memory_order_relaxed);
+    sum.fetch_add(readSum, std::memory_order_relaxed);
+    std::uint64_t previous = largest.load(std::memory_order_relaxed);
+    while (readMax > previous && !largest.compare_exchange_weak(previous, readMax, std::memory_order_relaxed))
+    {
+    }
+    return true;
+}
+
+// ---------------------- DecisionProfile Class Implementation ----------------------
+
+/**
+ * @param decision A kind of decision.
+ * @return The percentiles of the decision, and its calls per issued turn.
+ */
+LatencySummary DecisionProfile::summary(Decision decision) const
+{
+    const LatencyHistogram &latencies = histogram(decision);
+    const std::uint64_t turns = histogram(Decision::ISSUE_ORDER).count();
+
+    LatencySummary summary;
+    summary.calls = latencies.count();
+    summary.callsPerTurn = turns == 0 ? 0 : static_cast<double>(summary.calls) / turns;
+    summary.meanNs = latencies.mean();
+    summary.p50Ns = latencies.valueAtPercentile(50);
+    summary.p90Ns = latencies.valueAtPercentile(90);
+    summary.p99Ns = latencies.valueAtPercentile(99);
+    summary.maxNs = latencies.max();
+    return summary;
+}
+
+// ---------------------- DecisionProfiler Class Implementation ----------------------
+
+/**
+ * @param strategyName The name of a strategy, as given to the tournament command.
+ * @return The profile of the strategy, created on first use.
+ */
+DecisionProfile *DecisionProfiler::profile(const std::string &strategyName)
+{
+    ProfileRegistry &registry = profileRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    for (const std::unique_ptr<DecisionProfile> &profile : registry.profiles)
+    {
+        if (profile->getStrategyName() == strategyName)
+        {
+            return profile.get();
+        }
+    }
+
+    registry.profiles.emplace_back(new DecisionProfile(strategyName));
+    return registry.profiles.back().get();
+}
+
+/**
+ * @return The names of the strategies profiled so far, in order of first use.
+ */
+std::vector<std::string> DecisionProfiler::strategies()
+{
+    ProfileRegistry &registry = profileRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    std::vector<std::string> names;
+    for (const std::unique_ptr<DecisionProfile> &profile : registry.profiles)
+    {
+        names.push_back(profile->getStrategyName());
+    }
+    return names;
+}
+
+/**
+ * @param strategyName The name of a strategy.
+ * @param decision A kind of decision.
+ * @return The percentiles of the decision for the strategy, all zero if it was never profiled.
+ */
+LatencySummary DecisionProfiler::summary(const std::string &strategyName, Decision decision)
+{
+    ProfileRegistry &registry = profileRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    for (const std::unique_ptr<DecisionProfile> &profile : registry.profiles)
+    {
+        if (profile->getStrategyName() == strategyName)
+        {
+            return profile->summary(decision);
+        }
+    }
+    return LatencySummary();
+}
+
+/**
+ * @brief Zeroes every profile.
+ */
+void DecisionProfiler::reset()
+{
+    ProfileRegistry &registry = profileRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    for (const std::unique_ptr<DecisionProfile> &profile : registry.profiles)
+    {
+        for (int decision = 0; decision < DECISION_COUNT; ++decision)
+        {
+            profile->histogram(static_cast<Decision>(decision)).reset();
+        }
+    }
+}
+
+void DecisionProfiler::setEnabled(bool enabled)
+{
+    profilingEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool DecisionProfiler::isEnabled()
+{
+    return profilingEnabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Writes a table of the percentiles of every decision of every strategy that made any, in microseconds.
+ *
+ * @param out The stream to write to.
+ */
+void DecisionProfiler::report(std::ostream &out)
+{
+    ProfileRegistry &registry = profileRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    const std::ios::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+
+    out << "Decision latency (us):\n";
+    out << std::left << std::setw(20) << "Strategy" << std::setw(12) << "Decision" << std::right << std::setw(10)
+        << "Calls" << std::setw(12) << "Calls/turn" << std::setw(10) << "Mean" << std::setw(10) << "p50"
+        << std::setw(10) << "p90" << std::setw(10) << "p99" << std::setw(10) << "Max" << "\n";
+    out << std::fixed;
+
+    for (const std::unique_ptr<DecisionProfile> &profile : registry.profiles)
+    {
+        for (int decision = 0; decision < DECISION_COUNT; ++decision)
+        {
+            const LatencySummary summary = profile->summary(static_cast<Decision>(decision));
+            if (summary.calls == 0)
+            {
+                continue;
+            }
+
+            out << std::left << std::setw(20) << profile->getStrategyName() << std::setw(12)
+                << decisionName(static_cast<Decision>(decision)) << std::right << std::setw(10) << summary.calls
+                << std::setprecision(2) << std::setw(12) << summary.callsPerTurn << std::setprecision(1)
+                << std::setw(10) << summary.meanNs / 1000 << std::setw(10) << summary.p50Ns / 1000.0
+                << std::setw(10) << summary.p90Ns / 1000.0 << std::setw(10) << summary.p99Ns / 1000.0
+                << std::setw(10) << summary.maxNs / 1000.0 << "\n";
+        }
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+// ---------------------- DecisionTimer Class Implementation ----------------------
+
+/**
+ * @brief Starts timing a decision, unless profiling is disabled or there is no strategy.
+ *
+ * @param strategy The strategy making the decision, may be nullptr.
+ * @param decision The kind of decision.
+ */
+DecisionTimer::DecisionTimer(PlayerStrategy *strategy, Decision decision) : histogram(nullptr)
+{
+    if (strategy != nullptr && DecisionProfiler::isEnabled())
+    {
+        histogram = &strategy->decisionProfile()->histogram(decision);
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+/**
+ * @brief Records the time elapsed since the decision started.
+ */
+DecisionTimer::~DecisionTimer()
+{
+    if (histogram != nullptr)
+    {
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        histogram->record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+}
@@ -0,0 +1,215 @@
+#ifndef DECISION_PROFILER_H
+#define DECISION_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+class PlayerStrategy;
+
+/**
+ * @brief The decisions of a strategy whose latency is profiled.
+ */
+enum class Decision
+{
+    ISSUE_ORDER, ///< Issuing the orders of a turn.
+    TO_ATTACK,   ///< Choosing the territories to attack.
+    TO_DEFEND    ///< Choosing the territories to defend.
+};
+
+/**
+ * @brief The number of kinds of decisions.
+ */
+const int DECISION_COUNT = 3;
+
+/**
+ * @param decision A kind of decision.
+ * @return The name of the decision, as reported.
+ */
+const char *decisionName(Decision decision);
+
+/**
+ * @param name The name of a decision, as reported.
+ * @param decision Receives the decision.
+ * @return true if the name is the name of a decision.
+ */
+bool parseDecision(const std::string &name, Decision &decision);
+
+/**
+ * @brief The latency percentiles of a decision, in nanoseconds.
+ */
+struct LatencySummary
+{
+    std::uint64_t calls = 0;   ///< The number of calls recorded.
+    double callsPerTurn = 0;   ///< The calls per turn issued with the same strategy.
+    double meanNs = 0;         ///< The mean latency.
+    std::uint64_t p50Ns = 0;   ///< The median latency.
+    std::uint64_t p90Ns = 0;   ///< The 90th percentile.
+    std::uint64_t p99Ns = 0;   ///< The 99th percentile.
+    std::uint64_t maxNs = 0;   ///< The largest latency recorded.
+};
+
+/**
+ * @brief A histogram of latencies with a bounded relative error, in the spirit of HdrHistogram.
+ *
+ * Values below 32 ns get a bucket each, then every power of two is split into 16 linear buckets, so a
+ * percentile is reported within 1/16 of its true value, up to about 36 minutes, with 608 counters. Recording is
+ * a few relaxed atomic increments, so threads may record into the same histogram without locking.
+ */
+class LatencyHistogram
+{
+public:
+    static const int SUB_BUCKET_BITS = 5;  ///< Values below 2^SUB_BUCKET_BITS get a bucket each.
+    static const int MAX_VALUE_BITS = 41;  ///< Larger values are recorded as the largest one.
+    static const int BUCKET_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 2) << (SUB_BUCKET_BITS - 1);
+
+    LatencyHistogram();
+
+    /**
+     * @brief Records a latency.
+     *
+     * @param nanoseconds The latency, in nanoseconds.
+     */
+    void record(std::uint64_t nanoseconds);
+
+    /**
+     * @brief Forgets every latency recorded.
+     */
+    void reset();
+
+    std::uint64_t count() const;
+    std::uint64_t max() const;
+    double mean() const;
+
+    /**
+     * @param percentile A percentile, between 0 and 100.
+     * @return The highest latency of the bucket holding the percentile, at most the largest latency recorded,
+     * 0 if nothing was recorded.
+     */
+    std::uint64_t valueAtPercentile(double percentile) const;
+
+    /**
+     * @param nanoseconds A latency.
+     * @return The index of the bucket of the latency.
+     */
+    static int bucketOf(std::uint64_t nanoseconds);
+
+    /**
+     * @param bucket The index of a bucket.
+     * @return The highest latency of the bucket.
+     */
+    static std::uint64_t highestValueOf(int bucket);
+
+    /**
+     * @brief Writes the histogram on one line: its count, sum and largest latency, then every bucket that is not
+     * empty as index:count.
+     *
+     * @param out The stream to write to.
+     */
+    void write(std::ostream &out) const;
+
+    /**
+     * @brief Adds a histogram written by write to this one, so histograms recorded by several processes can be merged.
+     *
+     * @param in The stream to read the histogram from.
+     * @return false if the histogram is malformed, in which case nothing is added.
+     */
+    bool read(std::istream &in);
+
+private:
+    std::atomic<std::uint64_t> counts[BUCKET_COUNT];
+    std::atomic<std::uint64_t> total;
+    std::atomic<std::uint64_t> sum;
+    std::atomic<std::uint64_t> largest;
+};
+
+/**
+ * @brief The latency histograms of one strategy, one per kind of decision.
+ */
+class DecisionProfile
+{
+public:
+    explicit DecisionProfile(const std::string &strategyName) : strategyName(strategyName) {}
+
+    const std::string &getStrategyName() const { return strategyName; }
+
+    LatencyHistogram &histogram(Decision decision) { return histograms[static_cast<int>(decision)]; }
+    const LatencyHistogram &histogram(Decision decision) const { return histograms[static_cast<int>(decision)]; }
+
+    /**
+     * @param decision A kind of decision.
+     * @return The percentiles of the decision, and its calls per issued turn.
+     */
+    LatencySummary summary(Decision decision) const;
+
+private:
+    std::string strategyName;
+    LatencyHistogram histograms[DECISION_COUNT];
+};
+
+/**
+ * @brief Records how long every strategy takes to decide.
+ *
+ * Player::issueOrder, Player::toAttack and Player::toDefend time the call to their strategy with a DecisionTimer,
+ * which records into the profile of the strategy's name. A strategy looks its profile up once and keeps it, so a
+ * recording costs two clock reads and a few relaxed atomic increments: cheap enough to stay on in tournaments.
+ * Profiles live until the end of the program, reset only zeroes them.
+ */
+class DecisionProfiler
+{
+public:
+    /**
+     * @param strategyName The name of a strategy, as given to the tournament command.
+     * @return The profile of the strategy, created on first use.
+     */
+    static DecisionProfile *profile(const std::string &strategyName);
+
+    /**
+     * @return The names of the strategies profiled so far, in order of first use.
+     */
+    static std::vector<std::string> strategies();
+
+    /**
+     * @param strategyName The name of a strategy.
+     * @param decision A kind of decision.
+     * @return The percentiles of the decision for the strategy, all zero if it was never profiled.
+     */
+    static LatencySummary summary(const std::string &strategyName, Decision decision);
+
+    /**
+     * @brief Zeroes every profile.
+     */
+    static void reset();
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    /**
+     * @brief Writes a table of the percentiles of every decision of every strategy that made any.
+     *
+     * @param out The stream to write to.
+     */
+    static void report(std::ostream &out);
+};
+
+/**
+ * @brief Times a decision of a strategy for as long as it lives, when profiling is enabled.
+ */
+class DecisionTimer
+{
+public:
+    DecisionTimer(PlayerStrategy *strategy, Decision decision);
+    ~DecisionTimer();
+
+    DecisionTimer(const DecisionTimer &) = delete;
+    DecisionTimer &operator=(const DecisionTimer &) = delete;
+
+private:
+    LatencyHistogram *histogram;
+    std::chrono::steady_clock::time_point start;
+};
+
+#endif
@@ -0,0 +1,518 @@
+#include <algorithm>
+#include "PlayerFiles/ForkableGame.h"
+#include "PlayerFiles/Player.h"
+#include "OrdersFiles/BattleKernel.h"
+#include "OrdersFiles/CombatOdds.h"
+
+namespace
+{
+    /**
+     * @return The stream of the battles of a simulated advance order.
+     */
+    std::uint64_t battleStream(const SimulatedOrder &order)
+    {
+        return (static_cast<std::uint64_t>(order.source) << 32) | static_cast<std::uint32_t>(order.target);
+    }
+}
+
+/**
+ * @brief Captures the armies and owners of the territories and the reinforcements of the players.
+ *
+ * @param map The map of the game, its territory ids must be assigned.
+ * @param players The players of the game, in turn order.
+ */
+ForkableGame::ForkableGame(const Map &map, const std::vector<Player *> &players) : territories(map)
+{
+    std::shared_ptr<Topology> shared = std::make_shared<Topology>();
+    shared->map = &map;
+    shared->adjacencyOffsets = map.adjacencyOffsets;
+    shared->adjacencyTargets = map.adjacencyTargets;
+    shared->players = players;
+
+    for (const auto &continentPair : map.continents)
+    {
+        std::vector<int> members;
+        for (const auto &territoryPair : continentPair.second->childTerritories)
+        {
+            members.push_back(territoryPair.second->id);
+        }
+        shared->continents.push_back(members);
+        shared->continentBonuses.push_back(continentPair.second->bonusPoints);
+    }
+    topology = shared;
+
+    for (std::size_t i = 0; i < players.size(); ++i)
+    {
+        Player *player = players[i];
+        StrategyKind kind = player->getStrategy() == nullptr ? StrategyKind::CUSTOM : player->getStrategy()->kind();
+        if (kind != StrategyKind::BENEVOLENT && kind != StrategyKind::NEUTRAL && kind != StrategyKind::CHEATER)
+        {
+            kind = StrategyKind::AGGRESSIVE;
+        }
+
+        kinds.push_back(kind);
+        pools.push_back(player->getNumArmies());
+        baseReinforcements.push_back(player->reinforcement_units);
+        owned.push_back(0);
+
+        for (Territory *territory : player->getOwnedTerritories())
+        {
+            setOwner(territory->id, static_cast<int>(i));
+        }
+    }
+}
+
+/**
+ * @return A fork of the game, sharing the territory pages and the topology.
+ */
+ForkableGame ForkableGame::fork() const
+{
+    ForkableGame forked;
+    forked.topology = topology;
+    forked.territories = territories.Fork();
+    forked.kinds = kinds;
+    forked.pools = pools;
+    forked.baseReinforcements = baseReinforcements;
+    forked.owned = owned;
+    return forked;
+}
+
+int ForkableGame::playerCount() const
+{
+    return static_cast<int>(kinds.size());
+}
+
+int ForkableGame::territoryCount() const
+{
+    return territories.Size();
+}
+
+/**
+ * @param player A player of the game.
+ * @return The index of the player, -1 if the player is not part of the game.
+ */
+int ForkableGame::playerIndex(const Player *player) const
+{
+    for (std::size_t i = 0; i < topology->players.size(); ++i)
+    {
+        if (topology->players[i] == player)
+        {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+/**
+ * @param index The index of a player.
+ * @return The player captured at that index.
+ */
+Player *ForkableGame::playerAt(int index) const
+{
+    return topology->players[index];
+}
+
+int ForkableGame::owner(int territory) const
+{
+    return territories.GetOwner(territory);
+}
+
+int ForkableGame::armies(int territory) const
+{
+    return territories.GetArmies(territory);
+}
+
+const int *ForkableGame::neighboursBegin(int territory) const
+{
+    return topology->adjacencyTargets.data() + topology->adjacencyOffsets[territory];
+}
+
+const int *ForkableGame::neighboursEnd(int territory) const
+{
+    return topology->adjacencyTargets.data() + topology->adjacencyOffsets[territory + 1];
+}
+
+int ForkableGame::territoriesOwned(int player) const
+{
+    return owned[player];
+}
+
+int ForkableGame::alivePlayers() const
+{
+    return static_cast<int>(std::count_if(owned.begin(), owned.end(), [](int count)
+                                          { return count > 0; }));
+}
+
+/**
+ * @return The armies the player deploys this turn.
+ */
+int ForkableGame::pool(int player) const
+{
+    return pools[player];
+}
+
+/**
+ * @brief Gives every player its reinforcements for a new turn, as GameEngine::reinforcementPhase does.
+ */
+void ForkableGame::assignReinforcements()
+{
+    for (int player = 0; player < playerCount(); ++player)
+    {
+        baseReinforcements[player] = std::max(3, owned[player] / 3);
+        pools[player] = baseReinforcements[player];
+    }
+
+    for (std::size_t continent = 0; continent < topology->continents.size(); ++continent)
+    {
+        const std::vector<int> &members = topology->continents[continent];
+        if (members.empty())
+        {
+            continue;
+        }
+
+        const int holder = owner(members.front());
+        bool held = holder >= 0;
+        for (std::size_t i = 1; held && i < members.size(); ++i)
+        {
+            held = owner(members[i]) == holder;
+        }
+
+        if (held)
+        {
+            pools[holder] += topology->continentBonuses[continent];
+        }
+    }
+}
+
+/**
+ * @param player The index of a player.
+ * @return The turn the rollout policy of the player plans on the current state. Cheaters conquer while they issue
+ * orders, which playTurn does, so they plan no order.
+ */
+SimulatedTurn ForkableGame::planPolicyTurn(int player) const
+{
+    SimulatedTurn turn;
+    if (owned[player] == 0)
+    {
+        return turn;
+    }
+
+    if (kinds[player] == StrategyKind::AGGRESSIVE)
+    {
+        planAggressive(player, turn);
+    }
+    else if (kinds[player] == StrategyKind::BENEVOLENT)
+    {
+        planBenevolent(player, turn);
+    }
+    return turn;
+}
+
+/**
+ * @brief Plans as AggressivePlayerStrategy: deploy to the strongest territory, attack the enemy neighbour with the
+ * best odds from its strongest neighbour, and move the strongest interior stack one hop towards the enemy.
+ */
+void ForkableGame::planAggressive(int player, SimulatedTurn &turn) const
+{
+    int strongest = -1;
+    int bestSource = -1;
+    int bestTarget = -1;
+    double bestOdds = -1;
+    int interior = -1;
+
+    for (int territory = 0; territory < territoryCount(); ++territory)
+    {
+        if (owner(territory) != player)
+        {
+            continue;
+        }
+
+        const int territoryArmies = armies(territory);
+        if (strongest < 0 || territoryArmies >= armies(strongest))
+        {
+            strongest = territory;
+        }
+
+        bool isInterior = true;
+        for (const int *neighbour = neighboursBegin(territory); neighbour != neighboursEnd(territory); ++neighbour)
+        {
+            if (owner(*neighbour) == player)
+            {
+                continue;
+            }
+            isInterior = false;
+
+            if (territoryArmies > 0)
+            {
+                const double odds = CombatOdds::winProbability(territoryArmies - 1, armies(*neighbour));
+                if (odds > bestOdds)
+                {
+                    bestOdds = odds;
+                    bestSource = territory;
+                    bestTarget = *neighbour;
+                }
+            }
+        }
+
+        if (isInterior && territoryArmies > 1 && (interior < 0 || territoryArmies > armies(interior)))
+        {
+            interior = territory;
+        }
+    }
+
+    turn.push_back({-1, strongest, baseReinforcements[player]});
+
+    if (bestSource >= 0)
+    {
+        turn.push_back({bestSource, bestTarget, armies(bestSource) - 1});
+    }
+
+    const Map *map = topology->map;
+    if (interior >= 0 && map->HasDistances())
+    {
+        // Head towards the closest territory of someone else
+        const Territory *from = map->territoriesById[interior];
+        int closest = -1;
+        int closestDistance = -1;
+        for (int territory = 0; territory < territoryCount(); ++territory)
+        {
+            if (owner(territory) == player)
+            {
+                continue;
+            }
+
+            const int distance = map->HopDistance(from, map->territoriesById[territory]);
+            if (distance > 0 && (closest < 0 || distance < closestDistance))
+            {
+                closest = territory;
+                closestDistance = distance;
+            }
+        }
+
+        const Territory *next = closest < 0 ? nullptr : map->NextHop(from, map->territoriesById[closest]);
+        if (next != nullptr && owner(next->id) == player)
+        {
+            turn.push_back({interior, next->id, armies(interior) - 1});
+        }
+    }
+}
+
+/**
+ * @brief Plans as BenevolentPlayerStrategy: deploy to the weakest territory and reinforce it from its strongest
+ * neighbour.
+ */
+void ForkableGame::planBenevolent(int player, SimulatedTurn &turn) const
+{
+    int weakest = -1;
+    for (int territory = 0; territory < territoryCount(); ++territory)
+    {
+        if (owner(territory) == player && (weakest < 0 || armies(territory) < armies(weakest)))
+        {
+            weakest = territory;
+        }
+    }
+
+    if (pools[player] > 0)
+    {
+        turn.push_back({-1, weakest, pools[player]});
+    }
+
+    int source = -1;
+    for (const int *neighbour = neighboursBegin(weakest); neighbour != neighboursEnd(weakest); ++neighbour)
+    {
+        if (owner(*neighbour) == player && armies(*neighbour) > (source < 0 ? 0 : armies(source)))
+        {
+            source = *neighbour;
+        }
+    }
+
+    if (source >= 0 && armies(source) > 1)
+    {
+        turn.push_back({source, weakest, armies(source) - 1});
+    }
+}
+
+/**
+ * @brief Plays a turn. Cheaters conquer first, in turn order, then every player plans on the resulting state, then
+ * the orders run: deploys player by player, then one order per player at a time.
+ *
+ * @param player The index of the player whose turn is given, -1 if every player follows its policy.
+ * @param turn The turn of that player.
+ * @param seed The seed of the battles of the turn.
+ */
+void ForkableGame::playTurn(int player, const SimulatedTurn &turn, std::uint64_t seed)
+{
+    for (int cheater = 0; cheater < playerCount(); ++cheater)
+    {
+        if (cheater != player && kinds[cheater] == StrategyKind::CHEATER && owned[cheater] > 0)
+        {
+            conquerNeighbours(cheater);
+        }
+    }
+
+    std::vector<SimulatedTurn> turns(playerCount());
+    for (int i = 0; i < playerCount(); ++i)
+    {
+        turns[i] = i == player ? turn : planPolicyTurn(i);
+    }
+
+    // Every deploy order first, player by player
+    std::vector<std::size_t> next(playerCount(), 0);
+    for (int i = 0; i < playerCount(); ++i)
+    {
+        for (const SimulatedOrder &order : turns[i])
+        {
+            if (order.source < 0 && owner(order.target) == i && order.armies <= pools[i])
+            {
+                territories.SetArmies(order.target, armies(order.target) + order.armies);
+                pools[i] -= order.armies;
+            }
+        }
+    }
+
+    // Then one order per player at a time
+    bool ordersLeft = true;
+    while (ordersLeft)
+    {
+        ordersLeft = false;
+        for (int i = 0; i < playerCount(); ++i)
+        {
+            while (next[i] < turns[i].size() && turns[i][next[i]].source < 0)
+            {
+                next[i]++;
+            }
+
+            if (next[i] < turns[i].size())
+            {
+                advance(i, turns[i][next[i]++], seed);
+                ordersLeft = true;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Executes an advance order as AdvanceOrder::execute does, negotiations aside.
+ */
+void ForkableGame::advance(int player, const SimulatedOrder &order, std::uint64_t seed)
+{
+    if (owner(order.source) != player || order.armies < 0 || armies(order.source) < order.armies)
+    {
+        return;
+    }
+
+    territories.SetArmies(order.source, armies(order.source) - order.armies);
+
+    const int enemy = owner(order.target);
+    if (enemy == player)
+    {
+        territories.SetArmies(order.target, armies(order.target) + order.armies);
+        return;
+    }
+
+    int attackers = order.armies;
+    int defenders = armies(order.target);
+    BattleKernel::resolve(attackers, defenders, battleStream(order), seed);
+
+    if (enemy >= 0 && kinds[enemy] == StrategyKind::NEUTRAL)
+    {
+        kinds[enemy] = StrategyKind::AGGRESSIVE;
+    }
+
+    if (defenders == 0)
+    {
+        setOwner(order.target, player);
+        territories.SetArmies(order.target, attackers);
+    }
+    else
+    {
+        territories.SetArmies(order.target, defenders);
+    }
+}
+
+/**
+ * @brief Conquers every territory of someone else next to the player's, as CheaterPlayerStrategy does.
+ */
+void ForkableGame::conquerNeighbours(int player)
+{
+    std::vector<int> conquered;
+    for (int territory = 0; territory < territoryCount(); ++territory)
+    {
+        if (owner(territory) != player)
+        {
+            continue;
+        }
+
+        for (const int *neighbour = neighboursBegin(territory); neighbour != neighboursEnd(territory); ++neighbour)
+        {
+            // Unowned territories have no owner to take them from
+            if (owner(*neighbour) != player && owner(*neighbour) >= 0)
+            {
+                conquered.push_back(*neighbour);
+            }
+        }
+    }
+
+    for (int territory : conquered)
+    {
+        setOwner(territory, player);
+    }
+}
+
+void ForkableGame::setOwner(int territory, int player)
+{
+    const int previous = owner(territory);
+    if (previous == player)
+    {
+        return;
+    }
+
+    if (previous >= 0)
+    {
+        owned[previous]--;
+    }
+    if (player >= 0)
+    {
+        owned[player]++;
+    }
+    territories.SetOwner(territory, player);
+}
+
+/**
+ * @param player The index of a player.
+ * @return How well the player is doing, between 0 and 1.
+ */
+double ForkableGame::evaluate(int player) const
+{
+    if (owned[player] == 0)
+    {
+        return 0;
+    }
+    if (alivePlayers() == 1)
+    {
+        return 1;
+    }
+
+    int ownedTerritories = 0;
+    long long playerArmies = 0;
+    long long totalArmies = 0;
+    for (int territory = 0; territory < territoryCount(); ++territory)
+    {
+        const int territoryOwner = owner(territory);
+        if (territoryOwner < 0)
+        {
+            continue;
+        }
+
+        ownedTerritories++;
+        totalArmies += armies(territory);
+        if (territoryOwner == player)
+        {
+            playerArmies += armies(territory);
+        }
+    }
+
+    const double territoryShare = static_cast<double>(owned[player]) / ownedTerritories;
+    const double armyShare = totalArmies == 0 ? territoryShare : static_cast<double>(playerArmies) / totalArmies;
+    return (territoryShare + armyShare) / 2;
+}
@@ -0,0 +1,149 @@
+#ifndef FORKABLE_GAME_H
+#define FORKABLE_GAME_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "MapFiles/Map.h"
+#include "PlayerFiles/PlayerStrategies.h"
+
+class Player;
+
+/**
+ * @brief A deploy or advance order of a simulated turn, on territory ids.
+ */
+struct SimulatedOrder
+{
+    int source; ///< The territory the armies leave, -1 for a deploy order.
+    int target; ///< The territory the armies go to.
+    int armies; ///< The armies deployed or advanced.
+};
+
+typedef std::vector<SimulatedOrder> SimulatedTurn; ///< The orders of a player for a turn, deploys first.
+
+/**
+ * @brief A game reduced to what decides its outcome, cheap to fork for lookahead.
+ *
+ * The armies and owners of the territories live in a copy-on-write MapSnapshot, and the rest of the state is a few
+ * integers per player, so a fork costs a handful of small copies and territories are only duplicated once a fork
+ * changes them. The map's adjacency, continents and distance tables are shared read-only by every fork, which may
+ * be played on different threads.
+ *
+ * Turns follow the rules of the engine: cheaters conquer while orders are issued, then every deploy order runs
+ * player by player and other orders run one per player at a time, battles being fought by the BattleKernel.
+ * Players that are not simulated by a given turn plan follow the rollout policy of their strategy: the logic of
+ * the built-in strategy of the same kind, without cards. Human, custom and search strategies roll out as
+ * aggressive players.
+ */
+class ForkableGame
+{
+public:
+    /**
+     * @brief Captures the state of a game being played.
+     *
+     * @param map The map of the game, its territory ids must be assigned.
+     * @param players The players of the game, in turn order.
+     */
+    ForkableGame(const Map &map, const std::vector<Player *> &players);
+
+    /**
+     * @return A fork of the game that shares its state until one of them changes it.
+     */
+    ForkableGame fork() const;
+
+    int playerCount() const;
+    int territoryCount() const;
+
+    /**
+     * @param player A player of the game.
+     * @return The index of the player, -1 if the player is not part of the game.
+     */
+    int playerIndex(const Player *player) const;
+
+    /**
+     * @param index The index of a player.
+     * @return The player captured at that index.
+     */
+    Player *playerAt(int index) const;
+
+    int owner(int territory) const;
+    int armies(int territory) const;
+
+    /**
+     * @return The ids of the territories adjacent to a territory.
+     */
+    const int *neighboursBegin(int territory) const;
+    const int *neighboursEnd(int territory) const;
+
+    int territoriesOwned(int player) const;
+    int alivePlayers() const;
+
+    /**
+     * @return The armies the player deploys this turn.
+     */
+    int pool(int player) const;
+
+    /**
+     * @brief Gives every player its reinforcements for a new turn: a third of its territories, at least 3, plus the
+     * bonus of every continent it holds.
+     */
+    void assignReinforcements();
+
+    /**
+     * @param player The index of a player.
+     * @return The turn the rollout policy of the player plans on the current state.
+     */
+    SimulatedTurn planPolicyTurn(int player) const;
+
+    /**
+     * @brief Plays a turn: every player follows its rollout policy, except the given player which plays the given
+     * turn.
+     *
+     * @param player The index of the player whose turn is given, -1 if every player follows its policy.
+     * @param turn The turn of that player.
+     * @param seed The seed of the battles of the turn.
+     */
+    void playTurn(int player, const SimulatedTurn &turn, std::uint64_t seed);
+
+    /**
+     * @param player The index of a player.
+     * @return How well the player is doing, 1 if it is the last player standing, 0 if it is eliminated, and
+     * otherwise the mean of its shares of the owned territories and of the armies on the map.
+     */
+    double evaluate(int player) const;
+
+private:
+    /**
+     * @brief What the forks of a game share.
+     */
+    struct Topology
+    {
+        const Map *map;                           ///< The map, for its distance tables only.
+        std::vector<int> adjacencyOffsets;        ///< See Map::adjacencyOffsets.
+        std::vector<int> adjacencyTargets;        ///< See Map::adjacencyOffsets.
+        std::vector<std::vector<int>> continents; ///< The territory ids of every continent.
+        std::vector<int> continentBonuses;        ///< The bonus of every continent.
+        std::vector<Player *> players;            ///< The players, by index.
+    };
+
+    ForkableGame() = default;
+
+    void planAggressive(int player, SimulatedTurn &turn) const;
+    void planBenevolent(int player, SimulatedTurn &turn) const;
+    void conquerNeighbours(int player);
+    void setOwner(int territory, int player);
+
+    /**
+     * @brief Executes an advance order, fighting a battle if the target belongs to someone else.
+     */
+    void advance(int player, const SimulatedOrder &order, std::uint64_t seed);
+
+    std::shared_ptr<const Topology> topology;
+    MapSnapshot territories;
+    std::vector<StrategyKind> kinds;     ///< The rollout policy of every player.
+    std::vector<int> pools;              ///< The armies every player deploys this turn.
+    std::vector<int> baseReinforcements; ///< The reinforcements of every player without continent bonuses.
+    std::vector<int> owned;              ///< The number of territories of every player.
+};
+
+#endif
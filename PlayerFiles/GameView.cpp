@@ -0,0 +1,200 @@
+#include <algorithm>
+#include <unordered_map>
+#include "PlayerFiles/GameView.h"
+#include "PlayerFiles/Player.h"
+#include "PlayerFiles/PlayerStrategies.h"
+
+// ---------------------- GameView Class Implementation ----------------------
+
+/**
+ * @brief Computes the view of a player in one pass over its territories and their neighbours.
+ *
+ * @param player The player planning the turn.
+ * @param deck The deck played cards return to.
+ */
+GameView::GameView(Player *player, Deck *deck)
+    : player(player), map(player->map), deck(deck), hand(player->getPlayerHand()),
+      reinforcements(player->reinforcement_units), neutralPlayer(nullptr), owned(player->getOwnedTerritories()),
+      ownedSet(owned.begin(), owned.end()), ownedByArmies(owned)
+{
+    std::stable_sort(ownedByArmies.begin(), ownedByArmies.end(), [](Territory *a, Territory *b)
+                     { return a->numberOfArmies < b->numberOfArmies; });
+
+    // Index of every enemy neighbour in enemyNeighbours
+    std::unordered_map<Territory *, std::size_t> neighbourIndex;
+    for (Territory *territory : owned)
+    {
+        for (Territory *neighbour : territory->adjacentTerritories)
+        {
+            if (ownedSet.count(neighbour) > 0)
+            {
+                continue;
+            }
+
+            auto found = neighbourIndex.find(neighbour);
+            if (found == neighbourIndex.end())
+            {
+                found = neighbourIndex.emplace(neighbour, enemyNeighbours.size()).first;
+                enemyNeighbours.push_back(neighbour);
+                strongestNeighbours.push_back(nullptr);
+            }
+
+            // Only a territory with armies can attack, the first of the strongest wins ties
+            Territory *&strongest = strongestNeighbours[found->second];
+            if (territory->numberOfArmies > (strongest == nullptr ? 0 : strongest->numberOfArmies))
+            {
+                strongest = territory;
+            }
+        }
+    }
+
+    for (Player *other : Player::players)
+    {
+        if (PlayerStrategy::isKind(other->getStrategy(), StrategyKind::NEUTRAL))
+        {
+            neutralPlayer = other;
+            break;
+        }
+    }
+}
+
+/**
+ * @return The player's territory with the most armies, the last one on ties, nullptr if the player has none.
+ */
+Territory *GameView::strongestOwned() const
+{
+    Territory *strongest = nullptr;
+    for (Territory *territory : owned)
+    {
+        if (strongest == nullptr || territory->numberOfArmies >= strongest->numberOfArmies)
+        {
+            strongest = territory;
+        }
+    }
+    return strongest;
+}
+
+/**
+ * @return The player's territory with the fewest armies, nullptr if the player has none.
+ */
+Territory *GameView::weakestOwned() const
+{
+    return ownedByArmies.empty() ? nullptr : ownedByArmies.front();
+}
+
+// ---------------------- OrderBatch Class Implementation ----------------------
+
+OrderBatch::OrderBatch(OrderBatch &&other) : orders(std::move(other.orders)), cardsPlayed(std::move(other.cardsPlayed))
+{
+    other.orders.clear();
+    other.cardsPlayed.clear();
+}
+
+OrderBatch &OrderBatch::operator=(OrderBatch &&other)
+{
+    if (this != &other)
+    {
+        for (Order *order : orders)
+        {
+            delete order;
+        }
+        orders = std::move(other.orders);
+        cardsPlayed = std::move(other.cardsPlayed);
+        other.orders.clear();
+        other.cardsPlayed.clear();
+    }
+    return *this;
+}
+
+/**
+ * @brief Deletes the orders never issued.
+ */
+OrderBatch::~OrderBatch()
+{
+    for (Order *order : orders)
+    {
+        delete order;
+    }
+}
+
+/**
+ * @brief Adds an order to the turn.
+ *
+ * @param order The order, owned by the batch from now on.
+ */
+void OrderBatch::add(Order *order)
+{
+    orders.push_back(order);
+}
+
+/**
+ * @brief Plays a card of the hand this turn.
+ *
+ * @param type The type of the card.
+ */
+void OrderBatch::play(CardType type)
+{
+    cardsPlayed.push_back(type);
+}
+
+/**
+ * @return The orders of the turn, in the order they are issued.
+ */
+const std::vector<Order *> &OrderBatch::getOrders() const
+{
+    return orders;
+}
+
+/**
+ * @return The cards played this turn.
+ */
+const std::vector<CardType> &OrderBatch::getCardsPlayed() const
+{
+    return cardsPlayed;
+}
+
+/**
+ * @return The number of orders of the turn.
+ */
+std::size_t OrderBatch::size() const
+{
+    return orders.size();
+}
+
+/**
+ * @return true if the turn has no order.
+ */
+bool OrderBatch::empty() const
+{
+    return orders.empty();
+}
+
+/**
+ * @brief Adds the orders to the orders list of the player and moves the played cards from the player's hand
+ * back to the deck, which empties the batch.
+ *
+ * @param player The player issuing the turn.
+ * @param deck The deck the cards return to, if nullptr they are discarded.
+ */
+void OrderBatch::issue(Player *player, Deck *deck)
+{
+    for (Order *order : orders)
+    {
+        player->getOrdersList()->add(order);
+    }
+
+    for (CardType type : cardsPlayed)
+    {
+        if (deck != nullptr)
+        {
+            player->getPlayerHand()->play(type, *deck);
+        }
+        else
+        {
+            player->getPlayerHand()->remove(type);
+        }
+    }
+
+    orders.clear();
+    cardsPlayed.clear();
+}
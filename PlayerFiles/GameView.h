@@ -0,0 +1,115 @@
+#ifndef GAME_VIEW_H
+#define GAME_VIEW_H
+
+#include <unordered_set>
+#include <vector>
+#include "MapFiles/Map.h"
+#include "CardsFiles/Cards.h"
+
+class Player;
+
+/**
+ * @brief What a player sees of the game when planning a turn, computed once per turn so that every decision of
+ * the turn shares it instead of recomputing it from the player.
+ *
+ * The view refers to the game: it is only valid until the game changes, which no planning does.
+ */
+class GameView
+{
+public:
+    Player *player;        ///< The player planning the turn.
+    Map *map;              ///< The map being played, nullptr if unknown.
+    Deck *deck;            ///< The deck played cards return to, nullptr if there is none.
+    const Hand *hand;      ///< The cards of the player.
+    int reinforcements;    ///< The armies the player deploys this turn.
+    Player *neutralPlayer; ///< The first player with a neutral strategy, nullptr if there is none.
+
+    std::vector<Territory *> owned;               ///< The territories of the player, in the player's order.
+    std::unordered_set<Territory *> ownedSet;     ///< The territories of the player, for membership tests.
+    std::vector<Territory *> ownedByArmies;       ///< The territories of the player, weakest first.
+    std::vector<Territory *> enemyNeighbours;     ///< Territories of other players next to the player's, in order of discovery.
+    std::vector<Territory *> strongestNeighbours; ///< For every enemy neighbour, the player's strongest territory next to it.
+
+    /**
+     * @brief Computes the view of a player.
+     *
+     * @param player The player planning the turn.
+     * @param deck The deck played cards return to.
+     */
+    GameView(Player *player, Deck *deck);
+
+    /**
+     * @return The player's territory with the most armies, the last one on ties, nullptr if the player has none.
+     */
+    Territory *strongestOwned() const;
+
+    /**
+     * @return The player's territory with the fewest armies, nullptr if the player has none.
+     */
+    Territory *weakestOwned() const;
+};
+
+/**
+ * @brief The orders and card plays that make up a player's turn, planned at once and issued at once.
+ *
+ * A batch owns its orders until it issues them, and deletes those it never issues.
+ */
+class OrderBatch
+{
+public:
+    OrderBatch() = default;
+    OrderBatch(OrderBatch &&other);
+    OrderBatch &operator=(OrderBatch &&other);
+    OrderBatch(const OrderBatch &) = delete;
+    OrderBatch &operator=(const OrderBatch &) = delete;
+    ~OrderBatch();
+
+    /**
+     * @brief Adds an order to the turn.
+     *
+     * @param order The order, owned by the batch from now on.
+     */
+    void add(Order *order);
+
+    /**
+     * @brief Plays a card of the hand this turn, the order it creates being added separately.
+     *
+     * @param type The type of the card.
+     */
+    void play(CardType type);
+
+    /**
+     * @return The orders of the turn, in the order they are issued.
+     */
+    const std::vector<Order *> &getOrders() const;
+
+    /**
+     * @return The cards played this turn.
+     */
+    const std::vector<CardType> &getCardsPlayed() const;
+
+    /**
+     * @return The number of orders of the turn.
+     */
+    std::size_t size() const;
+
+    /**
+     * @return true if the turn has no order.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Adds the orders to the orders list of the player and moves the played cards from the player's hand
+     * back to the deck, which empties the batch.
+     *
+     * @param player The player issuing the turn.
+     * @param deck The deck the cards return to, if nullptr they are discarded.
+     */
+    void issue(Player *player, Deck *deck);
+
+private:
+    std::vector<Order *> orders;
+    std::vector<CardType> cardsPlayed;
+};
+
+#endif
@@ -8,6 +8,7 @@
 #include "CardsFiles/Cards.h"
 #include "OrdersFiles/Orders.h"
 #include "PlayerFiles/PlayerStrategies.h"
+#include "OrdersFiles/NegotiationMatrix.h"
 
 class Player
 {
@@ -19,7 +20,7 @@ private:
     Hand *playerHand;                             // Pointer to the player's hand of cards
     OrdersList *ordersList;                       // Pointer to the player's orders list
     int numArmies;                                // Number of armies player controls
-    PlayerStrategy *strategy;
+    PlayerStrategy *strategy = nullptr;
 
 public:
     // Constructors, assignment operator, and destructor
@@ -59,8 +60,12 @@ public:
     void issueOrder(Deck *deck); // Issues an order for the player
 
     Deck *deck = nullptr; // Pointer to the deck for player to draw from
+    Map *map = nullptr;   // Pointer to the map being played, used by strategies for distance lookups
 
-    static std::vector<Player *> players; // Pointer to player that would be stored in GameEngine, used for finding owners of enemy territories.
+    NegotiationMatrix *negotiations = nullptr; // Negotiations of the game being played, set when a turn begins
+    int negotiationIndex = -1;                 // Index of the player in the negotiations, -1 if not indexed
+
+    static thread_local std::vector<Player *> players; // Players of the game played by the calling thread, used for finding owners of enemy territories.
 
     int reinforcement_units = 0;
 };
@@ -4,6 +4,9 @@
 #include "MapFiles/Map.h"
 #include "CardsFiles/Cards.h"
 #include "OrdersFiles/Orders.h"
+#include "OrdersFiles/CombatOdds.h"
+#include "PlayerFiles/TurnSearch.h"
+#include "PlayerFiles/DecisionProfiler.h"
 #include <iostream>
 #include <algorithm>
 #include <set>
@@ -17,12 +20,127 @@ std::string toLower(const std::string &str)
     return lowerStr;
 }
 
-bool PlayerStrategy::isIssuingOrders() const {
-    return issuingOrders;
+// ----- StrategyKind Implementation -----
+
+namespace
+{
+    const std::string strategyKindNames[] = {"Human", "Aggressive", "Benevolent", "Neutral", "Cheater", "MCTS", "Custom"};
+}
+
+/**
+ * @param kind A kind of strategy.
+ * @return The name of the kind, as given to the tournament command.
+ */
+const std::string &strategyKindName(StrategyKind kind)
+{
+    return strategyKindNames[static_cast<int>(kind)];
+}
+
+/**
+ * Finds the kind of strategy with the given name, as given to the tournament command.
+ *
+ * @param name The name of a built-in strategy.
+ * @param kind Receives the kind of strategy.
+ * @return true if the name is the name of a built-in strategy.
+ */
+bool parseStrategyKind(const std::string &name, StrategyKind &kind)
+{
+    for (int i = 0; i < static_cast<int>(StrategyKind::CUSTOM); ++i)
+    {
+        if (name == strategyKindNames[i])
+        {
+            kind = static_cast<StrategyKind>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Creates a built-in strategy.
+ *
+ * @param kind The kind of the strategy, CUSTOM kinds have no built-in strategy.
+ * @param player The player using the strategy.
+ * @return The new strategy, nullptr for a CUSTOM kind.
+ */
+PlayerStrategy *createStrategy(StrategyKind kind, Player *player)
+{
+    switch (kind)
+    {
+    case StrategyKind::HUMAN:
+        return new HumanPlayerStrategy(player);
+    case StrategyKind::AGGRESSIVE:
+        return new AggressivePlayerStrategy(player);
+    case StrategyKind::BENEVOLENT:
+        return new BenevolentPlayerStrategy(player);
+    case StrategyKind::NEUTRAL:
+        return new NeutralPlayerStrategy(player);
+    case StrategyKind::CHEATER:
+        return new CheaterPlayerStrategy(player);
+    case StrategyKind::MCTS:
+        return new MCTSPlayerStrategy(player);
+    default:
+        return nullptr;
+    }
+}
+
+/**
+ * Creates a built-in strategy from its tournament name.
+ *
+ * @param name The name of a kind of strategy, or AggressivePlayerStrategy::FRONTIER_NAME.
+ * @param player The player using the strategy.
+ * @return The new strategy, nullptr for an unknown name.
+ */
+PlayerStrategy *createStrategy(const std::string &name, Player *player)
+{
+    if (name == AggressivePlayerStrategy::FRONTIER_NAME)
+    {
+        return new AggressivePlayerStrategy(player, AggressivePlayerStrategy::Routing::FRONTIER);
+    }
+
+    StrategyKind kind;
+    return parseStrategyKind(name, kind) ? createStrategy(kind, player) : nullptr;
 }
 
-void PlayerStrategy::setIssuingOrders(bool state) {
-    issuingOrders = state;
+// ----- PlayerStrategy Implementation -----
+
+/**
+ * @return The name of the kind of the strategy.
+ */
+const std::string &PlayerStrategy::name() const
+{
+    return strategyKindName(strategyKind);
+}
+
+/**
+ * @return The profile of the strategy's name, kept after the first lookup.
+ */
+DecisionProfile *PlayerStrategy::decisionProfile()
+{
+    if (profile == nullptr)
+    {
+        profile = DecisionProfiler::profile(name());
+    }
+    return profile;
+}
+
+/**
+ * @param view What the player sees of the game this turn.
+ * @return No order, strategies that plan their turns override it.
+ */
+OrderBatch PlayerStrategy::planTurn(const GameView & /* view */)
+{
+    return OrderBatch();
+}
+
+/**
+ * Issues the turn of the player as planned by planTurn.
+ *
+ * @param deck The deck played cards return to.
+ */
+void PlayerStrategy::issueOrder(Deck *deck)
+{
+    issuePlannedTurn(*this, player, deck);
 }
 
 // ----- HumanPlayerStrategy Implementation -----
@@ -43,10 +161,8 @@ std::vector<Territory *> HumanPlayerStrategy::toAttack()
     for (Territory *defendTerritory : player->getToDefendTerritories())
     {
         // Check adjacent territories of each owned territory
-        for (const auto &adjacentPair : defendTerritory->adjacentTerritories)
+        for (Territory *adjacentTerritory : defendTerritory->adjacentTerritories)
         {
-            Territory *adjacentTerritory = adjacentPair.second;
-
             // If the adjacent territory is not already in "toDefend", it's an enemy
             if (std::find(player->getToDefendTerritories().begin(), player->getToDefendTerritories().end(), adjacentTerritory) == player->getToDefendTerritories().end())
             {
@@ -125,53 +241,45 @@ void HumanPlayerStrategy::issueOrder(Deck *deck)
     else if (orderType == "airlift" || orderType == "blockade" || orderType == "negotiate" || orderType == "bomb")
     {
         // Card-based orders
-        for (Card *c : player->getPlayerHand()->handVector)
+        CardType cardType;
+        if (parseCardType(orderType, cardType) && player->getPlayerHand()->has(cardType))
         {
-            if (c->cardType == orderType)
+            CardOrderArguments arguments;
+            arguments.player = player;
+
+            if (cardType == CardType::AIRLIFT)
+            {
+                std::cout << "Enter the source territory: ";
+                std::getline(std::cin, arguments.source);
+
+                std::cout << "Enter the target territory: ";
+                std::getline(std::cin, arguments.target);
+
+                std::cout << "Enter the number of armies to airlift: ";
+                std::cin >> arguments.armies;
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            }
+            else if (cardType == CardType::BLOCKADE)
+            {
+                std::cout << "Enter the territory to blockade: ";
+                std::getline(std::cin, arguments.target);
+            }
+            else if (cardType == CardType::DIPLOMACY)
+            {
+                std::cout << "Enter the name of the player to negotiate with: ";
+                std::getline(std::cin, arguments.target);
+            }
+            else if (cardType == CardType::BOMB)
             {
-                if (orderType == "airlift")
-                {
-                    std::cout << "Enter the source territory: ";
-                    std::getline(std::cin, sourceTName);
-
-                    std::cout << "Enter the target territory: ";
-                    std::getline(std::cin, targetTName);
-
-                    std::cout << "Enter the number of armies to airlift: ";
-                    std::cin >> armies;
-                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-
-                    player->getOrdersList()->add(new AirliftOrder(sourceTName, targetTName, armies));
-                }
-                else if (orderType == "blockade")
-                {
-                    std::cout << "Enter the territory to blockade: ";
-                    std::getline(std::cin, targetTName);
-
-                    player->getOrdersList()->add(new BlockadeOrder(targetTName));
-                }
-                else if (orderType == "negotiate")
-                {
-                    std::cout << "Enter the name of the player to negotiate with: ";
-                    std::getline(std::cin, targetTName);
-
-                    player->getOrdersList()->add(new NegotiateOrder(player, targetTName));
-                }
-                else if (orderType == "bomb")
-                {
-                    std::cout << "Enter the enemy territory to bomb: ";
-                    std::getline(std::cin, targetTName);
-
-                    player->getOrdersList()->add(new BombOrder(targetTName));
-                }
-
-                // Play the card
-                deck->deckVector.push_back(c);
-                player->getPlayerHand()->handVector.erase(std::remove(player->getPlayerHand()->handVector.begin(),
-                                                                      player->getPlayerHand()->handVector.end(), c),
-                                                          player->getPlayerHand()->handVector.end());
-                return;
+                std::cout << "Enter the enemy territory to bomb: ";
+                std::getline(std::cin, arguments.target);
             }
+
+            player->getOrdersList()->add(createCardOrder(cardType, arguments));
+
+            // Play the card
+            player->getPlayerHand()->play(cardType, *deck);
+            return;
         }
 
         std::cout << "Error: No card available for this order.\n";
@@ -198,152 +306,76 @@ std::vector<Territory *> BenevolentPlayerStrategy::toAttack()
     return {}; // Benevolent players do not attack
 }
 
-void BenevolentPlayerStrategy::issueOrder(Deck *deck)
+OrderBatch BenevolentPlayerStrategy::planTurn(const GameView &view)
 {
-    if (!issuingOrders) {
-        issuingOrders = true; // indicate to the caller that the player may continue issuing orders this turn
+    OrderBatch batch;
+    Territory *weakest = view.weakestOwned();
+    if (weakest == nullptr)
+    {
+        return batch;
     }
 
-    // Deploy armies to the weakest territories
-    if (deploying) {
-        int armies_available = player->getNumArmies();
-
-        for (Territory *weakestTerritory : toDefend())
-        {
-            if (armies_available > 0)
-            {
-                // Deploy as many armies as possible to the weakest territory
-                int armiesToDeploy = player->getNumArmies(); // TODO: maybe update to spread out the armies more at the start
-
-                // Create a deploy order and add it to the player's orders list
-                player->getOrdersList()->add(new DeployOrder(player, weakestTerritory->name, armiesToDeploy));
-                armies_available -= armies_available;
-            }
-        }
-        deploying = false;
-        return;
+    // Deploy all armies to the weakest territory
+    if (player->getNumArmies() > 0)
+    {
+        batch.add(new DeployOrder(player, weakest->name, player->getNumArmies())); // TODO: maybe update to spread out the armies more at the start
     }
 
-    if (advancing)
+    // Benevolent players do not attack but can advance armies to reinforce weaker territories
+    if (view.ownedByArmies.size() >= 2)
     {
-        // Benevolent players do not attack but can advance armies to reinforce weaker territories
-        std::vector<Territory *> defendableTerritories = player->toDefend();
+        Territory *source = nullptr; // Strongest territory adjacent to the weakest
+        int maxArmies = 0;
 
-        // Ensure we have at least two territories to work with
-        if (defendableTerritories.size() >= 2)
+        for (Territory *territory : view.ownedByArmies)
         {
-            // Sort territories from weakest to strongest
-            Territory *target = defendableTerritories.front(); // Weakest
-            Territory *source = nullptr;  // Strongest
-            int maxArmies = 0;
-
-            for (Territory* territory : defendableTerritories) {
-                // Check if this territory is adjacent to the weakest territory
-                if (territory->adjacentTerritories.count(target->name) > 0) {
-                    if (territory->numberOfArmies > maxArmies) {
-                        maxArmies = territory->numberOfArmies;
-                        source = territory; // Get the strongest territory adjacent to target
-                    }
-                }
-            }
-
-            // Only move armies if the source territory has enough to spare
-            if (source != target && source != nullptr && source->numberOfArmies > 1)
+            if (territory->IsAdjacentTo(weakest) && territory->numberOfArmies > maxArmies)
             {
-                int armiesToAdvance = source->numberOfArmies - 1;
-
-                // Create an advance order and add it to the player's orders list
-                player->getOrdersList()->add(new AdvanceOrder(player, nullptr, source->name, target->name, armiesToAdvance));
+                maxArmies = territory->numberOfArmies;
+                source = territory;
             }
         }
 
-        advancing = false;
-        return;
-    }
-
-    // Play the airlift and/or blockcade cards to strengthen weak territories
-    if (blockading || airlifting) {
-        bool hasValidAirliftCard = false;
-        bool hasValidBlockadeCard = false;
-        for (Card *card : player->getPlayerHand()->handVector)
+        // Only move armies if the source territory has enough to spare
+        if (source != weakest && source != nullptr && source->numberOfArmies > 1)
         {
-            if (airlifting && toLower(card->cardType) == "airlift")
-            {
-                // Identify source and target territories for airlift
-                std::vector<Territory *> defendableTerritories = toDefend();
-                player->setOwnedTerritories(defendableTerritories);
-                if (defendableTerritories.size() >= 2)
-                {
-                    Territory *source = defendableTerritories.back();
-                    Territory *target = defendableTerritories.front();
-                    if (source != target && source->numberOfArmies > 1)
-                    {
-
-                        int armiesToAirlift = source->numberOfArmies - 1;
-                        auto airliftOrder = new AirliftOrder(source->name, target->name, armiesToAirlift);
-                        airliftOrder->setPlayer(player);
-
-                        player->getOrdersList()->add(airliftOrder);
-
-                        // Play the card
-                        deck->deckVector.push_back(card);
-                        player->getPlayerHand()->handVector.erase(std::remove(player->getPlayerHand()->handVector.begin(),
-                                                                              player->getPlayerHand()->handVector.end(), card),
-                                                                  player->getPlayerHand()->handVector.end());
-                        std::cout << "Benevolent Player airlifted " << armiesToAirlift << " units from "
-                                  << source->name << " to " << target->name << ".\n";
-                        hasValidAirliftCard = true;
-                        return; // airlift as much as possible
-                    }
-                }
-            }
-
-            if (blockading && toLower(card->cardType) == "blockade")
-            {
-                // Blockade the weakest territory
-                std::vector<Territory *> defendableTerritories = toDefend();
-                if (!defendableTerritories.empty())
-                {
-                    Territory *target = defendableTerritories.front();
-                    auto blockadeOrder = new BlockadeOrder(target->name);
-                    blockadeOrder->setPlayer(player);
-
-                    for (auto p : Player::players) {
-                        if (dynamic_cast<NeutralPlayerStrategy*>(p->getStrategy()) != nullptr) {
-                            blockadeOrder->neutralPlayer = p;
-                            break;
-                        }
-                    }
-
-                    if (blockadeOrder->neutralPlayer != nullptr) {
-                        player->getOrdersList()->add(blockadeOrder);
-
-                        // Play the card
-                        deck->deckVector.push_back(card);
-                        player->getPlayerHand()->handVector.erase(std::remove(player->getPlayerHand()->handVector.begin(),
-                                                                              player->getPlayerHand()->handVector.end(), card),
-                                                                  player->getPlayerHand()->handVector.end());
-                        std::cout << "Benevolent Player used blockade on " << target->name << ".\n";
-                        hasValidBlockadeCard = true;
-                        blockading = false; // only blockade once
-                        break;
-                    }
-                }
-            }
+            batch.add(new AdvanceOrder(player, nullptr, source->name, weakest->name, source->numberOfArmies - 1));
         }
+    }
 
-        if (!hasValidAirliftCard && !hasValidBlockadeCard) {
-            airlifting = false;
-            blockading = false;
+    // Play every airlift card to move armies from the strongest territory to the weakest
+    Territory *strongest = view.ownedByArmies.back();
+    if (strongest != weakest && strongest->numberOfArmies > 1)
+    {
+        for (int i = 0; i < view.hand->count(CardType::AIRLIFT); ++i)
+        {
+            CardOrderArguments arguments;
+            arguments.player = player;
+            arguments.source = strongest->name;
+            arguments.target = weakest->name;
+            arguments.armies = strongest->numberOfArmies - 1;
+
+            batch.add(CardOrderFactory<CardType::AIRLIFT>::create(arguments));
+            batch.play(CardType::AIRLIFT);
+            std::cout << "Benevolent Player airlifted " << arguments.armies << " units from "
+                      << strongest->name << " to " << weakest->name << ".\n";
         }
-    } else {
-        deploying = true;
-        advancing = true;
-        airlifting = true;
-        blockading = true;
+    }
 
-        issuingOrders = false;
+    // Blockade the weakest territory once
+    if (view.hand->has(CardType::BLOCKADE) && view.neutralPlayer != nullptr)
+    {
+        CardOrderArguments arguments;
+        arguments.player = player;
+        arguments.target = weakest->name;
+        arguments.neutralPlayer = view.neutralPlayer;
+
+        batch.add(CardOrderFactory<CardType::BLOCKADE>::create(arguments));
+        batch.play(CardType::BLOCKADE);
+        std::cout << "Benevolent Player used blockade on " << weakest->name << ".\n";
     }
+
+    return batch;
 }
 
 // ----- CheaterPlayerStrategy Implementation -----
@@ -362,10 +394,8 @@ std::vector<Territory *> CheaterPlayerStrategy::toAttack()
     for (Territory *ownedTerritory : player->getOwnedTerritories())
     {
         // Check each adjacent territory
-        for (const auto &adjacentTerritory : ownedTerritory->adjacentTerritories)
+        for (Territory *enemyTerritory : ownedTerritory->adjacentTerritories)
         {
-            Territory *enemyTerritory = adjacentTerritory.second;
-
             // If the adjacent territory is not owned by the cheater, add it to the set
             if (std::find(player->getOwnedTerritories().begin(), player->getOwnedTerritories().end(), enemyTerritory) == player->getOwnedTerritories().end())
             {
@@ -444,10 +474,8 @@ std::vector<Territory *> AggressivePlayerStrategy::toAttack()
     for(Territory *ownedTerritory : ownedTerritories)
     {   
         // For each adjacent territory
-        for(const auto &adjacentTerritory : ownedTerritory->adjacentTerritories)
+        for(Territory *enemyTerritory : ownedTerritory->adjacentTerritories)
         {   
-            // Create an instance of the enemy/adjacent territory
-            Territory *enemyTerritory = adjacentTerritory.second;
             // Check if enemy/adjacent territory is not one of ours
             if (std::find(ownedTerritories.begin(), ownedTerritories.end(), enemyTerritory) == ownedTerritories.end())
             {   
@@ -465,107 +493,221 @@ std::vector<Territory *> AggressivePlayerStrategy::toAttack()
 }
 
 
-void AggressivePlayerStrategy::issueOrder(Deck *deck)
+const std::string AggressivePlayerStrategy::FRONTIER_NAME = "AggressiveFrontier";
+
+/**
+ * @return FRONTIER_NAME in frontier mode, the name of the aggressive kind otherwise.
+ */
+const std::string &AggressivePlayerStrategy::name() const
 {
-    if (!issuingOrders) {
-        issuingOrders = true; // indicate to the caller that the player may continue issuing orders this turn
+    return routing == Routing::FRONTIER ? FRONTIER_NAME : PlayerStrategy::name();
+}
+
+OrderBatch AggressivePlayerStrategy::planTurn(const GameView &view)
+{
+    OrderBatch batch;
+
+    Territory *strongestTerritory = view.strongestOwned();
+    if (strongestTerritory == nullptr)
+    {
+        return batch;
     }
 
-    if (deploying)
+    // In frontier mode, deploy to the strongest territory that has an enemy neighbour
+    if (routing == Routing::FRONTIER)
     {
-        int highestArmy = 0;
-        Territory *strongestTerritory;
-        // Deploy armies to the strongest territories
-        for (Territory *strongestTerritories : toDefend())
+        Territory *strongestFrontier = nullptr;
+        for (Territory *territory : view.strongestNeighbours)
         {
-            // Find the territory with the strongest (highest army)
-            if(strongestTerritories->numberOfArmies >= highestArmy)
+            if (territory != nullptr && (strongestFrontier == nullptr || territory->numberOfArmies >= strongestFrontier->numberOfArmies))
             {
-                highestArmy = strongestTerritories->numberOfArmies;
-                strongestTerritory =  strongestTerritories;
+                strongestFrontier = territory;
             }
         }
 
-        // Create a deploy order to be added to the aggressive player's order list
-        player->getOrdersList()->add(new DeployOrder(player, strongestTerritory->name, player->reinforcement_units));
+        if (strongestFrontier != nullptr)
+        {
+            strongestTerritory = strongestFrontier;
+        }
+    }
 
-        deploying = false;
-        return;
+    // Deploy every reinforcement to the strongest territory
+    batch.add(new DeployOrder(player, strongestTerritory->name, view.reinforcements));
+
+    // Attack the adjacent enemy territory with the best odds of conquest
+    Territory *bestTarget = nullptr;
+    Territory *bestAttackingTerritory = nullptr;
+    double bestOdds = -1;
+    for (std::size_t i = 0; i < view.enemyNeighbours.size(); ++i)
+    {
+        Territory *attackingTerritory = view.strongestNeighbours[i];
+        if (attackingTerritory == nullptr)
+        {
+            continue;
+        }
+
+        double odds = CombatOdds::winProbability(attackingTerritory->numberOfArmies - 1, view.enemyNeighbours[i]->numberOfArmies);
+        if (odds > bestOdds)
+        {
+            bestTarget = view.enemyNeighbours[i];
+            bestAttackingTerritory = attackingTerritory;
+            bestOdds = odds;
+        }
     }
 
-    if (advancing)
+    if (bestTarget != nullptr)
     {
-        // Try and attack each adjacent enemy territory
-        for (Territory *enemyTerritory : player->toAttack())
-        {   
-            int maxArmy = 0;
-            std::string attackingTerritory;
-            // Find the owned territory with the largest army
-            for(Territory *ownedTerritory : player->getOwnedTerritories())
+        Player *enemyPlayer = player->FindTerritoryOwner(bestTarget->name);
+        batch.add(new AdvanceOrder(player, enemyPlayer, bestAttackingTerritory->name, bestTarget->name,
+                                   bestAttackingTerritory->numberOfArmies - 1));
+    }
+
+    // Bring armies stranded in the interior closer to the front
+    if (routing == Routing::FRONTIER)
+    {
+        routeToFrontier(view, batch);
+    }
+    else
+    {
+        routeInteriorArmies(view, batch);
+    }
+
+    // Play every bomb card in hand on the strongest enemy neighbour
+    Territory *strongestEnemy = nullptr;
+    for (Territory *enemyTerritory : view.enemyNeighbours)
+    {
+        if (strongestEnemy == nullptr || enemyTerritory->numberOfArmies >= strongestEnemy->numberOfArmies)
+        {
+            strongestEnemy = enemyTerritory;
+        }
+    }
+
+    if (strongestEnemy != nullptr)
+    {
+        for (int i = 0; i < view.hand->count(CardType::BOMB); ++i)
+        {
+            CardOrderArguments arguments;
+            arguments.player = player;
+            arguments.target = strongestEnemy->name;
+            batch.add(CardOrderFactory<CardType::BOMB>::create(arguments));
+            batch.play(CardType::BOMB);
+        }
+    }
+
+    return batch;
+}
+
+/**
+ * Moves every stack sitting on an interior territory one hop towards the front.
+ *
+ * @param view What the player sees of the game this turn.
+ * @param batch Receives the advance orders.
+ * @return The number of advance orders planned.
+ */
+int AggressivePlayerStrategy::routeToFrontier(const GameView &view, OrderBatch &batch)
+{
+    Map *map = view.map;
+    if (map == nullptr || map->territoriesById.empty())
+    {
+        return 0;
+    }
+
+    // The front is every territory of the player with an enemy neighbour, and armies only cross the player's territories
+    std::vector<int> frontier;
+    std::vector<char> passable(map->territoriesById.size(), 0);
+    for (Territory *territory : view.owned)
+    {
+        passable[territory->id] = 1;
+        for (Territory *adjacent : territory->adjacentTerritories)
+        {
+            if (view.ownedSet.count(adjacent) == 0)
             {
-                // Check if this territory is adjacent
-                if (ownedTerritory->adjacentTerritories.count(enemyTerritory->name) > 0) {
-                    if (ownedTerritory->numberOfArmies > maxArmy) {
-                        maxArmy = ownedTerritory->numberOfArmies;
-                        attackingTerritory = ownedTerritory->name;
-                    }
-                }
+                frontier.push_back(territory->id);
+                break;
             }
+        }
+    }
 
-            if (!attackingTerritory.empty() && maxArmy > 0) {
-                int armiesToAdvance = maxArmy - 1;
+    std::vector<int> distances;
+    map->MultiSourceDistances(frontier, passable, distances);
 
-                Player *enemyPlayer = player->FindTerritoryOwner(enemyTerritory->name);
-                player->getOrdersList()->ordersVector.push_back(
-                        new AdvanceOrder(player, enemyPlayer, attackingTerritory, enemyTerritory->name, armiesToAdvance));
-                advancing = false;
+    // Every interior stack advances to a neighbour one hop closer to the front, the first one in name order
+    int advances = 0;
+    for (Territory *territory : view.owned)
+    {
+        const int distance = distances[territory->id];
+        if (distance <= 0 || territory->numberOfArmies <= 1)
+        {
+            continue;
+        }
+
+        for (Territory *neighbour : territory->adjacentTerritories)
+        {
+            if (passable[neighbour->id] && distances[neighbour->id] == distance - 1)
+            {
+                batch.add(new AdvanceOrder(player, nullptr, territory->name, neighbour->name, territory->numberOfArmies - 1));
+                ++advances;
                 break;
             }
         }
     }
+    return advances;
+}
+
+bool AggressivePlayerStrategy::routeInteriorArmies(const GameView &view, OrderBatch &batch)
+{
+    Map *map = view.map;
+    if (map == nullptr || !map->HasDistances())
+    {
+        return false;
+    }
 
-    if (bombing) {
-        bool hasBombCard = false;
-
-        for (Card *card : player->getPlayerHand()->handVector) {
-            if (toLower(card->cardType) == "bomb") {
-                int highestArmy = 0;
-                Territory *strongestTerritory;
-                // Deploy armies to the strongest territories
-                for (Territory *strongestTerritories: toAttack()) {
-                    if (player->getNumArmies() > 0) {
-                        // Find the territory with the strongest (highest army)
-                        if (strongestTerritories->numberOfArmies >= highestArmy) {
-                            highestArmy = strongestTerritories->numberOfArmies;
-                            strongestTerritory = strongestTerritories;
-                        }
-                    }
-                }
-
-                // Create a deploy order to be added to the aggressive player's order list
-                player->getOrdersList()->add(new BombOrder(player, strongestTerritory->name));
-
-                // Play the card
-                deck->deckVector.push_back(card);
-                player->getPlayerHand()->handVector.erase(std::remove(player->getPlayerHand()->handVector.begin(),
-                                                                      player->getPlayerHand()->handVector.end(), card),
-                                                          player->getPlayerHand()->handVector.end());
-
-                hasBombCard = true;
+    // Find the strongest territory that has no enemy neighbour
+    Territory *source = nullptr;
+    for (Territory *territory : view.owned)
+    {
+        bool interior = true;
+        for (Territory *adjacent : territory->adjacentTerritories)
+        {
+            if (view.ownedSet.count(adjacent) == 0)
+            {
+                interior = false;
+                break;
             }
         }
 
-        if (!hasBombCard) {
-            bombing = false;
+        if (interior && territory->numberOfArmies > 1 && (source == nullptr || territory->numberOfArmies > source->numberOfArmies))
+        {
+            source = territory;
         }
-        return;
-    } else {
-        deploying = true;
-        advancing = true;
-        bombing = true;
+    }
 
-        issuingOrders = false;
+    if (source == nullptr)
+    {
+        return false;
+    }
+
+    // Head towards the closest enemy territory
+    Territory *closestEnemy = nullptr;
+    int closestDistance = -1;
+    for (Territory *enemyTerritory : view.enemyNeighbours)
+    {
+        int distance = map->HopDistance(source, enemyTerritory);
+        if (distance > 0 && (closestEnemy == nullptr || distance < closestDistance))
+        {
+            closestEnemy = enemyTerritory;
+            closestDistance = distance;
+        }
     }
+
+    Territory *next = map->NextHop(source, closestEnemy);
+    if (next == nullptr || view.ownedSet.count(next) == 0)
+    {
+        return false;
+    }
+
+    batch.add(new AdvanceOrder(player, nullptr, source->name, next->name, source->numberOfArmies - 1));
+    return true;
 }
 
 
@@ -585,8 +727,82 @@ std::vector<Territory *> NeutralPlayerStrategy::toAttack()
     return {}; // Neutral players do not attack 
 }
 
-void NeutralPlayerStrategy::issueOrder(Deck *deck)
+OrderBatch NeutralPlayerStrategy::planTurn(const GameView & /* view */)
 {
     // Neutral players do not issue any orders
     std::cout << "Neutral Player do not issue any orders" << std::endl;
+    return OrderBatch();
+}
+
+
+// ----- MCTSPlayerStrategy Implementation -----
+
+const int MCTSPlayerStrategy::MAX_ATTACKS;
+
+/**
+ * @param threads The threads searching a turn, 0 for one per hardware thread.
+ */
+void MCTSPlayerStrategy::setThreads(int threads)
+{
+    this->threads = std::max(0, threads);
+}
+
+std::vector<Territory *> MCTSPlayerStrategy::toDefend()
+{
+    // Set the territories to defend
+    player->setToDefendTerritories(player->getOwnedTerritories());
+    // Return the territories to defend
+    return player->getToDefendTerritories();
+}
+
+std::vector<Territory *> MCTSPlayerStrategy::toAttack()
+{
+    GameView view(player, nullptr);
+    player->setToAttackTerritories(view.enemyNeighbours);
+    return player->getToAttackTerritories();
+}
+
+OrderBatch MCTSPlayerStrategy::planTurn(const GameView &view)
+{
+    OrderBatch batch;
+    if (view.map == nullptr || view.owned.empty())
+    {
+        return batch;
+    }
+
+    ForkableGame game(*view.map, Player::players);
+    const int index = game.playerIndex(player);
+    if (index < 0)
+    {
+        return batch;
+    }
+
+    MonteCarloTurnSearch::Settings settings;
+    settings.rollouts = rollouts;
+    settings.timeBudgetMs = timeBudgetMs;
+    settings.threads = threads;
+    settings.seed = std::hash<std::string>()(player->getPlayerName()) + static_cast<std::uint64_t>(turnsPlanned++);
+
+    std::vector<SimulatedTurn> candidates = MonteCarloTurnSearch::candidateTurns(game, index, MAX_ATTACKS);
+    MonteCarloTurnSearch::Result result = MonteCarloTurnSearch::search(game, index, candidates, settings);
+    if (result.best < 0)
+    {
+        return batch;
+    }
+
+    // Turn the chosen candidate into orders
+    for (const SimulatedOrder &order : candidates[result.best])
+    {
+        Territory *target = view.map->territoriesById[order.target];
+        if (order.source < 0)
+        {
+            batch.add(new DeployOrder(player, target->name, order.armies));
+            continue;
+        }
+
+        const int targetOwner = game.owner(order.target);
+        Player *enemyPlayer = targetOwner >= 0 && targetOwner != index ? game.playerAt(targetOwner) : nullptr;
+        batch.add(new AdvanceOrder(player, enemyPlayer, view.map->territoriesById[order.source]->name, target->name, order.armies));
+    }
+    return batch;
 }
@@ -2,38 +2,104 @@
 #define PLAYER_STRATEGIES_H
 #include "CardsFiles/Cards.h"
 #include "MapFiles/Map.h"
+#include "PlayerFiles/GameView.h"
+
+class DecisionProfile;
 // Forward declaration
 class Player;
 
+/**
+ * The kinds of strategies. Every built-in strategy has its own kind, strategies defined elsewhere are CUSTOM.
+ */
+enum class StrategyKind
+{
+    HUMAN,
+    AGGRESSIVE,
+    BENEVOLENT,
+    NEUTRAL,
+    CHEATER,
+    MCTS,
+    CUSTOM
+};
+
+/**
+ * @param kind A kind of strategy.
+ * @return The name of the kind, as given to the tournament command.
+ */
+const std::string &strategyKindName(StrategyKind kind);
+
+/**
+ * Finds the kind of strategy with the given name, as given to the tournament command.
+ *
+ * @param name The name of a built-in strategy.
+ * @param kind Receives the kind of strategy.
+ * @return true if the name is the name of a built-in strategy.
+ */
+bool parseStrategyKind(const std::string &name, StrategyKind &kind);
+
 // Abstract Strategy class
 class PlayerStrategy
 {
 public:
     virtual std::vector<Territory *> toDefend() = 0;
     virtual std::vector<Territory *> toAttack() = 0;
-    virtual void issueOrder(Deck *deck) = 0;
+
+    /**
+     * Plans the whole turn of the player in one call, without changing the game.
+     *
+     * @param view What the player sees of the game this turn.
+     * @return The orders and card plays of the turn, none by default.
+     */
+    virtual OrderBatch planTurn(const GameView &view);
+
+    /**
+     * Issues the turn of the player: plans it from a fresh view and issues the planned batch. Strategies that
+     * decide order by order at runtime override it instead.
+     *
+     * @param deck The deck played cards return to.
+     */
+    virtual void issueOrder(Deck *deck);
+
     virtual ~PlayerStrategy() = default;
-    explicit PlayerStrategy(Player* p) : player(p) {}
+    explicit PlayerStrategy(Player* p, StrategyKind kind = StrategyKind::CUSTOM) : player(p), strategyKind(kind) {}
+
+    /**
+     * @return The kind of the strategy, which tells a built-in strategy apart without RTTI.
+     */
+    StrategyKind kind() const { return strategyKind; }
 
-    bool isIssuingOrders() const;
-    void setIssuingOrders(bool isIssuingOrders);
+    /**
+     * @param strategy A strategy, possibly nullptr.
+     * @param kind A kind of strategy.
+     * @return true if the strategy exists and is of the given kind.
+     */
+    static bool isKind(const PlayerStrategy *strategy, StrategyKind kind)
+    {
+        return strategy != nullptr && strategy->strategyKind == kind;
+    }
+
+    /**
+     * @return The name of the strategy, as given to the tournament command: the name of its kind by default.
+     */
+    virtual const std::string &name() const;
+
+    /**
+     * @return The profile the latency of the strategy's decisions is recorded into, looked up by name on first use.
+     */
+    DecisionProfile *decisionProfile();
 
 protected:
     Player* player;  // The player using this strategy
-    bool issuingOrders = false;
-
-    // Flags for strategy order issuing
-    bool deploying = true;
-    bool advancing = true;
-    bool airlifting = true;
-    bool blockading = true;
-    bool bombing = true;
+
+private:
+    StrategyKind strategyKind;
+    DecisionProfile *profile = nullptr;
 };
 
-class HumanPlayerStrategy : public PlayerStrategy
+class HumanPlayerStrategy final : public PlayerStrategy
 {
 public:
-    explicit HumanPlayerStrategy(Player* p) : PlayerStrategy(p) {}
+    explicit HumanPlayerStrategy(Player* p) : PlayerStrategy(p, StrategyKind::HUMAN) {}
 
     std::vector<Territory *> toDefend() override;
     std::vector<Territory *> toAttack() override;
@@ -41,45 +107,183 @@ public:
     void issueOrder(Deck *deck) override;
 };
 
-class AggressivePlayerStrategy : public PlayerStrategy
+class AggressivePlayerStrategy final : public PlayerStrategy
 {
 public:
-    explicit AggressivePlayerStrategy(Player* p) : PlayerStrategy(p) {}
+    /**
+     * How the strategy brings armies from the interior to the front.
+     */
+    enum class Routing
+    {
+        STRONGEST_STACK, ///< Deploy to the strongest territory and move the strongest interior stack one hop.
+        FRONTIER         ///< Deploy to the strongest frontier territory and move every interior stack one hop.
+    };
+
+    static const std::string FRONTIER_NAME; ///< The tournament name of the aggressive strategy in frontier mode.
+
+    explicit AggressivePlayerStrategy(Player* p, Routing routing = Routing::STRONGEST_STACK)
+        : PlayerStrategy(p, StrategyKind::AGGRESSIVE), routing(routing) {}
 
     std::vector<Territory *> toDefend() override;
     std::vector<Territory *> toAttack() override;
-    void issueOrder(Deck *deck) override;
+    OrderBatch planTurn(const GameView &view) override;
+    const std::string &name() const override;
+
+    Routing getRouting() const { return routing; }
+
+private:
+    Routing routing;
+
+    /**
+     * Moves every stack sitting on an interior territory one hop towards the front. The distance of every
+     * territory of the player to the front (its territories with an enemy neighbour) comes from a single
+     * multi-source breadth-first search over the player's territories.
+     *
+     * @param view What the player sees of the game this turn.
+     * @param batch Receives the advance orders.
+     * @return The number of advance orders planned.
+     */
+    int routeToFrontier(const GameView &view, OrderBatch &batch);
+
+    /**
+     * Moves the largest stack sitting on an interior territory (one with no enemy neighbour) one hop towards
+     * the closest enemy territory, using the map's precomputed next hop table.
+     *
+     * @param view What the player sees of the game this turn.
+     * @param batch Receives the advance order.
+     * @return true if an advance order was planned.
+     */
+    bool routeInteriorArmies(const GameView &view, OrderBatch &batch);
 };
 
-class BenevolentPlayerStrategy : public PlayerStrategy
+class BenevolentPlayerStrategy final : public PlayerStrategy
 {
 public:
-    explicit BenevolentPlayerStrategy(Player* p) : PlayerStrategy(p) {}
+    explicit BenevolentPlayerStrategy(Player* p) : PlayerStrategy(p, StrategyKind::BENEVOLENT) {}
 
     std::vector<Territory *> toDefend() override;
     std::vector<Territory *> toAttack() override;
-    void issueOrder(Deck *deck) override;
+    OrderBatch planTurn(const GameView &view) override;
 };
 
-class NeutralPlayerStrategy : public PlayerStrategy
+class NeutralPlayerStrategy final : public PlayerStrategy
 {
 public:
-    explicit NeutralPlayerStrategy(Player* p) : PlayerStrategy(p) {}
+    explicit NeutralPlayerStrategy(Player* p) : PlayerStrategy(p, StrategyKind::NEUTRAL) {}
 
     std::vector<Territory *> toDefend() override;
     std::vector<Territory *> toAttack() override;
-    void issueOrder(Deck *deck) override;
+    OrderBatch planTurn(const GameView &view) override;
 };
 
-class CheaterPlayerStrategy : public PlayerStrategy
+class CheaterPlayerStrategy final : public PlayerStrategy
 {
 
 public:
-    explicit CheaterPlayerStrategy(Player* p) : PlayerStrategy(p) {}
+    explicit CheaterPlayerStrategy(Player* p) : PlayerStrategy(p, StrategyKind::CHEATER) {}
 
     std::vector<Territory *> toDefend() override;
     std::vector<Territory *> toAttack() override;
     void issueOrder(Deck *deck) override;
 };
 
+/**
+ * A strategy that searches its turns: it generates candidate turns and picks one by Monte Carlo search over
+ * rollouts of the built-in strategies on a forkable copy of the game (see MonteCarloTurnSearch).
+ */
+class MCTSPlayerStrategy final : public PlayerStrategy
+{
+public:
+    static const int MAX_ATTACKS = 6; ///< The number of single attacks considered every turn.
+
+    /**
+     * @param p The player using the strategy.
+     * @param rollouts The number of rollouts per turn.
+     * @param timeBudgetMs The time allowed to search a turn in milliseconds, 0 for no limit.
+     * @param threads The threads searching a turn, 0 for one per hardware thread.
+     */
+    explicit MCTSPlayerStrategy(Player* p, int rollouts = 256, int timeBudgetMs = 0, int threads = 0)
+        : PlayerStrategy(p, StrategyKind::MCTS), rollouts(rollouts), timeBudgetMs(timeBudgetMs), threads(threads) {}
+
+    std::vector<Territory *> toDefend() override;
+    std::vector<Territory *> toAttack() override;
+    OrderBatch planTurn(const GameView &view) override;
+
+    /**
+     * @param threads The threads searching a turn, 0 for one per hardware thread.
+     */
+    void setThreads(int threads);
+
+private:
+    int rollouts;
+    int timeBudgetMs;
+    int threads;
+    int turnsPlanned = 0; ///< Makes the seed of every search different.
+};
+
+/**
+ * Creates a built-in strategy.
+ *
+ * @param kind The kind of the strategy, CUSTOM kinds have no built-in strategy.
+ * @param player The player using the strategy.
+ * @return The new strategy, nullptr for a CUSTOM kind.
+ */
+PlayerStrategy *createStrategy(StrategyKind kind, Player *player);
+
+/**
+ * Creates a built-in strategy from its tournament name: the name of its kind, or
+ * AggressivePlayerStrategy::FRONTIER_NAME for the aggressive strategy in frontier mode.
+ *
+ * @param name The tournament name of the strategy.
+ * @param player The player using the strategy.
+ * @return The new strategy, nullptr for an unknown name.
+ */
+PlayerStrategy *createStrategy(const std::string &name, Player *player);
+
+/**
+ * Calls a visitor with the concrete type of a strategy. Built-in strategies are final, so the calls the visitor
+ * makes on them are bound statically and can be inlined; strategies of the CUSTOM kind are visited through the
+ * virtual PlayerStrategy interface.
+ *
+ * @param strategy The strategy to visit.
+ * @param visitor A callable taking every built-in strategy type and PlayerStrategy by reference.
+ * @return What the visitor returns.
+ */
+template <typename Visitor>
+auto visitStrategy(PlayerStrategy &strategy, Visitor &&visitor) -> decltype(visitor(strategy))
+{
+    switch (strategy.kind())
+    {
+    case StrategyKind::HUMAN:
+        return visitor(static_cast<HumanPlayerStrategy &>(strategy));
+    case StrategyKind::AGGRESSIVE:
+        return visitor(static_cast<AggressivePlayerStrategy &>(strategy));
+    case StrategyKind::BENEVOLENT:
+        return visitor(static_cast<BenevolentPlayerStrategy &>(strategy));
+    case StrategyKind::NEUTRAL:
+        return visitor(static_cast<NeutralPlayerStrategy &>(strategy));
+    case StrategyKind::CHEATER:
+        return visitor(static_cast<CheaterPlayerStrategy &>(strategy));
+    case StrategyKind::MCTS:
+        return visitor(static_cast<MCTSPlayerStrategy &>(strategy));
+    default:
+        return visitor(strategy);
+    }
+}
+
+/**
+ * Issues a turn planned by a strategy. For a final strategy type the call to planTurn is bound statically.
+ *
+ * @param strategy The strategy planning the turn.
+ * @param player The player using the strategy.
+ * @param deck The deck played cards return to.
+ */
+template <typename Strategy>
+void issuePlannedTurn(Strategy &strategy, Player *player, Deck *deck)
+{
+    GameView view(player, deck);
+    OrderBatch batch = strategy.planTurn(view);
+    batch.issue(player, deck);
+}
+
 #endif
@@ -3,6 +3,10 @@
 #include "CardsFiles/Cards.h"
 #include <iostream>
 #include <vector>
+#include <chrono>
+#include <algorithm>
+#include "PlayerFiles/TurnSearch.h"
+#include "PlayerFiles/DecisionProfiler.h"
 
 /**
  * @brief Test driver function to demonstrate the Player Strategy pattern implementation
@@ -199,3 +203,255 @@ void testPlayerStrategies() {
 
     std::cout << "\n================== Player Strategies Testing Complete ==================\n";
 }
+
+/**
+ * @brief Test driver function to demonstrate turn planning
+ *
+ * An aggressive and a benevolent player plan their turn on the Montreal map from a GameView. Planning does not
+ * change their orders lists, issuing the turn adds the whole planned batch at once.
+ */
+void testTurnPlanning() {
+    Map* gameMap = new Map();
+    MapLoader::LoadMap("../SomeMapsFromOnline/Montreal/Grand Montreal.map", gameMap);
+    Deck* deck = new Deck();
+
+    Player* aggressivePlayer = new Player("Aggressive Player");
+    aggressivePlayer->setStrategy(new AggressivePlayerStrategy(aggressivePlayer));
+    aggressivePlayer->getOwnedTerritories().push_back(gameMap->territories.at("Lachine"));
+    aggressivePlayer->getOwnedTerritories().push_back(gameMap->territories.at("La Salle"));
+    aggressivePlayer->reinforcement_units = 10;
+    Player::players.push_back(aggressivePlayer);
+
+    Player* benevolentPlayer = new Player("Benevolent Player");
+    benevolentPlayer->setStrategy(new BenevolentPlayerStrategy(benevolentPlayer));
+    benevolentPlayer->getOwnedTerritories().push_back(gameMap->territories.at("Verdun"));
+    benevolentPlayer->getOwnedTerritories().push_back(gameMap->territories.at("NDG CDN"));
+    benevolentPlayer->getOwnedTerritories().push_back(gameMap->territories.at("Westmount"));
+    benevolentPlayer->setNumArmies(10);
+    Player::players.push_back(benevolentPlayer);
+
+    gameMap->territories.at("Lachine")->numberOfArmies = 8;
+    gameMap->territories.at("La Salle")->numberOfArmies = 3;
+    gameMap->territories.at("Verdun")->numberOfArmies = 2;
+    gameMap->territories.at("NDG CDN")->numberOfArmies = 6;
+    gameMap->territories.at("Westmount")->numberOfArmies = 1;
+
+    for (Player* player : Player::players) {
+        GameView view(player, deck);
+        std::cout << player->getPlayerName() << " sees " << view.owned.size() << " territories and "
+                  << view.enemyNeighbours.size() << " enemy neighbours\n";
+
+        OrderBatch batch = player->getStrategy()->planTurn(view);
+        std::cout << "Planned orders:";
+        for (Order* order : batch.getOrders()) {
+            std::cout << " " << order->orderType;
+        }
+        std::cout << "\nOrders in list after planning: " << player->getOrdersList()->ordersVector.size() << "\n";
+
+        batch.issue(player, deck);
+        std::cout << "Orders in list after issuing: " << player->getOrdersList()->ordersVector.size() << "\n\n";
+    }
+
+    Player::players.clear();
+    delete aggressivePlayer;
+    delete benevolentPlayer;
+    delete deck;
+    delete gameMap;
+}
+
+/**
+ * @brief Test driver function to demonstrate the Monte Carlo turn search
+ *
+ * An MCTS player, an aggressive player and a benevolent player share the Montreal map. The search of the MCTS
+ * player's turn is run on one thread then on every hardware thread: both choose the same candidate from the same
+ * statistics, the second one faster. The orders of the chosen turn are then planned by the strategy.
+ */
+void testTurnSearch() {
+    Map* gameMap = new Map();
+    MapLoader::LoadMap("../SomeMapsFromOnline/Montreal/Grand Montreal.map", gameMap);
+    gameMap->PrecomputeDistances();
+
+    Player* searchPlayer = new Player("MCTS Player");
+    searchPlayer->setStrategy(new MCTSPlayerStrategy(searchPlayer));
+    Player* aggressivePlayer = new Player("Aggressive Player");
+    aggressivePlayer->setStrategy(new AggressivePlayerStrategy(aggressivePlayer));
+    Player* benevolentPlayer = new Player("Benevolent Player");
+    benevolentPlayer->setStrategy(new BenevolentPlayerStrategy(benevolentPlayer));
+    Player::players = {searchPlayer, aggressivePlayer, benevolentPlayer};
+
+    for (Territory* territory : gameMap->territoriesById) {
+        territory->numberOfArmies = 2 + territory->id % 5;
+        Player::players[territory->id % 3]->getOwnedTerritories().push_back(territory);
+    }
+    for (Player* player : Player::players) {
+        player->setNumArmies(10);
+        player->reinforcement_units = 10;
+        player->map = gameMap;
+    }
+
+    ForkableGame game(*gameMap, Player::players);
+    std::vector<SimulatedTurn> candidates = MonteCarloTurnSearch::candidateTurns(game, 0, MCTSPlayerStrategy::MAX_ATTACKS);
+    std::cout << candidates.size() << " candidate turns\n";
+
+    MonteCarloTurnSearch::Settings settings;
+    settings.rollouts = 512;
+    MonteCarloTurnSearch::Result results[2];
+    for (int run = 0; run < 2; ++run) {
+        settings.threads = run == 0 ? 1 : 0;
+        auto start = std::chrono::steady_clock::now();
+        results[run] = MonteCarloTurnSearch::search(game, 0, candidates, settings);
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        std::cout << (run == 0 ? "One thread: " : "Every thread: ") << results[run].rollouts << " rollouts in "
+                  << elapsed.count() << " us, chose candidate " << results[run].best << "\n";
+    }
+
+    for (std::size_t i = 0; i < candidates.size(); ++i) {
+        std::cout << "Candidate " << i << ": " << candidates[i].size() << " orders, " << results[0].visits[i]
+                  << " visits, mean score " << results[0].values[i] << "\n";
+    }
+    std::cout << "Same statistics on every thread count: "
+              << (results[0].visits == results[1].visits && results[0].values == results[1].values ? "yes" : "no") << "\n";
+
+    GameView view(searchPlayer, nullptr);
+    OrderBatch batch = searchPlayer->getStrategy()->planTurn(view);
+    std::cout << "Planned orders:";
+    for (Order* order : batch.getOrders()) {
+        std::cout << " " << order->orderType;
+    }
+    std::cout << "\n";
+
+    Player::players.clear();
+    delete searchPlayer;
+    delete aggressivePlayer;
+    delete benevolentPlayer;
+    delete gameMap;
+}
+
+/**
+ * @brief Test driver function to demonstrate frontier routing
+ *
+ * An aggressive player holds all of the Montreal map but one territory. With the default routing only its strongest
+ * interior stack moves, with frontier routing every interior stack advances one hop towards the front and the
+ * reinforcements land on the front.
+ */
+void testFrontierRouting() {
+    Map* gameMap = new Map();
+    MapLoader::LoadMap("../SomeMapsFromOnline/Montreal/Grand Montreal.map", gameMap);
+    gameMap->PrecomputeDistances();
+    Deck* deck = new Deck();
+
+    Player* aggressivePlayer = new Player("Aggressive Player");
+    aggressivePlayer->setStrategy(new AggressivePlayerStrategy(aggressivePlayer));
+    Player* benevolentPlayer = new Player("Benevolent Player");
+    benevolentPlayer->setStrategy(new BenevolentPlayerStrategy(benevolentPlayer));
+    Player::players = {aggressivePlayer, benevolentPlayer};
+
+    for (Territory* territory : gameMap->territoriesById) {
+        territory->numberOfArmies = 3;
+        Player::players[territory->id == 0 ? 1 : 0]->getOwnedTerritories().push_back(territory);
+    }
+    aggressivePlayer->map = gameMap;
+    aggressivePlayer->reinforcement_units = 10;
+
+    std::vector<int> frontier;
+    std::vector<char> passable(gameMap->territoriesById.size(), 1);
+    passable[0] = 0;
+    for (const Territory* adjacent : gameMap->territoriesById[0]->adjacentTerritories) {
+        frontier.push_back(adjacent->id);
+    }
+    std::vector<int> distances;
+    gameMap->MultiSourceDistances(frontier, passable, distances);
+    int farthest = 0;
+    for (int distance : distances) {
+        farthest = std::max(farthest, distance);
+    }
+    std::cout << "The front is " << frontier.size() << " territories, the farthest territory is " << farthest << " hops away\n";
+
+    const AggressivePlayerStrategy::Routing routings[] = {AggressivePlayerStrategy::Routing::STRONGEST_STACK,
+                                                          AggressivePlayerStrategy::Routing::FRONTIER};
+    for (AggressivePlayerStrategy::Routing routing : routings) {
+        delete aggressivePlayer->getStrategy();
+        aggressivePlayer->setStrategy(new AggressivePlayerStrategy(aggressivePlayer, routing));
+        OrderBatch batch = aggressivePlayer->getStrategy()->planTurn(GameView(aggressivePlayer, deck));
+
+        int advances = 0;
+        std::string deployedTo;
+        for (Order* order : batch.getOrders()) {
+            if (order->orderType == "advance") {
+                advances++;
+            } else if (order->orderType == "deploy") {
+                deployedTo = static_cast<DeployOrder*>(order)->territoryDeployName;
+            }
+        }
+        std::cout << (routing == AggressivePlayerStrategy::Routing::FRONTIER ? "Frontier" : "Strongest stack")
+                  << " routing deploys to " << deployedTo << " and plans " << advances << " advance orders\n";
+    }
+
+    Player::players.clear();
+    delete aggressivePlayer;
+    delete benevolentPlayer;
+    delete deck;
+    delete gameMap;
+}
+
+/**
+ * @brief Test driver function to demonstrate the decision latency profiler
+ *
+ * Known latencies are recorded into a histogram to show that its percentiles stay within 1/16 of the exact ones,
+ * then an aggressive player chooses the territories to attack and defend on the Montreal map with profiling on and
+ * off to show what a recording costs, and its profile is queried by strategy name.
+ */
+void testDecisionProfiler() {
+    LatencyHistogram histogram;
+    for (std::uint64_t nanoseconds = 1; nanoseconds <= 100000; ++nanoseconds) {
+        histogram.record(nanoseconds * 10);
+    }
+    const double percentiles[] = {50, 90, 99, 100};
+    for (double percentile : percentiles) {
+        const std::uint64_t exact = static_cast<std::uint64_t>(percentile * 10000);
+        const std::uint64_t reported = histogram.valueAtPercentile(percentile);
+        std::cout << "p" << percentile << ": exact " << exact << " ns, reported " << reported << " ns, error "
+                  << 100.0 * (static_cast<double>(reported) - exact) / exact << "%\n";
+    }
+
+    Map* gameMap = new Map();
+    MapLoader::LoadMap("../SomeMapsFromOnline/Montreal/Grand Montreal.map", gameMap);
+    gameMap->PrecomputeDistances();
+    Deck* deck = new Deck();
+
+    Player* aggressivePlayer = new Player("Aggressive Player");
+    aggressivePlayer->setStrategy(new AggressivePlayerStrategy(aggressivePlayer));
+    Player* benevolentPlayer = new Player("Benevolent Player");
+    benevolentPlayer->setStrategy(new BenevolentPlayerStrategy(benevolentPlayer));
+    Player::players = {aggressivePlayer, benevolentPlayer};
+    for (Territory* territory : gameMap->territoriesById) {
+        territory->numberOfArmies = 2 + territory->id % 5;
+        Player::players[territory->id % 2]->getOwnedTerritories().push_back(territory);
+    }
+    aggressivePlayer->map = gameMap;
+
+    const int turns = 2000;
+    DecisionProfiler::reset();
+    for (int enabled = 0; enabled < 2; ++enabled) {
+        DecisionProfiler::setEnabled(enabled == 1);
+        auto start = std::chrono::steady_clock::now();
+        for (int turn = 0; turn < turns; ++turn) {
+            aggressivePlayer->toAttack();
+            aggressivePlayer->toDefend();
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Profiling " << (enabled == 1 ? "on: " : "off: ") << elapsed << " us for " << turns << " turns\n";
+    }
+    DecisionProfiler::setEnabled(true);
+
+    LatencySummary summary = DecisionProfiler::summary("Aggressive", Decision::TO_ATTACK);
+    std::cout << "Aggressive toAttack: " << summary.calls << " calls, p50 " << summary.p50Ns << " ns, p99 "
+              << summary.p99Ns << " ns, max " << summary.maxNs << " ns\n";
+    DecisionProfiler::report(std::cout);
+
+    Player::players.clear();
+    delete aggressivePlayer;
+    delete benevolentPlayer;
+    delete deck;
+    delete gameMap;
+}
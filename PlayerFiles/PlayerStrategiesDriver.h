@@ -2,5 +2,9 @@
 #define PLAYER_STRATEGIES_DRIVER_H
 
 void testPlayerStrategies();
+void testTurnPlanning();
+void testTurnSearch();
+void testFrontierRouting();
+void testDecisionProfiler();
 
 #endif
@@ -0,0 +1,282 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include "PlayerFiles/TurnSearch.h"
+#include "OrdersFiles/CombatOdds.h"
+
+namespace
+{
+    /**
+     * @brief The splitmix64 finalizer, derives independent seeds from a seed and a counter.
+     */
+    std::uint64_t mixSeed(std::uint64_t z)
+    {
+        z += 0x9e3779b97f4a7c15ULL;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @brief An attack a player can make this turn.
+     */
+    struct Attack
+    {
+        int source;
+        int target;
+        int armies;
+        double odds;
+    };
+
+    /**
+     * @brief The statistics of one root search.
+     */
+    struct SearchStatistics
+    {
+        std::vector<int> visits;
+        std::vector<double> totals;
+    };
+}
+
+/**
+ * @param root The game to search from, with the reinforcements of the current turn assigned.
+ * @param player The index of the player whose turn is searched.
+ * @param candidates The turns to choose from.
+ * @param settings The budget and shape of the search.
+ * @return The result of the search.
+ */
+MonteCarloTurnSearch::Result MonteCarloTurnSearch::search(const ForkableGame &root, int player,
+                                                          const std::vector<SimulatedTurn> &candidates,
+                                                          const Settings &settings)
+{
+    Result result;
+    const int candidateCount = static_cast<int>(candidates.size());
+    result.visits.assign(candidateCount, 0);
+    result.values.assign(candidateCount, 0);
+    if (candidateCount == 0)
+    {
+        return result;
+    }
+    if (candidateCount == 1)
+    {
+        result.best = 0;
+        return result;
+    }
+
+    const int searches = std::max(1, settings.searches);
+    const int rolloutsPerSearch = (std::max(1, settings.rollouts) + searches - 1) / searches;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(settings.timeBudgetMs);
+    std::vector<SearchStatistics> statistics(searches);
+
+    // Every search is a UCB1 bandit over the candidates with its own seed
+    auto runSearch = [&](int index)
+    {
+        SearchStatistics &stats = statistics[index];
+        stats.visits.assign(candidateCount, 0);
+        stats.totals.assign(candidateCount, 0);
+        const std::uint64_t searchSeed = mixSeed(settings.seed ^ mixSeed(static_cast<std::uint64_t>(index)));
+
+        for (int iteration = 0; iteration < rolloutsPerSearch; ++iteration)
+        {
+            if (settings.timeBudgetMs > 0 && std::chrono::steady_clock::now() >= deadline)
+            {
+                break;
+            }
+
+            int chosen = -1;
+            if (iteration < candidateCount)
+            {
+                chosen = iteration;
+            }
+            else
+            {
+                double bestScore = -1;
+                const double logIterations = std::log(static_cast<double>(iteration));
+                for (int candidate = 0; candidate < candidateCount; ++candidate)
+                {
+                    const double score = stats.totals[candidate] / stats.visits[candidate] +
+                                         settings.exploration * std::sqrt(logIterations / stats.visits[candidate]);
+                    if (score > bestScore)
+                    {
+                        bestScore = score;
+                        chosen = candidate;
+                    }
+                }
+            }
+
+            stats.visits[chosen]++;
+            stats.totals[chosen] += rollout(root, player, candidates[chosen], settings.depth,
+                                            mixSeed(searchSeed + static_cast<std::uint64_t>(iteration)));
+        }
+    };
+
+    // Worker threads take the searches one at a time
+    int threadCount = settings.threads > 0 ? settings.threads : static_cast<int>(std::thread::hardware_concurrency());
+    threadCount = std::max(1, std::min(threadCount, searches));
+    std::atomic<int> nextSearch(0);
+    auto work = [&]()
+    {
+        for (int index = nextSearch++; index < searches; index = nextSearch++)
+        {
+            runSearch(index);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threadCount; ++t)
+    {
+        workers.emplace_back(work);
+    }
+    work();
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+
+    // Sum the searches and choose the most visited candidate, then the best scored one
+    std::vector<double> totals(candidateCount, 0);
+    for (const SearchStatistics &stats : statistics)
+    {
+        for (int candidate = 0; candidate < candidateCount; ++candidate)
+        {
+            result.visits[candidate] += stats.visits[candidate];
+            totals[candidate] += stats.totals[candidate];
+        }
+    }
+
+    for (int candidate = 0; candidate < candidateCount; ++candidate)
+    {
+        result.rollouts += result.visits[candidate];
+        result.values[candidate] = result.visits[candidate] == 0 ? 0 : totals[candidate] / result.visits[candidate];
+
+        if (result.best < 0 || result.visits[candidate] > result.visits[result.best] ||
+            (result.visits[candidate] == result.visits[result.best] && result.values[candidate] > result.values[result.best]))
+        {
+            result.best = candidate;
+        }
+    }
+    return result;
+}
+
+/**
+ * @return The score of a rollout: the candidate is played on a fork of the game, then every player follows its
+ * rollout policy until the game is over or the rollout is deep enough.
+ */
+double MonteCarloTurnSearch::rollout(const ForkableGame &root, int player, const SimulatedTurn &candidate, int depth,
+                                     std::uint64_t seed)
+{
+    ForkableGame game = root.fork();
+    game.playTurn(player, candidate, mixSeed(seed));
+
+    for (int turn = 1; turn < depth && game.alivePlayers() > 1 && game.territoriesOwned(player) > 0; ++turn)
+    {
+        game.assignReinforcements();
+        game.playTurn(-1, SimulatedTurn(), mixSeed(seed + static_cast<std::uint64_t>(turn)));
+    }
+    return game.evaluate(player);
+}
+
+/**
+ * @param game The game.
+ * @param player The index of the player.
+ * @param maxAttacks The number of single attacks to consider.
+ * @return The candidate turns.
+ */
+std::vector<SimulatedTurn> MonteCarloTurnSearch::candidateTurns(const ForkableGame &game, int player, int maxAttacks)
+{
+    std::vector<SimulatedTurn> candidates;
+    candidates.push_back(game.planPolicyTurn(player));
+
+    const int pool = game.pool(player);
+    std::vector<Attack> attacks;     // Every attack, after deploying the pool on its source
+    std::vector<Attack> bestAttacks; // The best attack of every territory, without deploying
+    int threatened = -1;
+    int worstThreat = 0;
+
+    for (int territory = 0; territory < game.territoryCount(); ++territory)
+    {
+        if (game.owner(territory) != player)
+        {
+            continue;
+        }
+
+        const int territoryArmies = game.armies(territory);
+        Attack best = {territory, -1, territoryArmies - 1, -1};
+        int threat = -territoryArmies;
+
+        for (const int *neighbour = game.neighboursBegin(territory); neighbour != game.neighboursEnd(territory); ++neighbour)
+        {
+            const int neighbourOwner = game.owner(*neighbour);
+            if (neighbourOwner == player)
+            {
+                continue;
+            }
+
+            const int defenders = game.armies(*neighbour);
+            if (territoryArmies + pool > 1)
+            {
+                const int armies = territoryArmies + pool - 1;
+                attacks.push_back({territory, *neighbour, armies, CombatOdds::winProbability(armies, defenders)});
+            }
+            if (territoryArmies > 1)
+            {
+                const double odds = CombatOdds::winProbability(territoryArmies - 1, defenders);
+                if (odds > best.odds)
+                {
+                    best.target = *neighbour;
+                    best.odds = odds;
+                }
+            }
+            if (neighbourOwner >= 0)
+            {
+                threat += defenders;
+            }
+        }
+
+        if (best.target >= 0)
+        {
+            bestAttacks.push_back(best);
+        }
+        if (threat > worstThreat)
+        {
+            worstThreat = threat;
+            threatened = territory;
+        }
+    }
+
+    // The best single attacks, backed by the whole pool
+    std::stable_sort(attacks.begin(), attacks.end(), [](const Attack &a, const Attack &b)
+                     { return a.odds > b.odds; });
+    for (int i = 0; i < static_cast<int>(attacks.size()) && i < maxAttacks; ++i)
+    {
+        candidates.push_back({{-1, attacks[i].source, pool}, {attacks[i].source, attacks[i].target, attacks[i].armies}});
+    }
+
+    // The best of them plus every other attack likely to succeed
+    if (!attacks.empty() && maxAttacks > 0)
+    {
+        SimulatedTurn blitz = candidates[1];
+        for (const Attack &attack : bestAttacks)
+        {
+            if (attack.source != attacks.front().source && attack.odds >= 0.7)
+            {
+                blitz.push_back({attack.source, attack.target, attack.armies});
+            }
+        }
+
+        if (blitz.size() > 2)
+        {
+            candidates.push_back(blitz);
+        }
+    }
+
+    // Hold the most threatened territory
+    if (threatened >= 0 && pool > 0)
+    {
+        candidates.push_back({{-1, threatened, pool}});
+    }
+
+    return candidates;
+}
@@ -0,0 +1,75 @@
+#ifndef TURN_SEARCH_H
+#define TURN_SEARCH_H
+
+#include <cstdint>
+#include <vector>
+#include "PlayerFiles/ForkableGame.h"
+
+/**
+ * @brief Chooses the turn of a player among candidate turns by Monte Carlo search.
+ *
+ * Every iteration picks a candidate by UCB1, plays it on a fork of the game, lets every player follow its rollout
+ * policy for a few more turns and scores the outcome with ForkableGame::evaluate. The search is root parallel:
+ * several independent searches with their own seeds share the rollout budget, each on its own worker thread, and
+ * their visit counts are summed to choose the most visited candidate. The searches never share state, so with a
+ * rollout budget and no time budget the choice only depends on the seed, whatever the number of threads.
+ */
+class MonteCarloTurnSearch
+{
+public:
+    /**
+     * @brief The budget and shape of a search.
+     */
+    struct Settings
+    {
+        int rollouts = 256;       ///< The total number of rollouts.
+        int timeBudgetMs = 0;     ///< Stops every search after this many milliseconds, 0 for no limit.
+        int searches = 4;         ///< The number of independent root searches.
+        int threads = 0;          ///< The number of worker threads, 0 for one per hardware thread.
+        int depth = 6;            ///< The number of turns played by a rollout, the candidate's included.
+        double exploration = 1.4; ///< The exploration constant of UCB1.
+        std::uint64_t seed = 345; ///< The seed of the searches.
+    };
+
+    /**
+     * @brief What a search found out about every candidate.
+     */
+    struct Result
+    {
+        int best = -1;              ///< The index of the chosen candidate, -1 without candidates.
+        std::vector<int> visits;    ///< The rollouts of every candidate.
+        std::vector<double> values; ///< The mean score of every candidate.
+        int rollouts = 0;           ///< The number of rollouts played.
+    };
+
+    /**
+     * @param root The game to search from, with the reinforcements of the current turn assigned.
+     * @param player The index of the player whose turn is searched.
+     * @param candidates The turns to choose from.
+     * @param settings The budget and shape of the search.
+     * @return The result of the search.
+     */
+    static Result search(const ForkableGame &root, int player, const std::vector<SimulatedTurn> &candidates,
+                         const Settings &settings);
+
+    /**
+     * @brief Generates the candidate turns of a player: the turn of its rollout policy, every player deploying its
+     * pool on the source of one of its best single attacks, an attack from every territory with good enough
+     * odds, and deploying on the most threatened territory without attacking.
+     *
+     * @param game The game.
+     * @param player The index of the player.
+     * @param maxAttacks The number of single attacks to consider.
+     * @return The candidate turns.
+     */
+    static std::vector<SimulatedTurn> candidateTurns(const ForkableGame &game, int player, int maxAttacks);
+
+private:
+    /**
+     * @return The score of a rollout of a candidate.
+     */
+    static double rollout(const ForkableGame &root, int player, const SimulatedTurn &candidate, int depth,
+                          std::uint64_t seed);
+};
+
+#endif